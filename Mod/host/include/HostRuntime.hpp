@@ -0,0 +1,38 @@
+#pragma once
+
+#include "heap/seadHeap.h"
+
+// the parts of the game and sdk runtime the transport depends on, backed by libc so it can run on a pc
+
+namespace host {
+
+/**
+ * @brief malloc backed heap, stands in for the client heap the game hands to SocketClient
+ */
+class MallocHeap : public sead::Heap {
+    public:
+        MallocHeap(const sead::SafeString& name);
+
+        void destroy() override {}
+        size_t adjust() override { return 0; }
+        void* tryAlloc(size_t size, s32 alignment) override;
+        void free(void* ptr) override;
+        void* resizeFront(void*, size_t) override { return nullptr; }
+        void* resizeBack(void*, size_t) override { return nullptr; }
+        void freeAll() override {}
+        uintptr_t getStartAddress() const override { return 0; }
+        uintptr_t getEndAddress() const override { return UINTPTR_MAX; }
+        size_t getSize() const override { return SIZE_MAX; }
+        size_t getFreeSize() const override { return SIZE_MAX; }
+        size_t getMaxAllocatableSize(int) const override { return SIZE_MAX; }
+        bool isInclude(const void*) const override { return true; }
+        bool isEmpty() const override { return false; }
+        bool isFreeable() const override { return true; }
+        bool isResizable() const override { return false; }
+        bool isAdjustable() const override { return false; }
+};
+
+// Logger::log output is dropped unless enabled, the transport logs every connection step
+void setLogEnabled(bool isEnabled);
+
+}  // namespace host
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <atomic>
+#include <thread>
+
+#include "types.h"
+
+/**
+ * @brief minimal loopback server for host runs, echoes CHECK and FRAGMENT packets straight back and answers every PING with a PONG
+ *
+ * Kept free of nn headers, as those redeclare the BSD socket structs this needs from libc.
+ */
+class StandInServer {
+    public:
+        ~StandInServer();
+
+        // binds to 127.0.0.1 on the given port, 0 picks any free one
+        bool start(u16 port = 0);
+        u16 getPort() const { return mPort; }
+
+        u32 getEchoCount() const { return mEchoCount; }
+
+    private:
+        void serveFunc();
+        void serveConnection(s32 fd);
+
+        s32 mListenSocket = -1;
+        u16 mPort = 0;
+        std::thread mThread;
+        std::atomic<u32> mEchoCount = 0;
+};
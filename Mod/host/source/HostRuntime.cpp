@@ -0,0 +1,163 @@
+#include "HostRuntime.hpp"
+
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+#include "al/async/AsyncFunctorThread.h"
+#include "logger.hpp"
+#include "nn/account.h"
+#include "nn/os.h"
+#include "server/Client.hpp"
+#include "time/seadTickSpan.h"
+
+namespace host {
+
+static bool sIsLogEnabled = false;
+
+MallocHeap::MallocHeap(const sead::SafeString& name)
+    : sead::Heap(name, nullptr, nullptr, 0, cHeapDirection_Forward, false) {}
+
+void* MallocHeap::tryAlloc(size_t size, s32 alignment) {
+    size_t align = alignment < (s32)sizeof(void*) ? sizeof(void*) : alignment;
+    return aligned_alloc(align, (size + align - 1) & ~(align - 1));
+}
+
+void MallocHeap::free(void* ptr) {
+    ::free(ptr);
+}
+
+void setLogEnabled(bool isEnabled) {
+    sIsLogEnabled = isEnabled;
+}
+
+}  // namespace host
+
+// sead, only what the transport and its headers touch
+
+namespace sead {
+
+IDisposer::IDisposer() : mDisposerHeap(nullptr) {}
+
+IDisposer::~IDisposer() = default;
+
+CriticalSection::CriticalSection() = default;
+
+CriticalSection::~CriticalSection() = default;
+
+Heap::Heap(const SafeString& name, Heap* parent, void* address, size_t size, HeapDirection direction, bool)
+    : mStart(address), mSize(size), mParent(parent), mDirection(direction) {
+    setName(name);
+}
+
+Heap::~Heap() = default;
+
+void Heap::dumpYAML(WriteStream&, int) const {}
+
+void Heap::genInformation_(hostio::Context*) {}
+
+void Heap::makeMetaString_(BufferedSafeString*) {}
+
+void Heap::pushBackChild_(Heap*) {}
+
+template <>
+const char SafeStringBase<char>::cNullChar = '\0';
+
+template <>
+const SafeStringBase<char> SafeStringBase<char>::cEmptyString{};
+
+template <typename T>
+SafeStringBase<T>& SafeStringBase<T>::operator=(const SafeStringBase<T>& other) {
+    mStringTop = other.mStringTop;
+    return *this;
+}
+
+template <typename T>
+BufferedSafeStringBase<T>& BufferedSafeStringBase<T>::operator=(const SafeStringBase<T>& other) {
+    this->copy(other);
+    return *this;
+}
+
+template <typename T>
+void BufferedSafeStringBase<T>::assureTerminationImpl_() const {
+    const_cast<BufferedSafeStringBase<T>*>(this)->getMutableStringTop_()[mBufferSize - 1] = this->cNullChar;
+}
+
+template SafeStringBase<char>& SafeStringBase<char>::operator=(const SafeStringBase<char>&);
+template BufferedSafeStringBase<char>& BufferedSafeStringBase<char>::operator=(const SafeStringBase<char>&);
+template void BufferedSafeStringBase<char>::assureTerminationImpl_() const;
+
+const s64 TickSpan::cFrequency = nn::os::GetSystemTickFrequency();
+
+s64 TickSpan::toNanoSeconds() const {
+    return 1'000'000'000 * (mSpan / cFrequency) + 1'000'000'000 * (mSpan % cFrequency) / cFrequency;
+}
+
+namespace system {
+
+// the console runtime frees through this from inside functor destructors, host functors are never destroyed
+void DeleteImpl(void*) {}
+
+}  // namespace system
+
+}  // namespace sead
+
+void* operator new(size_t size, sead::Heap* heap, s32 alignment) {
+    return heap->tryAlloc(size, alignment);
+}
+
+// al
+
+namespace al {
+
+AsyncFunctorThread::AsyncFunctorThread(sead::SafeStringBase<char> const&, al::FunctorBase const& functor, int, int, sead::CoreId) {
+    // the console version keeps the functor inside its delegate thread, so the padding holds it here instead
+    FunctorBase* ownedFunctor = functor.clone();
+    memcpy(padding_08, &ownedFunctor, sizeof(ownedFunctor));
+
+    mDelegateThread = nullptr;
+    mIsDone = true;
+}
+
+void AsyncFunctorThread::start() {
+    FunctorBase* ownedFunctor;
+    memcpy(&ownedFunctor, padding_08, sizeof(ownedFunctor));
+
+    mIsDone = false;
+
+    std::thread([this, ownedFunctor] {
+        (*ownedFunctor)();
+        mIsDone = true;
+    }).detach();
+}
+
+}  // namespace al
+
+// game side of the transport
+
+const nn::account::Uid nn::account::Uid::EmptyId = {};
+
+Logger* Logger::sInstance = nullptr;
+
+void Logger::log(const char* fmt, va_list args) {
+    if (host::sIsLogEnabled)
+        vfprintf(stderr, fmt, args);
+}
+
+void Logger::log(const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    log(fmt, args);
+    va_end(args);
+}
+
+Client* Client::sInstance = nullptr;
+
+// nothing to resend without a game running
+void Client::resendInitPackets() {}
+
+// no save to report, an empty bitmap leaves the stand in server nothing to diff
+void Client::writeShineBitmap(ShineBitmap* packet) {
+    packet->mPacketSize = SHINEBITMAPHEADERSIZE + SHINEBITMAPSIZE;
+}
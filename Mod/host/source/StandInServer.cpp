@@ -0,0 +1,137 @@
+#include "StandInServer.hpp"
+
+#include <arpa/inet.h>
+#include <cstring>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+// wire layout of the packet header, see packets/Packet.h
+constexpr s32 cHeaderSize = 0x14;
+constexpr s32 cTypeOffset = 0x10;
+constexpr s32 cSizeOffset = 0x12;
+constexpr s32 cMaxPacketSize = 0x100;
+
+// packet types the server reacts to, see PacketType
+constexpr s16 cTypeCheck = 9;
+constexpr s16 cTypePing = 24;
+constexpr s16 cTypePong = 25;
+constexpr s16 cTypeFragment = 28;
+
+constexpr s32 cStreamSize = cMaxPacketSize * 0x40;
+
+}  // namespace
+
+StandInServer::~StandInServer() {
+    if (mListenSocket >= 0) {
+        shutdown(mListenSocket, SHUT_RDWR);
+        close(mListenSocket);
+    }
+
+    if (mThread.joinable())
+        mThread.detach();
+}
+
+bool StandInServer::start(u16 port) {
+    if ((mListenSocket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP)) < 0)
+        return false;
+
+    int reuse = 1;
+    setsockopt(mListenSocket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    if (bind(mListenSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+        listen(mListenSocket, 1) < 0) {
+        return false;
+    }
+
+    socklen_t addressSize = sizeof(address);
+    getsockname(mListenSocket, reinterpret_cast<sockaddr*>(&address), &addressSize);
+    mPort = ntohs(address.sin_port);
+
+    mThread = std::thread(&StandInServer::serveFunc, this);
+
+    return true;
+}
+
+void StandInServer::serveFunc() {
+    while (true) {
+        s32 fd = accept(mListenSocket, nullptr, nullptr);
+
+        if (fd < 0)
+            return;
+
+        int noDelay = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+        serveConnection(fd);
+        close(fd);
+    }
+}
+
+/**
+ * @brief splits the client's stream into packets and writes every reply produced by one read back with a single send
+ */
+void StandInServer::serveConnection(s32 fd) {
+    char stream[cStreamSize];
+    char replies[cStreamSize];
+    s32 streamSize = 0;
+
+    while (true) {
+        ssize_t result = recv(fd, stream + streamSize, cStreamSize - streamSize, 0);
+
+        if (result <= 0)
+            return;
+
+        streamSize += result;
+
+        s32 offset = 0;
+        s32 replySize = 0;
+
+        while (streamSize - offset >= cHeaderSize) {
+            s16 type, size;
+            memcpy(&type, stream + offset + cTypeOffset, sizeof(type));
+            memcpy(&size, stream + offset + cSizeOffset, sizeof(size));
+
+            s32 fullSize = cHeaderSize + size;
+
+            if (size < 0 || fullSize > cMaxPacketSize)
+                return; // out of sync, make the client reconnect
+
+            if (streamSize - offset < fullSize)
+                break;
+
+            if (type == cTypeCheck || type == cTypePing || type == cTypeFragment) {
+                memcpy(replies + replySize, stream + offset, fullSize);
+
+                if (type == cTypePing)
+                    memcpy(replies + replySize + cTypeOffset, &cTypePong, sizeof(cTypePong));
+                else
+                    mEchoCount++;
+
+                replySize += fullSize;
+            }
+
+            offset += fullSize;
+        }
+
+        streamSize -= offset;
+        memmove(stream, stream + offset, streamSize);
+
+        for (s32 sent = 0; sent < replySize;) {
+            ssize_t sendResult = send(fd, replies + sent, replySize - sent, MSG_NOSIGNAL);
+
+            if (sendResult <= 0)
+                return;
+
+            sent += sendResult;
+        }
+    }
+}
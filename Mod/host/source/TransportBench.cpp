@@ -0,0 +1,197 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "HostRuntime.hpp"
+#include "StandInServer.hpp"
+#include "packets/Packet.h"
+#include "server/Client.hpp"
+#include "server/SocketClient.hpp"
+
+// measures the full SocketClient path (send lanes, framing, recv ring and pool) against a loopback server
+//
+// usage: transportBench [-n count] [-w window] [-f size] [-d us] [-s ip:port] [-v]
+//   -n  packets per phase (default 20000)
+//   -w  max packets in flight during the throughput phase (default 64)
+//   -f  size of the CHECK packets sent as FRAGMENTs during the fragmented phase (default 4096)
+//   -d  flush deadline of the send thread, as Client sets it with SENDFLUSHDEADLINE (default 0, flush right away)
+//   -s  use an already running server, which has to echo CHECK and FRAGMENT packets back, instead of the built in one
+//   -v  print the transport's log output
+
+namespace {
+
+struct PhaseResult {
+    u32 count = 0;
+    u32 lost = 0;
+    double seconds = 0;
+    std::vector<u32> latencies; // microseconds, sorted
+};
+
+u64 getNowUs() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+u32 getPercentile(const std::vector<u32>& sorted, double percentile) {
+    if (sorted.empty())
+        return 0;
+
+    size_t index = (size_t)(percentile * (sorted.size() - 1) + 0.5);
+    return sorted[index];
+}
+
+/**
+ * @brief keeps up to window CHECK packets in flight and times each one from queuePacket until its echo leaves tryGetPacket
+ *
+ * @param size full size of every CHECK, anything past sizeof(Check) is padding that makes the transport fragment it
+ */
+PhaseResult runPhase(SocketClient* client, sead::Heap* heap, u32 count, u32 window, u32 size = sizeof(Check)) {
+    PhaseResult result;
+    result.count = count;
+    result.latencies.reserve(count);
+
+    std::vector<u64> sendTimes(count, 0);
+
+    u32 queued = 0;
+    u32 completed = 0;
+
+    u64 startTime = getNowUs();
+
+    while (completed < count) {
+        while (queued < count && queued - completed < window) {
+            Check* packet = new (heap->alloc(size)) Check();
+            packet->mPacketSize = size - sizeof(Packet);
+            packet->index = queued;
+
+            sendTimes[queued] = getNowUs();
+
+            // queuePacket frees packets it can't take, which would never come back
+            if (!client->queuePacket(packet)) {
+                result.lost++;
+                completed++;
+            }
+
+            queued++;
+        }
+
+        Packet* packet = client->tryGetPacket();
+
+        if (!packet)
+            continue;
+
+        if (packet->mType == PacketType::CHECK) {
+            u32 index = reinterpret_cast<Check*>(packet)->index;
+
+            if (index < count && sendTimes[index]) {
+                result.latencies.push_back(getNowUs() - sendTimes[index]);
+                sendTimes[index] = 0;
+                completed++;
+            }
+        }
+
+        client->releasePacket(packet);
+    }
+
+    result.seconds = (getNowUs() - startTime) / 1000000.0;
+
+    std::sort(result.latencies.begin(), result.latencies.end());
+
+    return result;
+}
+
+void printPhase(const char* name, u32 window, const PhaseResult& result) {
+    printf("%-10s window %3u: %9.0f packets/sec  p50 %6uus  p99 %6uus  max %6uus  lost %u\n", name, window,
+           result.count / result.seconds, getPercentile(result.latencies, 0.5),
+           getPercentile(result.latencies, 0.99), getPercentile(result.latencies, 1.0), result.lost);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    u32 count = 20000;
+    u32 window = 64;
+    u32 fragmentedSize = 4096;
+    s64 flushDeadline = 0;
+    const char* serverAddress = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-n") && i + 1 < argc) {
+            count = strtoul(argv[++i], nullptr, 10);
+        } else if (!strcmp(argv[i], "-w") && i + 1 < argc) {
+            window = strtoul(argv[++i], nullptr, 10);
+        } else if (!strcmp(argv[i], "-f") && i + 1 < argc) {
+            fragmentedSize = strtoul(argv[++i], nullptr, 10);
+        } else if (!strcmp(argv[i], "-d") && i + 1 < argc) {
+            flushDeadline = strtoll(argv[++i], nullptr, 10);
+        } else if (!strcmp(argv[i], "-s") && i + 1 < argc) {
+            serverAddress = argv[++i];
+        } else if (!strcmp(argv[i], "-v")) {
+            host::setLogEnabled(true);
+        } else {
+            fprintf(stderr, "usage: %s [-n count] [-w window] [-f size] [-d us] [-s ip:port] [-v]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    // more in flight than the queues hold would just measure drops
+    window = std::clamp<u32>(window, 1, RECVQUEUESIZE / 2);
+    fragmentedSize = std::clamp<u32>(fragmentedSize, sizeof(Check), MAXMESSAGESIZE);
+
+    StandInServer server;
+    char ip[0x40] = "127.0.0.1";
+    u16 port = 0;
+
+    if (serverAddress) {
+        const char* separator = strrchr(serverAddress, ':');
+
+        if (!separator || separator - serverAddress >= (long)sizeof(ip)) {
+            fprintf(stderr, "server address has to be ip:port\n");
+            return 1;
+        }
+
+        memcpy(ip, serverAddress, separator - serverAddress);
+        ip[separator - serverAddress] = '\0';
+        port = atoi(separator + 1);
+    } else {
+        if (!server.start()) {
+            fprintf(stderr, "unable to start the stand-in server\n");
+            return 1;
+        }
+
+        port = server.getPort();
+    }
+
+    host::MallocHeap heap("TransportBench");
+    SocketClient* client = new SocketClient("BenchSocket", &heap, nullptr);
+    client->setSendBatchLimits(SENDBATCHCOUNT, flushDeadline);
+
+    printf("connecting to %s:%u\n", ip, port);
+
+    if (client->init(ip, port).isFailure()) {
+        fprintf(stderr, "connection failed\n");
+        return 1;
+    }
+
+    // a lone packet in flight is latency bound, a full window shows what the send batching buys
+    printPhase("latency", 1, runPhase(client, &heap, std::max<u32>(count / 10, 1), 1));
+    printPhase("throughput", window, runPhase(client, &heap, count, window));
+
+    // reassembled messages are capped by the message pool rather than the recv queue
+    printf("fragmented packets of %u bytes:\n", fragmentedSize);
+    printPhase("fragmented", MESSAGESLOTCOUNT, runPhase(client, &heap, std::max<u32>(count / 10, 1), MESSAGESLOTCOUNT, fragmentedSize));
+
+    if (client->getSmoothedRtt() >= 0) {
+        printf("ping rtt %dus jitter %dus\n", client->getSmoothedRtt(), client->getRttJitter());
+    }
+
+    printf("coalesced %u, recv dropped %u\n", client->getCoalesceCount(), client->getRecvDropCount());
+
+    fflush(stdout);
+
+    // the socket threads never return, so skip the static teardown they could race with
+    _Exit(0);
+}
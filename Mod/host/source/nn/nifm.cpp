@@ -0,0 +1,24 @@
+#include "nn/nifm.h"
+
+// the host network is always up
+namespace nn { namespace nifm {
+
+Result Initialize() {
+    return 0;
+}
+
+void SubmitNetworkRequest() {}
+
+void SubmitNetworkRequestAndWait() {}
+
+void CancelNetworkRequest() {}
+
+bool IsNetworkRequestOnHold() {
+    return false;
+}
+
+bool IsNetworkAvailable() {
+    return true;
+}
+
+} }
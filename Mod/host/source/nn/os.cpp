@@ -0,0 +1,153 @@
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+#include "nn/os.h"
+
+// std backed nn::os, the nn structs are far too small to hold the std primitives so they only store a pointer to them
+
+namespace {
+
+struct HostEvent {
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool isSignaled;
+    bool isAutoClear;
+};
+
+HostEvent* getHostEvent(nn::os::EventType* event) {
+    return reinterpret_cast<HostEvent*>(event->_x0);
+}
+
+std::recursive_mutex* getHostMutex(nn::os::MutexType* mutex) {
+    std::recursive_mutex* hostMutex;
+    memcpy(&hostMutex, mutex->_6, sizeof(hostMutex));
+    return hostMutex;
+}
+
+// console ticks run at 19.2MHz, nanoseconds keep the host math exact instead
+constexpr u64 cHostTickFrequency = 1'000'000'000;
+
+}  // namespace
+
+static_assert(sizeof(nn::os::MutexType::_6) >= sizeof(void*));
+
+namespace nn { namespace os {
+
+void InitializeEvent(EventType* event, bool initiallySignaled, bool autoclear) {
+    HostEvent* hostEvent = new HostEvent();
+    hostEvent->isSignaled = initiallySignaled;
+    hostEvent->isAutoClear = autoclear;
+
+    event->_x0 = reinterpret_cast<EventType*>(hostEvent);
+    event->isInit = true;
+}
+
+void FinalizeEvent(EventType* event) {
+    delete getHostEvent(event);
+    event->_x0 = nullptr;
+    event->isInit = false;
+}
+
+void SignalEvent(EventType* event) {
+    HostEvent* hostEvent = getHostEvent(event);
+
+    {
+        std::lock_guard<std::mutex> lock(hostEvent->mutex);
+        hostEvent->isSignaled = true;
+    }
+
+    // auto clear events only release a single waiter, same as on console
+    if (hostEvent->isAutoClear)
+        hostEvent->condition.notify_one();
+    else
+        hostEvent->condition.notify_all();
+}
+
+void WaitEvent(EventType* event) {
+    HostEvent* hostEvent = getHostEvent(event);
+    std::unique_lock<std::mutex> lock(hostEvent->mutex);
+
+    hostEvent->condition.wait(lock, [hostEvent] { return hostEvent->isSignaled; });
+
+    if (hostEvent->isAutoClear)
+        hostEvent->isSignaled = false;
+}
+
+bool TryWaitEvent(EventType* event) {
+    HostEvent* hostEvent = getHostEvent(event);
+    std::lock_guard<std::mutex> lock(hostEvent->mutex);
+
+    bool isSignaled = hostEvent->isSignaled;
+
+    if (hostEvent->isAutoClear)
+        hostEvent->isSignaled = false;
+
+    return isSignaled;
+}
+
+bool TimedWaitEvent(EventType* event, nn::TimeSpan timeout) {
+    HostEvent* hostEvent = getHostEvent(event);
+    std::unique_lock<std::mutex> lock(hostEvent->mutex);
+
+    if (!hostEvent->condition.wait_for(lock, std::chrono::nanoseconds(timeout.nanoseconds),
+                                       [hostEvent] { return hostEvent->isSignaled; })) {
+        return false;
+    }
+
+    if (hostEvent->isAutoClear)
+        hostEvent->isSignaled = false;
+
+    return true;
+}
+
+void ClearEvent(EventType* event) {
+    HostEvent* hostEvent = getHostEvent(event);
+    std::lock_guard<std::mutex> lock(hostEvent->mutex);
+    hostEvent->isSignaled = false;
+}
+
+void InitializeMutex(MutexType* mutex, bool isRecursive, s32) {
+    // always recursive on host, which is a superset of what callers can rely on
+    std::recursive_mutex* hostMutex = new std::recursive_mutex();
+    memcpy(mutex->_6, &hostMutex, sizeof(hostMutex));
+    mutex->isRecursiveMutex = isRecursive;
+}
+
+void FinalizeMutex(MutexType* mutex) {
+    delete getHostMutex(mutex);
+}
+
+void LockMutex(MutexType* mutex) {
+    getHostMutex(mutex)->lock();
+}
+
+bool TryLockMutex(MutexType* mutex) {
+    return getHostMutex(mutex)->try_lock();
+}
+
+void UnlockMutex(MutexType* mutex) {
+    getHostMutex(mutex)->unlock();
+}
+
+void YieldThread() {
+    std::this_thread::yield();
+}
+
+void SleepThread(nn::TimeSpan time) {
+    std::this_thread::sleep_for(std::chrono::nanoseconds(time.nanoseconds));
+}
+
+Tick GetSystemTick() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+Tick GetSystemTickFrequency() {
+    return cHostTickFrequency;
+}
+
+} }
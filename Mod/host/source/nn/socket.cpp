@@ -0,0 +1,151 @@
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "nn/result.h"
+#include "types.h"
+
+// POSIX backed nn::socket, the nn headers redeclare the BSD structs, so this file only sees the libc versions of them
+
+namespace {
+
+// layout of nn's sockaddr, which keeps the BSD length byte in front of the family
+struct NnSockAddr {
+    u8 len;
+    u8 family;
+    u16 port;
+    in_addr address;
+    u8 zero[8];
+};
+
+static_assert(sizeof(NnSockAddr) == sizeof(sockaddr_in));
+
+sockaddr_in toHostAddr(const sockaddr* address) {
+    const NnSockAddr* nnAddr = reinterpret_cast<const NnSockAddr*>(address);
+
+    sockaddr_in hostAddr = {};
+    hostAddr.sin_family = nnAddr->family;
+    hostAddr.sin_port = nnAddr->port;
+    hostAddr.sin_addr = nnAddr->address;
+
+    return hostAddr;
+}
+
+void toNnAddr(const sockaddr_in& hostAddr, sockaddr* address) {
+    NnSockAddr* nnAddr = reinterpret_cast<NnSockAddr*>(address);
+
+    memset(nnAddr, 0, sizeof(NnSockAddr));
+    nnAddr->len = sizeof(NnSockAddr);
+    nnAddr->family = hostAddr.sin_family;
+    nnAddr->port = hostAddr.sin_port;
+    nnAddr->address = hostAddr.sin_addr;
+}
+
+}  // namespace
+
+namespace nn { namespace socket {
+
+Result Initialize(void*, unsigned long, unsigned long, int) {
+    return 0;
+}
+
+s32 SetSockOpt(s32 socket, s32 socketLevel, s32 option, void const* value, u32 len) {
+    return setsockopt(socket, socketLevel, option, value, len);
+}
+
+s32 Socket(s32 domain, s32 type, s32 protocol) {
+    return ::socket(domain, type, protocol);
+}
+
+s32 Connect(s32 socket, const sockaddr* address, u32) {
+    sockaddr_in hostAddr = toHostAddr(address);
+    return connect(socket, reinterpret_cast<const sockaddr*>(&hostAddr), sizeof(hostAddr));
+}
+
+Result Close(s32 socket) {
+    return close(socket) == 0 ? 0 : errno;
+}
+
+s32 Send(s32 socket, const void* data, unsigned long dataLen, s32 flags) {
+    // a peer closing mid send should fail the call like it does on console, not kill the process
+    return send(socket, data, dataLen, flags | MSG_NOSIGNAL);
+}
+
+s32 SendTo(s32 socket, const void* data, unsigned long dataLen, s32 flags, const sockaddr* to, u32) {
+    sockaddr_in hostAddr = toHostAddr(to);
+    return sendto(socket, data, dataLen, flags | MSG_NOSIGNAL, reinterpret_cast<const sockaddr*>(&hostAddr), sizeof(hostAddr));
+}
+
+s32 Recv(s32 socket, void* out, unsigned long outLen, s32 flags) {
+    // the client primes new sockets with an empty read, which returns right away on console but blocks until data arrives here
+    if (outLen == 0)
+        flags |= MSG_DONTWAIT;
+
+    return recv(socket, out, outLen, flags);
+}
+
+s32 RecvFrom(s32 socket, void* out, unsigned long outLen, s32 flags, sockaddr* from, u32* fromLen) {
+    sockaddr_in hostAddr = {};
+    socklen_t hostLen = sizeof(hostAddr);
+
+    s32 result = recvfrom(socket, out, outLen, flags, reinterpret_cast<sockaddr*>(&hostAddr), &hostLen);
+
+    if (result >= 0 && from) {
+        toNnAddr(hostAddr, from);
+        if (fromLen)
+            *fromLen = sizeof(NnSockAddr);
+    }
+
+    return result;
+}
+
+s32 GetSockName(s32 socket, sockaddr* name, u32* dataLen) {
+    sockaddr_in hostAddr = {};
+    socklen_t hostLen = sizeof(hostAddr);
+
+    s32 result = getsockname(socket, reinterpret_cast<sockaddr*>(&hostAddr), &hostLen);
+
+    if (result == 0) {
+        toNnAddr(hostAddr, name);
+        *dataLen = sizeof(NnSockAddr);
+    }
+
+    return result;
+}
+
+u16 InetHtons(u16 val) {
+    return htons(val);
+}
+
+u16 InetNtohs(u16 val) {
+    return ntohs(val);
+}
+
+s32 InetAton(const char* addressStr, in_addr* addressOut) {
+    return inet_aton(addressStr, addressOut);
+}
+
+hostent* GetHostByName(const char* name) {
+    return gethostbyname(name);
+}
+
+u32 GetLastErrno() {
+    return errno;
+}
+
+s32 Bind(s32 fd, sockaddr* addr, u32) {
+    sockaddr_in hostAddr = toHostAddr(addr);
+    return bind(fd, reinterpret_cast<const sockaddr*>(&hostAddr), sizeof(hostAddr));
+}
+
+s32 Poll(pollfd* fd, u64 count, s32 timeout) {
+    return poll(fd, count, timeout);
+}
+
+} }
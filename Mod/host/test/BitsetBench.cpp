@@ -0,0 +1,144 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "packets/Packet.h"
+#include "server/Bitset.hpp"
+
+// times Bitset against the shifting mask loops Client::addShine and hasShine used before it
+//
+// usage: bitsetBench [-n count] [-u uids]
+//   -n  lookups per measurement (default 10000000)
+//   -u  random shine uids added before the lookups (default 600)
+
+namespace {
+
+// the old Client::addShine, walks a mask along the word until it reaches uid and never gets to bit 31
+void addShineLoop(int* shines, int uid) {
+    int word = shines[uid / 32];
+
+    int index = (uid / 32) * 32;
+    int i = 1;
+    while (i > 0) {
+        if (index == uid) {
+            word = word | i;
+            break;
+        }
+        i = i << 1;
+        index += 1;
+    }
+
+    shines[uid / 32] = word;
+}
+
+// the old Client::hasShine
+bool hasShineLoop(const int* shines, int uid) {
+    int word = shines[uid / 32];
+
+    int index = (uid / 32) * 32;
+    int i = 1;
+    while (i > 0) {
+        if (index == uid) {
+            word = word & i;
+            return (word == i);
+        }
+        i = i << 1;
+        index += 1;
+    }
+    return false;
+}
+
+double getNowNs() {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// keeps the compiler from dropping the lookups whose result nobody reads
+volatile u32 sSink = 0;
+
+// outside of main so the stores into them can't be sunk past the timing
+int sLoopShines[SHINEBITMAPWORDS] = {};
+Bitset<SHINEBITMAPWORDS * 32> sBitShines;
+
+template <typename Func>
+double measureNs(const std::vector<int>& uids, Func func) {
+    u32 hits = 0;
+
+    double startTime = getNowNs();
+    for (int uid : uids) {
+        hits += func(uid);
+    }
+    // every store the loop made has to land before the clock is read again
+    asm volatile("" ::: "memory");
+    double elapsed = getNowNs() - startTime;
+
+    sSink = sSink + hits;
+    return elapsed / uids.size();
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    u32 count = 10000000;
+    u32 uidCount = 600;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-n") && i + 1 < argc) {
+            count = strtoul(argv[++i], nullptr, 10);
+        } else if (!strcmp(argv[i], "-u") && i + 1 < argc) {
+            uidCount = strtoul(argv[++i], nullptr, 10);
+        } else {
+            fprintf(stderr, "usage: %s [-n count] [-u uids]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    constexpr int cShineCount = SHINEBITMAPWORDS * 32;
+
+    // fixed seed so runs compare, lookups hit and miss in the same order for both
+    std::mt19937 random(1);
+    std::uniform_int_distribution<int> distribution(0, cShineCount - 1);
+
+    std::vector<int> added(uidCount);
+    for (int& uid : added) {
+        uid = distribution(random);
+    }
+
+    std::vector<int> lookups(count);
+    for (int& uid : lookups) {
+        uid = distribution(random);
+    }
+
+    double loopAddNs = measureNs(added, [&](int uid) { addShineLoop(sLoopShines, uid); return 0; });
+    double bitAddNs = measureNs(added, [&](int uid) { sBitShines.set(uid); return 0; });
+
+    // the lookups are the hot path, isGrabShine and co ask for every shine the game touches
+    double loopHasNs = measureNs(lookups, [&](int uid) { return hasShineLoop(sLoopShines, uid); });
+    double bitHasNs = measureNs(lookups, [&](int uid) { return sBitShines.test(uid); });
+
+    // and the add side again over enough calls to time
+    double loopReaddNs = measureNs(lookups, [&](int uid) { addShineLoop(sLoopShines, uid); return 0; });
+    double bitReaddNs = measureNs(lookups, [&](int uid) { sBitShines.set(uid); return 0; });
+
+    // replays the adds into fresh sets, the ones timed above also hold every lookup by now
+    int replayShines[SHINEBITMAPWORDS] = {};
+    Bitset<cShineCount> replayBits;
+    for (int uid : added) {
+        addShineLoop(replayShines, uid);
+        replayBits.set(uid);
+    }
+
+    // every uid added once, the bitset can't drop any so it serves as the reference
+    u32 loopLost = 0;
+    replayBits.forEach([&](int uid) { loopLost += !hasShineLoop(replayShines, uid); });
+
+    printf("%u lookups over %u added uids\n", count, uidCount);
+    printf("hasShine  loop %6.2fns  bitset %6.2fns\n", loopHasNs, bitHasNs);
+    printf("addShine  loop %6.2fns  bitset %6.2fns  (first %u adds: %.2fns vs %.2fns)\n", loopReaddNs, bitReaddNs,
+           uidCount, loopAddNs, bitAddNs);
+    printf("the loop lost %u of %u distinct uids\n", loopLost, replayBits.count());
+
+    return 0;
+}
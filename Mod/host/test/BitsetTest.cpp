@@ -0,0 +1,209 @@
+#include <cstdio>
+#include <vector>
+
+#include "packets/Packet.h"
+#include "server/Bitset.hpp"
+
+// checks Bitset with the sizes Client uses, the edge cases the old shift loops got wrong at compile time and every
+// bit at runtime
+//
+// usage: bitsetTest, exits with the amount of failed checks
+
+namespace {
+
+// the old shift loops stopped before bit 31 of every word
+constexpr bool isTopBitReachable() {
+    Bitset<64> bits;
+    bits.set(31);
+    bits.set(63);
+    return bits.test(31) && bits.test(63) && !bits.test(30) && bits.count() == 2 && bits.getWord(0) == 0x80000000;
+}
+
+constexpr bool isOutOfRangeIgnored() {
+    Bitset<40> bits;
+    bits.set(-1);
+    bits.set(40);
+    bits.mergeWord(1, ~0u);
+    return !bits.test(-1) && !bits.test(40) && bits.test(39) && bits.count() == 8;
+}
+
+constexpr bool isIteratedInOrder() {
+    Bitset<100> bits;
+    bits.set(99);
+    bits.set(0);
+    bits.set(32);
+    int sum = 0;
+    int last = -1;
+    bool isOrdered = true;
+    bits.forEach([&](int index) {
+        isOrdered &= index > last;
+        last = index;
+        sum += index;
+    });
+    return isOrdered && sum == 131;
+}
+
+static_assert(isTopBitReachable(), "Bitset can't reach the top bit of a word");
+static_assert(isOutOfRangeIgnored(), "Bitset doesn't ignore indices outside of it");
+static_assert(isIteratedInOrder(), "Bitset::forEach skips or reorders bits");
+
+int sFailCount = 0;
+
+#define CHECK(cond)                                                  \
+    do {                                                             \
+        if (!(cond)) {                                               \
+            printf("%s:%d: failed %s\n", __FILE__, __LINE__, #cond); \
+            sFailCount++;                                            \
+        }                                                            \
+    } while (0)
+
+template <u32 N>
+void testEveryBit() {
+    for (int i = 0; i < (int)N; i++) {
+        Bitset<N> bits;
+        bits.set(i);
+
+        CHECK(bits.test(i));
+        CHECK(bits.count() == 1);
+        CHECK(bits.getWord(i / 32) == 1u << (i % 32));
+        CHECK(!bits.test(i - 1));
+        CHECK(!bits.test(i + 1));
+
+        bits.reset(i);
+        CHECK(!bits.test(i));
+        CHECK(bits.count() == 0);
+    }
+}
+
+template <u32 N>
+void testOutOfRange() {
+    Bitset<N> bits;
+    const int indices[] = {-1, -32, (int)N, (int)N + 1, (int)N + 31, 0x7fffffff, (int)0x80000000};
+
+    for (int index : indices) {
+        bits.set(index);
+        CHECK(!bits.test(index));
+    }
+    CHECK(bits.count() == 0);
+
+    for (u32 i = 0; i < Bitset<N>::sWordCount; i++) {
+        bits.mergeWord(i, ~0u);
+    }
+    bits.mergeWord(Bitset<N>::sWordCount, ~0u);
+
+    CHECK(bits.count() == N);
+    CHECK(bits.getWord(Bitset<N>::sWordCount) == 0);
+    for (int index : indices) {
+        CHECK(!bits.test(index));
+    }
+
+    // resetting outside of the set must leave the bits inside alone
+    bits.reset(-1);
+    bits.reset(N);
+    CHECK(bits.count() == N);
+}
+
+void testTopBits() {
+    Bitset<SHINEBITMAPWORDS * 32> bits;
+
+    // every shine uid the old shifting loop could never reach
+    for (int i = 31; i < (int)bits.size(); i += 32) {
+        bits.set(i);
+    }
+
+    CHECK(bits.count() == SHINEBITMAPWORDS);
+    for (u32 i = 0; i < SHINEBITMAPWORDS; i++) {
+        CHECK(bits.getWord(i) == 0x80000000);
+        CHECK(bits.test(i * 32 + 31));
+        CHECK(!bits.test(i * 32 + 30));
+    }
+}
+
+void testMerge() {
+    Bitset<88> a;
+    Bitset<88> b;
+    a.set(0);
+    a.set(31);
+    a.set(64);
+    b.set(31);
+    b.set(32);
+    b.set(87);
+
+    a.merge(b);
+    CHECK(a.count() == 5);
+    CHECK(a.test(0) && a.test(31) && a.test(32) && a.test(64) && a.test(87));
+    CHECK(b.count() == 3);
+
+    // merging is an OR, doing it twice changes nothing
+    a.merge(b);
+    CHECK(a.count() == 5);
+
+    a.clear();
+    CHECK(a.count() == 0);
+    for (u32 i = 0; i < a.sWordCount; i++) {
+        CHECK(a.getWord(i) == 0);
+    }
+}
+
+void testForEach() {
+    Bitset<SHINEBITMAPWORDS * 32> bits;
+    std::vector<int> expected;
+
+    // a deterministic spread of uids, including the first, last and top bit of a word
+    for (int i = 0; i < (int)bits.size(); i += 5) {
+        bits.set(i);
+        expected.push_back(i);
+    }
+    bits.set(bits.size() - 1);
+    expected.push_back(bits.size() - 1);
+
+    std::vector<int> visited;
+    bits.forEach([&](int index) { visited.push_back(index); });
+
+    CHECK(visited == expected);
+    CHECK(bits.count() == expected.size());
+
+    Bitset<56> empty;
+    int calls = 0;
+    empty.forEach([&](int) { calls++; });
+    CHECK(calls == 0);
+}
+
+void testWordLayout() {
+    // collectedShines goes out in a SHINEBITMAP as is, so the words are the packet's layout
+    Bitset<SHINEBITMAPWORDS * 32> bits;
+    CHECK(sizeof(bits) == SHINEBITMAPSIZE);
+
+    bits.set(33);
+    bits.set(70);
+    CHECK(bits.getWords()[1] == 2);
+    CHECK(bits.getWords()[2] == 1u << 6);
+}
+
+}  // namespace
+
+int main() {
+    testEveryBit<24>();
+    testEveryBit<32>();
+    testEveryBit<56>();
+    testEveryBit<88>();
+    testEveryBit<SHINEBITMAPWORDS * 32>();
+
+    testOutOfRange<24>();
+    testOutOfRange<32>();
+    testOutOfRange<56>();
+    testOutOfRange<SHINEBITMAPWORDS * 32>();
+
+    testTopBits();
+    testMerge();
+    testForEach();
+    testWordLayout();
+
+    if (sFailCount) {
+        printf("%d Bitset checks failed\n", sFailCount);
+    } else {
+        printf("Bitset checks passed\n");
+    }
+
+    return sFailCount;
+}
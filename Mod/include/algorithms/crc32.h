@@ -100,6 +100,17 @@ namespace crc32 {
             });
         }
 
+        constexpr HashArray(const char* const (&strings)[Length]) : HashArray(std::to_array(strings)) {}
+
+        /* Two strings sharing a hash would make one of them unreachable, check this in a static_assert. */
+        constexpr bool HasCollisions() const {
+            for(size_t i = 1; i < Length; i++) {
+                if (m_Hashes[i - 1].first == m_Hashes[i].first)
+                    return true;
+            }
+            return false;
+        }
+
         constexpr std::int64_t FindIndex(std::string_view const& str) const {
             auto hash = crc32::HashStr(str);
             auto begin = m_Hashes.cbegin();
@@ -35,6 +35,7 @@ int getIndexStickerList(const char *stickerName);
 int getIndexSouvenirList(const char *souvenirName);
 int getIndexCaptureList(const char *captureName);
 int getIndexMoonItemList(const char *moonItemName);
+int getIndexWorldHomeStage(const char *stageName);
 
 const char *tryGetPuppetCapName(PuppetInfo *info);
 const char* tryGetPuppetBodyName(PuppetInfo* info);
@@ -46,7 +47,7 @@ void killMainPlayer(PlayerActorHakoniwa* mainPlayer);
 
 const char* intToCstr(int number);
 
-__attribute__((used)) static const char* costumeNames[] = {
+__attribute__((used)) static constexpr const char* costumeNames[] = {
     "Mario",
     "MarioTailCoat",
     "MarioPrimitiveMan",
@@ -122,7 +123,7 @@ __attribute__((used)) static const char* costumeNames[] = {
 //     // "MarioZombie" // DLC
 // };
 
-__attribute__((used)) static const char* stickerNames[] = {
+__attribute__((used)) static constexpr const char* stickerNames[] = {
     "StickerCap",
     "StickerWaterfall",
     "StickerSand",
@@ -142,7 +143,7 @@ __attribute__((used)) static const char* stickerNames[] = {
     "StickerPeach"
 };
 
-__attribute__((used)) static const char* souvenirNames[] = {
+__attribute__((used)) static constexpr const char* souvenirNames[] = {
     "SouvenirHat1",
     "SouvenirHat2",
     "SouvenirFall1",
@@ -171,7 +172,7 @@ __attribute__((used)) static const char* souvenirNames[] = {
     "SouvenirPeach2"
 };
 
-__attribute__((used)) static const char* moonItemNames[] = {
+__attribute__((used)) static constexpr const char* moonItemNames[] = {
     "MoonCity", // 101
     "MoonForest", // 138
     "MoonWaterfall", //211   
@@ -187,7 +188,32 @@ __attribute__((used)) static const char* moonItemNames[] = {
     "MoonMoon" // 1157
 };
 
-__attribute__((used)) static const char* captureListNames[] = {
+#define WORLDCOUNT 17
+
+// indexed by world id, in the order of GameDataFunction::getWorldIndex*
+__attribute__((used)) static constexpr const char* worldHomeStageNames[] = {
+    "CapWorldHomeStage",
+    "WaterfallWorldHomeStage",
+    "SandWorldHomeStage",
+    "ForestWorldHomeStage",
+    "LakeWorldHomeStage",
+    "CloudWorldHomeStage",
+    "ClashWorldHomeStage",
+    "CityWorldHomeStage",
+    "SeaWorldHomeStage",
+    "SnowWorldHomeStage",
+    "LavaWorldHomeStage",
+    "BossRaidWorldHomeStage",
+    "SkyWorldHomeStage",
+    "MoonWorldHomeStage",
+    "PeachWorldHomeStage",
+    "Special1WorldHomeStage",
+    "Special2WorldHomeStage"
+};
+
+static_assert(ACNT(worldHomeStageNames) == WORLDCOUNT, "worldHomeStageNames needs a name for every world");
+
+__attribute__((used)) static constexpr const char* captureListNames[] = {
     "Frog",
     "ElectricWire", // Spark pylon
     "KuriboWing", // Paragoomba
@@ -259,6 +285,55 @@ struct shineReplaceText {
     //s8 color;
 };
 
+struct hintArtInfo {
+    s16 shineUid; // 0 if the world has no hint art
+    u8 textIndex; // index into the shine text replacements
+};
+
+// Hint art moons have no uid of their own (mUniqueID is 0 on the moon in the other world), but the stage name in their
+// shine info is still the kingdom the hint art is in. Indexed by that kingdom's world id.
+static constexpr hintArtInfo worldHintArts[WORLDCOUNT] = {
+    {1086, 98}, // Cap
+    {0, 98},    // Waterfall
+    {1096, 98}, // Sand
+    {1089, 98}, // Forest
+    {1094, 98}, // Lake
+    {0, 98},    // Cloud
+    {0, 98},    // Clash
+    {1088, 98}, // City
+    {1095, 98}, // Sea
+    {1087, 98}, // Snow
+    {1090, 98}, // Lava
+    {0, 98},    // BossRaid
+    {1091, 99}, // Sky
+    {1165, 98}, // Moon
+    {1152, 98}, // Peach
+    {0, 99},    // Special1, depends on the main stage, see darkSideHintArtUids
+    {0, 98}     // Special2
+};
+
+// The Dark Side has a hint art for most kingdoms, which one a moon belongs to is picked by the current main stage.
+// Indexed by the main stage's world id.
+static constexpr s16 darkSideHintArtUids[WORLDCOUNT] = {
+    0,    // Cap
+    1132, // Waterfall
+    0,    // Sand
+    0,    // Forest
+    1128, // Lake
+    1124, // Cloud
+    1126, // Clash
+    1130, // City
+    1127, // Sea
+    1129, // Snow
+    1123, // Lava
+    1125, // BossRaid
+    0,    // Sky
+    0,    // Moon
+    1131, // Peach
+    0,    // Special1
+    0     // Special2
+};
+
 struct shopReplaceText {
     u8 gameIndex;
     u8 slotIndex;
@@ -272,7 +347,7 @@ struct HackActorName {
 };
 
 // attribute otherwise the build log is spammed with unused warnings
-__attribute__((used)) static HackActorName classHackNames[] = {
+__attribute__((used)) static constexpr HackActorName classHackNames[] = {
     {"SenobiGeneratePoint", "Senobi"},
     {"KuriboPossessed", "Kuribo"},
     {"KillerLauncher", "Killer"},
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstring>
+
+#include "Packet.h"
+
+#define ARRAYPACKETHEADERSIZE sizeof(u16)
+
+/**
+ * @brief read only view over the entries of an array packet, a u16 count followed by that many packed entries
+ *
+ * Entries are read straight out of the packet buffer, the count is clamped to what mPacketSize actually holds so a
+ * short or corrupt packet can't walk past its end. Array packets larger than MAXPACKSIZE arrive as FRAGMENTs.
+ *
+ * @tparam Entry packed entry type, copied out one at a time since entries are not aligned
+ */
+template <typename Entry>
+class ArrayPacketView {
+    public:
+        class Iterator {
+            public:
+                Iterator(const u8* pos) : mPos(pos) {}
+                Entry operator*() const {
+                    Entry entry;
+                    memcpy(&entry, mPos, sizeof(Entry));
+                    return entry;
+                }
+                Iterator& operator++() {
+                    mPos += sizeof(Entry);
+                    return *this;
+                }
+                bool operator!=(const Iterator& other) const { return mPos != other.mPos; }
+
+            private:
+                const u8* mPos;
+        };
+
+        explicit ArrayPacketView(const Packet* packet) {
+            const u8* payload = reinterpret_cast<const u8*>(packet) + sizeof(Packet);
+            u16 count;
+            memcpy(&count, payload, sizeof(u16));
+
+            u32 capacity = packet->mPacketSize > (short)ARRAYPACKETHEADERSIZE
+                               ? (packet->mPacketSize - ARRAYPACKETHEADERSIZE) / sizeof(Entry)
+                               : 0;
+
+            mData = payload + ARRAYPACKETHEADERSIZE;
+            mCount = count < capacity ? count : capacity;
+        }
+
+        u32 size() const { return mCount; }
+        bool isEmpty() const { return mCount == 0; }
+
+        Entry operator[](u32 index) const { return *Iterator(mData + index * sizeof(Entry)); }
+
+        Iterator begin() const { return Iterator(mData); }
+        Iterator end() const { return Iterator(mData + mCount * sizeof(Entry)); }
+
+    private:
+        const u8* mData;
+        u32 mCount;
+};
+
+/**
+ * @brief array packet sized for one MAXPACKSIZE packet, mPacketSize only covers the entries added
+ *
+ * @tparam Type packet type sent in the header
+ * @tparam Entry packed entry type
+ */
+template <PacketType Type, typename Entry>
+struct PACKED ArrayPacket : Packet {
+    static constexpr u32 sCapacity = (MAXPACKSIZE - sizeof(Packet) - ARRAYPACKETHEADERSIZE) / sizeof(Entry);
+
+    ArrayPacket() : Packet() {mType = Type; mPacketSize = ARRAYPACKETHEADERSIZE;};
+    u16 count = 0;
+    Entry entries[sCapacity] = {};
+
+    // returns false once the packet is full
+    bool add(const Entry& entry) {
+        if (count >= sCapacity)
+            return false;
+        entries[count++] = entry;
+        mPacketSize += sizeof(Entry);
+        return true;
+    }
+
+    ArrayPacketView<Entry> getEntries() const { return ArrayPacketView<Entry>(this); }
+};
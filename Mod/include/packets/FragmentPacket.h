@@ -0,0 +1,18 @@
+#pragma once
+
+#include "Packet.h"
+
+#define FRAGMENTHEADERSIZE 8
+#define FRAGMENTDATASIZE (MAXPACKSIZE - sizeof(Packet) - FRAGMENTHEADERSIZE)
+
+// one slice of a packet too large for MAXPACKSIZE, the receiver stitches every slice with the same messageId back
+// into the original packet (header included) once totalLength bytes have arrived
+struct PACKED FragmentPacket : Packet {
+    FragmentPacket() : Packet() {mType = PacketType::FRAGMENT; mPacketSize = FRAGMENTHEADERSIZE;};
+    u16 messageId = 0;
+    u16 fragmentIndex = 0; // slice starts at fragmentIndex * FRAGMENTDATASIZE
+    u32 totalLength = 0;
+    u8 data[FRAGMENTDATASIZE] = {}; // mPacketSize only covers the bytes used
+};
+
+static_assert(sizeof(FragmentPacket) == MAXPACKSIZE, "FragmentPacket must fill exactly one packet");
@@ -1,8 +1,14 @@
 #pragma once
 
+#include <cstddef>
+
 #include "Packet.h"
 
 struct PACKED InitPacket : Packet {
     InitPacket() : Packet() {this->mType = PacketType::CLIENTINIT; mPacketSize = sizeof(InitPacket) - sizeof(Packet);};
     u16 maxPlayers = 0;
-};
\ No newline at end of file
+    u8 sessionId = NOSESSION; // ours for this connection, NOSESSION keeps every udp datagram on the full header
+
+    // servers from before session ids send a shorter packet
+    u8 getSessionId() const { return mPacketSize > (short)(offsetof(InitPacket, sessionId) - sizeof(Packet)) ? sessionId : NOSESSION; }
+};
@@ -14,6 +14,9 @@
 #define APMESSAGESIZE    0x4B
 #define OBJECTIDSIZE     0x20
 #define MAXPACKSIZE      0x100
+#define MAXMESSAGESIZE   0x4000 // largest packet that can be sent as FRAGMENTs, header included
+#define MAXSESSIONCOUNT  0x100 // session ids are a single byte
+#define NOSESSION        0 // never assigned, servers that don't hand out session ids leave it at this
 
 enum PacketType : short {
     UNKNOWN,
@@ -40,6 +43,13 @@ enum PacketType : short {
     SHINECOLOR,
     UDPINIT,
     HOLEPUNCH,
+    PING,
+    PONG,
+    PLAYERINFKEY,
+    PLAYERINFDELTA,
+    FRAGMENT,
+    SLOTBUNDLE,
+    SHINEBITMAP,
     End // end of enum for bounds checking
 };
 
@@ -69,7 +79,14 @@ USED static const char *packetNames[] = {
     "Shine Color",
     "Udp Initialization",
     "Hole punch",
-    
+    "Ping",
+    "Pong",
+    "Player Info Keyframe",
+    "Player Info Delta",
+    "Fragment",
+    "Slot Data Bundle",
+    "Shine Bitmap",
+
 };
 
 enum SenderType {
@@ -96,6 +113,16 @@ struct PACKED Packet {
     short mPacketSize = 0; // represents packet size without size of header
 };
 
+// header of every udp datagram once the server has assigned us a session id (see InitPacket::sessionId). The sender is
+// named by its session id instead of its Uid, the receiving SocketClient expands it back into a full Packet
+struct PACKED CompactPacket {
+    PacketType mType = PacketType::UNKNOWN;
+    short mPacketSize = 0; // same as Packet::mPacketSize
+    u8 mSessionId = NOSESSION;
+};
+
+static_assert(sizeof(CompactPacket) == 5, "compact header is type, size and session id");
+
 // all packet types
 
 #include "packets/PlayerInfPacket.h"
@@ -121,3 +148,10 @@ struct PACKED Packet {
 #include "packets/InitPacket.h"
 #include "packets/UdpPacket.h"
 #include "packets/HolePunchPacket.h"
+#include "packets/PingPacket.h"
+#include "packets/PlayerInfDelta.h"
+#include "packets/FragmentPacket.h"
+#include "packets/SlotBundle.h"
+#include "packets/ShineBitmap.h"
+
+#include "packets/PacketLayout.h"
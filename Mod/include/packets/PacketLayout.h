@@ -0,0 +1,566 @@
+#pragma once
+
+// generated by scripts/genPackets.py from scripts/packets.schema, edit that and run make packets instead
+
+#include <cstddef>
+#include <type_traits>
+
+#include "Packet.h"
+
+static_assert(COSTUMEBUFSIZE == 0x20, "COSTUMEBUFSIZE doesn't match packets.schema");
+static_assert(APNAMESIZE == 0x28, "APNAMESIZE doesn't match packets.schema");
+static_assert(APMESSAGESIZE == 0x4B, "APMESSAGESIZE doesn't match packets.schema");
+static_assert(SLOTTABLECOUNT == 0x7, "SLOTTABLECOUNT doesn't match packets.schema");
+
+// Packet
+static_assert(sizeof(Packet) == 20, "Packet size doesn't match packets.schema");
+static_assert(offsetof(Packet, mUserID) == 0, "Packet::mUserID offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(Packet::mUserID), nn::account::Uid>, "Packet::mUserID type doesn't match packets.schema");
+static_assert(sizeof(Packet::mUserID) == 16, "Packet::mUserID size doesn't match packets.schema");
+static_assert(offsetof(Packet, mType) == 16, "Packet::mType offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(Packet::mType), PacketType>, "Packet::mType type doesn't match packets.schema");
+static_assert(sizeof(Packet::mType) == 2, "Packet::mType size doesn't match packets.schema");
+static_assert(offsetof(Packet, mPacketSize) == 18, "Packet::mPacketSize offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(Packet::mPacketSize), s16>, "Packet::mPacketSize type doesn't match packets.schema");
+
+// PlayerConnect
+static_assert(sizeof(PlayerConnect) - sizeof(Packet) == 67, "PlayerConnect size doesn't match packets.schema");
+static_assert(offsetof(PlayerConnect, conType) - sizeof(Packet) == 0, "PlayerConnect::conType offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(PlayerConnect::conType), ConnectionTypes>, "PlayerConnect::conType type doesn't match packets.schema");
+static_assert(sizeof(PlayerConnect::conType) == 4, "PlayerConnect::conType size doesn't match packets.schema");
+static_assert(offsetof(PlayerConnect, maxPlayerCount) - sizeof(Packet) == 4, "PlayerConnect::maxPlayerCount offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(PlayerConnect::maxPlayerCount), u16>, "PlayerConnect::maxPlayerCount type doesn't match packets.schema");
+static_assert(offsetof(PlayerConnect, clientName) - sizeof(Packet) == 6, "PlayerConnect::clientName offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(PlayerConnect::clientName), char[32]>, "PlayerConnect::clientName type doesn't match packets.schema");
+static_assert(offsetof(PlayerConnect, slotTableHashes) - sizeof(Packet) == 38, "PlayerConnect::slotTableHashes offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(PlayerConnect::slotTableHashes), u32[7]>, "PlayerConnect::slotTableHashes type doesn't match packets.schema");
+static_assert(offsetof(PlayerConnect, sessionId) - sizeof(Packet) == 66, "PlayerConnect::sessionId offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(PlayerConnect::sessionId), u8>, "PlayerConnect::sessionId type doesn't match packets.schema");
+
+// InitPacket
+static_assert(sizeof(InitPacket) - sizeof(Packet) == 3, "InitPacket size doesn't match packets.schema");
+static_assert(offsetof(InitPacket, maxPlayers) - sizeof(Packet) == 0, "InitPacket::maxPlayers offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(InitPacket::maxPlayers), u16>, "InitPacket::maxPlayers type doesn't match packets.schema");
+static_assert(offsetof(InitPacket, sessionId) - sizeof(Packet) == 2, "InitPacket::sessionId offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(InitPacket::sessionId), u8>, "InitPacket::sessionId type doesn't match packets.schema");
+
+// Check
+static_assert(sizeof(Check) - sizeof(Packet) == 80, "Check size doesn't match packets.schema");
+static_assert(offsetof(Check, locationId) - sizeof(Packet) == 0, "Check::locationId offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(Check::locationId), s32>, "Check::locationId type doesn't match packets.schema");
+static_assert(offsetof(Check, itemType) - sizeof(Packet) == 4, "Check::itemType offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(Check::itemType), s32>, "Check::itemType type doesn't match packets.schema");
+static_assert(offsetof(Check, index) - sizeof(Packet) == 8, "Check::index offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(Check::index), s32>, "Check::index type doesn't match packets.schema");
+static_assert(offsetof(Check, objId) - sizeof(Packet) == 12, "Check::objId offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(Check::objId), char[16]>, "Check::objId type doesn't match packets.schema");
+static_assert(offsetof(Check, stage) - sizeof(Packet) == 28, "Check::stage offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(Check::stage), char[48]>, "Check::stage type doesn't match packets.schema");
+static_assert(offsetof(Check, amount) - sizeof(Packet) == 76, "Check::amount offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(Check::amount), s32>, "Check::amount type doesn't match packets.schema");
+
+// ChangeStagePacket
+static_assert(sizeof(ChangeStagePacket) - sizeof(Packet) == 66, "ChangeStagePacket size doesn't match packets.schema");
+static_assert(offsetof(ChangeStagePacket, changeStage) - sizeof(Packet) == 0, "ChangeStagePacket::changeStage offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ChangeStagePacket::changeStage), char[48]>, "ChangeStagePacket::changeStage type doesn't match packets.schema");
+static_assert(offsetof(ChangeStagePacket, changeID) - sizeof(Packet) == 48, "ChangeStagePacket::changeID offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ChangeStagePacket::changeID), char[16]>, "ChangeStagePacket::changeID type doesn't match packets.schema");
+static_assert(offsetof(ChangeStagePacket, scenarioNo) - sizeof(Packet) == 64, "ChangeStagePacket::scenarioNo offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ChangeStagePacket::scenarioNo), s8>, "ChangeStagePacket::scenarioNo type doesn't match packets.schema");
+static_assert(offsetof(ChangeStagePacket, subScenarioType) - sizeof(Packet) == 65, "ChangeStagePacket::subScenarioType offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ChangeStagePacket::subScenarioType), u8>, "ChangeStagePacket::subScenarioType type doesn't match packets.schema");
+
+// ArchipelagoChatMessage
+static_assert(sizeof(ArchipelagoChatMessage) - sizeof(Packet) == 225, "ArchipelagoChatMessage size doesn't match packets.schema");
+static_assert(offsetof(ArchipelagoChatMessage, message1) - sizeof(Packet) == 0, "ArchipelagoChatMessage::message1 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ArchipelagoChatMessage::message1), char[75]>, "ArchipelagoChatMessage::message1 type doesn't match packets.schema");
+static_assert(offsetof(ArchipelagoChatMessage, message2) - sizeof(Packet) == 75, "ArchipelagoChatMessage::message2 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ArchipelagoChatMessage::message2), char[75]>, "ArchipelagoChatMessage::message2 type doesn't match packets.schema");
+static_assert(offsetof(ArchipelagoChatMessage, message3) - sizeof(Packet) == 150, "ArchipelagoChatMessage::message3 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ArchipelagoChatMessage::message3), char[75]>, "ArchipelagoChatMessage::message3 type doesn't match packets.schema");
+
+// SlotData
+static_assert(sizeof(SlotData) - sizeof(Packet) == 28, "SlotData size doesn't match packets.schema");
+static_assert(offsetof(SlotData, cascade) - sizeof(Packet) == 0, "SlotData::cascade offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(SlotData::cascade), u16>, "SlotData::cascade type doesn't match packets.schema");
+static_assert(offsetof(SlotData, sand) - sizeof(Packet) == 2, "SlotData::sand offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(SlotData::sand), u16>, "SlotData::sand type doesn't match packets.schema");
+static_assert(offsetof(SlotData, wooded) - sizeof(Packet) == 4, "SlotData::wooded offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(SlotData::wooded), u16>, "SlotData::wooded type doesn't match packets.schema");
+static_assert(offsetof(SlotData, lake) - sizeof(Packet) == 6, "SlotData::lake offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(SlotData::lake), u16>, "SlotData::lake type doesn't match packets.schema");
+static_assert(offsetof(SlotData, lost) - sizeof(Packet) == 8, "SlotData::lost offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(SlotData::lost), u16>, "SlotData::lost type doesn't match packets.schema");
+static_assert(offsetof(SlotData, metro) - sizeof(Packet) == 10, "SlotData::metro offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(SlotData::metro), u16>, "SlotData::metro type doesn't match packets.schema");
+static_assert(offsetof(SlotData, seaside) - sizeof(Packet) == 12, "SlotData::seaside offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(SlotData::seaside), u16>, "SlotData::seaside type doesn't match packets.schema");
+static_assert(offsetof(SlotData, snow) - sizeof(Packet) == 14, "SlotData::snow offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(SlotData::snow), u16>, "SlotData::snow type doesn't match packets.schema");
+static_assert(offsetof(SlotData, luncheon) - sizeof(Packet) == 16, "SlotData::luncheon offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(SlotData::luncheon), u16>, "SlotData::luncheon type doesn't match packets.schema");
+static_assert(offsetof(SlotData, ruined) - sizeof(Packet) == 18, "SlotData::ruined offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(SlotData::ruined), u16>, "SlotData::ruined type doesn't match packets.schema");
+static_assert(offsetof(SlotData, bowser) - sizeof(Packet) == 20, "SlotData::bowser offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(SlotData::bowser), u16>, "SlotData::bowser type doesn't match packets.schema");
+static_assert(offsetof(SlotData, dark) - sizeof(Packet) == 22, "SlotData::dark offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(SlotData::dark), u16>, "SlotData::dark type doesn't match packets.schema");
+static_assert(offsetof(SlotData, darker) - sizeof(Packet) == 24, "SlotData::darker offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(SlotData::darker), u16>, "SlotData::darker type doesn't match packets.schema");
+static_assert(offsetof(SlotData, regionals) - sizeof(Packet) == 26, "SlotData::regionals offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(SlotData::regionals), bool>, "SlotData::regionals type doesn't match packets.schema");
+static_assert(offsetof(SlotData, captures) - sizeof(Packet) == 27, "SlotData::captures offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(SlotData::captures), bool>, "SlotData::captures type doesn't match packets.schema");
+
+// ApInfo
+static_assert(sizeof(ApInfo) - sizeof(Packet) == 128, "ApInfo size doesn't match packets.schema");
+static_assert(offsetof(ApInfo, infoType) - sizeof(Packet) == 0, "ApInfo::infoType offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ApInfo::infoType), s16>, "ApInfo::infoType type doesn't match packets.schema");
+static_assert(offsetof(ApInfo, index1) - sizeof(Packet) == 2, "ApInfo::index1 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ApInfo::index1), s16>, "ApInfo::index1 type doesn't match packets.schema");
+static_assert(offsetof(ApInfo, index2) - sizeof(Packet) == 4, "ApInfo::index2 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ApInfo::index2), s16>, "ApInfo::index2 type doesn't match packets.schema");
+static_assert(offsetof(ApInfo, index3) - sizeof(Packet) == 6, "ApInfo::index3 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ApInfo::index3), s16>, "ApInfo::index3 type doesn't match packets.schema");
+static_assert(offsetof(ApInfo, info1) - sizeof(Packet) == 8, "ApInfo::info1 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ApInfo::info1), char[40]>, "ApInfo::info1 type doesn't match packets.schema");
+static_assert(offsetof(ApInfo, info2) - sizeof(Packet) == 48, "ApInfo::info2 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ApInfo::info2), char[40]>, "ApInfo::info2 type doesn't match packets.schema");
+static_assert(offsetof(ApInfo, info3) - sizeof(Packet) == 88, "ApInfo::info3 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ApInfo::info3), char[40]>, "ApInfo::info3 type doesn't match packets.schema");
+
+// ShopReplacePacket
+static_assert(sizeof(ShopReplacePacket) - sizeof(Packet) == 177, "ShopReplacePacket size doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, infoType) - sizeof(Packet) == 0, "ShopReplacePacket::infoType offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::infoType), u8>, "ShopReplacePacket::infoType type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, gameIndex0) - sizeof(Packet) == 1, "ShopReplacePacket::gameIndex0 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::gameIndex0), u8>, "ShopReplacePacket::gameIndex0 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, playerIndex0) - sizeof(Packet) == 2, "ShopReplacePacket::playerIndex0 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::playerIndex0), u8>, "ShopReplacePacket::playerIndex0 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemIndex0) - sizeof(Packet) == 3, "ShopReplacePacket::itemIndex0 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemIndex0), u8>, "ShopReplacePacket::itemIndex0 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemClassification0) - sizeof(Packet) == 4, "ShopReplacePacket::itemClassification0 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemClassification0), u8>, "ShopReplacePacket::itemClassification0 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, gameIndex1) - sizeof(Packet) == 5, "ShopReplacePacket::gameIndex1 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::gameIndex1), u8>, "ShopReplacePacket::gameIndex1 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, playerIndex1) - sizeof(Packet) == 6, "ShopReplacePacket::playerIndex1 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::playerIndex1), u8>, "ShopReplacePacket::playerIndex1 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemIndex1) - sizeof(Packet) == 7, "ShopReplacePacket::itemIndex1 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemIndex1), u8>, "ShopReplacePacket::itemIndex1 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemClassification1) - sizeof(Packet) == 8, "ShopReplacePacket::itemClassification1 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemClassification1), u8>, "ShopReplacePacket::itemClassification1 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, gameIndex2) - sizeof(Packet) == 9, "ShopReplacePacket::gameIndex2 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::gameIndex2), u8>, "ShopReplacePacket::gameIndex2 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, playerIndex2) - sizeof(Packet) == 10, "ShopReplacePacket::playerIndex2 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::playerIndex2), u8>, "ShopReplacePacket::playerIndex2 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemIndex2) - sizeof(Packet) == 11, "ShopReplacePacket::itemIndex2 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemIndex2), u8>, "ShopReplacePacket::itemIndex2 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemClassification2) - sizeof(Packet) == 12, "ShopReplacePacket::itemClassification2 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemClassification2), u8>, "ShopReplacePacket::itemClassification2 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, gameIndex3) - sizeof(Packet) == 13, "ShopReplacePacket::gameIndex3 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::gameIndex3), u8>, "ShopReplacePacket::gameIndex3 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, playerIndex3) - sizeof(Packet) == 14, "ShopReplacePacket::playerIndex3 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::playerIndex3), u8>, "ShopReplacePacket::playerIndex3 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemIndex3) - sizeof(Packet) == 15, "ShopReplacePacket::itemIndex3 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemIndex3), u8>, "ShopReplacePacket::itemIndex3 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemClassification3) - sizeof(Packet) == 16, "ShopReplacePacket::itemClassification3 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemClassification3), u8>, "ShopReplacePacket::itemClassification3 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, gameIndex4) - sizeof(Packet) == 17, "ShopReplacePacket::gameIndex4 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::gameIndex4), u8>, "ShopReplacePacket::gameIndex4 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, playerIndex4) - sizeof(Packet) == 18, "ShopReplacePacket::playerIndex4 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::playerIndex4), u8>, "ShopReplacePacket::playerIndex4 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemIndex4) - sizeof(Packet) == 19, "ShopReplacePacket::itemIndex4 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemIndex4), u8>, "ShopReplacePacket::itemIndex4 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemClassification4) - sizeof(Packet) == 20, "ShopReplacePacket::itemClassification4 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemClassification4), u8>, "ShopReplacePacket::itemClassification4 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, gameIndex5) - sizeof(Packet) == 21, "ShopReplacePacket::gameIndex5 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::gameIndex5), u8>, "ShopReplacePacket::gameIndex5 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, playerIndex5) - sizeof(Packet) == 22, "ShopReplacePacket::playerIndex5 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::playerIndex5), u8>, "ShopReplacePacket::playerIndex5 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemIndex5) - sizeof(Packet) == 23, "ShopReplacePacket::itemIndex5 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemIndex5), u8>, "ShopReplacePacket::itemIndex5 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemClassification5) - sizeof(Packet) == 24, "ShopReplacePacket::itemClassification5 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemClassification5), u8>, "ShopReplacePacket::itemClassification5 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, gameIndex6) - sizeof(Packet) == 25, "ShopReplacePacket::gameIndex6 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::gameIndex6), u8>, "ShopReplacePacket::gameIndex6 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, playerIndex6) - sizeof(Packet) == 26, "ShopReplacePacket::playerIndex6 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::playerIndex6), u8>, "ShopReplacePacket::playerIndex6 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemIndex6) - sizeof(Packet) == 27, "ShopReplacePacket::itemIndex6 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemIndex6), u8>, "ShopReplacePacket::itemIndex6 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemClassification6) - sizeof(Packet) == 28, "ShopReplacePacket::itemClassification6 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemClassification6), u8>, "ShopReplacePacket::itemClassification6 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, gameIndex7) - sizeof(Packet) == 29, "ShopReplacePacket::gameIndex7 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::gameIndex7), u8>, "ShopReplacePacket::gameIndex7 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, playerIndex7) - sizeof(Packet) == 30, "ShopReplacePacket::playerIndex7 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::playerIndex7), u8>, "ShopReplacePacket::playerIndex7 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemIndex7) - sizeof(Packet) == 31, "ShopReplacePacket::itemIndex7 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemIndex7), u8>, "ShopReplacePacket::itemIndex7 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemClassification7) - sizeof(Packet) == 32, "ShopReplacePacket::itemClassification7 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemClassification7), u8>, "ShopReplacePacket::itemClassification7 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, gameIndex8) - sizeof(Packet) == 33, "ShopReplacePacket::gameIndex8 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::gameIndex8), u8>, "ShopReplacePacket::gameIndex8 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, playerIndex8) - sizeof(Packet) == 34, "ShopReplacePacket::playerIndex8 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::playerIndex8), u8>, "ShopReplacePacket::playerIndex8 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemIndex8) - sizeof(Packet) == 35, "ShopReplacePacket::itemIndex8 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemIndex8), u8>, "ShopReplacePacket::itemIndex8 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemClassification8) - sizeof(Packet) == 36, "ShopReplacePacket::itemClassification8 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemClassification8), u8>, "ShopReplacePacket::itemClassification8 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, gameIndex9) - sizeof(Packet) == 37, "ShopReplacePacket::gameIndex9 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::gameIndex9), u8>, "ShopReplacePacket::gameIndex9 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, playerIndex9) - sizeof(Packet) == 38, "ShopReplacePacket::playerIndex9 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::playerIndex9), u8>, "ShopReplacePacket::playerIndex9 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemIndex9) - sizeof(Packet) == 39, "ShopReplacePacket::itemIndex9 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemIndex9), u8>, "ShopReplacePacket::itemIndex9 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemClassification9) - sizeof(Packet) == 40, "ShopReplacePacket::itemClassification9 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemClassification9), u8>, "ShopReplacePacket::itemClassification9 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, gameIndex10) - sizeof(Packet) == 41, "ShopReplacePacket::gameIndex10 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::gameIndex10), u8>, "ShopReplacePacket::gameIndex10 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, playerIndex10) - sizeof(Packet) == 42, "ShopReplacePacket::playerIndex10 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::playerIndex10), u8>, "ShopReplacePacket::playerIndex10 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemIndex10) - sizeof(Packet) == 43, "ShopReplacePacket::itemIndex10 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemIndex10), u8>, "ShopReplacePacket::itemIndex10 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemClassification10) - sizeof(Packet) == 44, "ShopReplacePacket::itemClassification10 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemClassification10), u8>, "ShopReplacePacket::itemClassification10 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, gameIndex11) - sizeof(Packet) == 45, "ShopReplacePacket::gameIndex11 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::gameIndex11), u8>, "ShopReplacePacket::gameIndex11 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, playerIndex11) - sizeof(Packet) == 46, "ShopReplacePacket::playerIndex11 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::playerIndex11), u8>, "ShopReplacePacket::playerIndex11 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemIndex11) - sizeof(Packet) == 47, "ShopReplacePacket::itemIndex11 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemIndex11), u8>, "ShopReplacePacket::itemIndex11 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemClassification11) - sizeof(Packet) == 48, "ShopReplacePacket::itemClassification11 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemClassification11), u8>, "ShopReplacePacket::itemClassification11 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, gameIndex12) - sizeof(Packet) == 49, "ShopReplacePacket::gameIndex12 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::gameIndex12), u8>, "ShopReplacePacket::gameIndex12 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, playerIndex12) - sizeof(Packet) == 50, "ShopReplacePacket::playerIndex12 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::playerIndex12), u8>, "ShopReplacePacket::playerIndex12 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemIndex12) - sizeof(Packet) == 51, "ShopReplacePacket::itemIndex12 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemIndex12), u8>, "ShopReplacePacket::itemIndex12 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemClassification12) - sizeof(Packet) == 52, "ShopReplacePacket::itemClassification12 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemClassification12), u8>, "ShopReplacePacket::itemClassification12 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, gameIndex13) - sizeof(Packet) == 53, "ShopReplacePacket::gameIndex13 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::gameIndex13), u8>, "ShopReplacePacket::gameIndex13 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, playerIndex13) - sizeof(Packet) == 54, "ShopReplacePacket::playerIndex13 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::playerIndex13), u8>, "ShopReplacePacket::playerIndex13 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemIndex13) - sizeof(Packet) == 55, "ShopReplacePacket::itemIndex13 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemIndex13), u8>, "ShopReplacePacket::itemIndex13 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemClassification13) - sizeof(Packet) == 56, "ShopReplacePacket::itemClassification13 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemClassification13), u8>, "ShopReplacePacket::itemClassification13 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, gameIndex14) - sizeof(Packet) == 57, "ShopReplacePacket::gameIndex14 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::gameIndex14), u8>, "ShopReplacePacket::gameIndex14 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, playerIndex14) - sizeof(Packet) == 58, "ShopReplacePacket::playerIndex14 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::playerIndex14), u8>, "ShopReplacePacket::playerIndex14 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemIndex14) - sizeof(Packet) == 59, "ShopReplacePacket::itemIndex14 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemIndex14), u8>, "ShopReplacePacket::itemIndex14 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemClassification14) - sizeof(Packet) == 60, "ShopReplacePacket::itemClassification14 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemClassification14), u8>, "ShopReplacePacket::itemClassification14 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, gameIndex15) - sizeof(Packet) == 61, "ShopReplacePacket::gameIndex15 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::gameIndex15), u8>, "ShopReplacePacket::gameIndex15 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, playerIndex15) - sizeof(Packet) == 62, "ShopReplacePacket::playerIndex15 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::playerIndex15), u8>, "ShopReplacePacket::playerIndex15 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemIndex15) - sizeof(Packet) == 63, "ShopReplacePacket::itemIndex15 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemIndex15), u8>, "ShopReplacePacket::itemIndex15 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemClassification15) - sizeof(Packet) == 64, "ShopReplacePacket::itemClassification15 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemClassification15), u8>, "ShopReplacePacket::itemClassification15 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, gameIndex16) - sizeof(Packet) == 65, "ShopReplacePacket::gameIndex16 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::gameIndex16), u8>, "ShopReplacePacket::gameIndex16 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, playerIndex16) - sizeof(Packet) == 66, "ShopReplacePacket::playerIndex16 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::playerIndex16), u8>, "ShopReplacePacket::playerIndex16 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemIndex16) - sizeof(Packet) == 67, "ShopReplacePacket::itemIndex16 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemIndex16), u8>, "ShopReplacePacket::itemIndex16 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemClassification16) - sizeof(Packet) == 68, "ShopReplacePacket::itemClassification16 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemClassification16), u8>, "ShopReplacePacket::itemClassification16 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, gameIndex17) - sizeof(Packet) == 69, "ShopReplacePacket::gameIndex17 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::gameIndex17), u8>, "ShopReplacePacket::gameIndex17 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, playerIndex17) - sizeof(Packet) == 70, "ShopReplacePacket::playerIndex17 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::playerIndex17), u8>, "ShopReplacePacket::playerIndex17 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemIndex17) - sizeof(Packet) == 71, "ShopReplacePacket::itemIndex17 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemIndex17), u8>, "ShopReplacePacket::itemIndex17 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemClassification17) - sizeof(Packet) == 72, "ShopReplacePacket::itemClassification17 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemClassification17), u8>, "ShopReplacePacket::itemClassification17 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, gameIndex18) - sizeof(Packet) == 73, "ShopReplacePacket::gameIndex18 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::gameIndex18), u8>, "ShopReplacePacket::gameIndex18 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, playerIndex18) - sizeof(Packet) == 74, "ShopReplacePacket::playerIndex18 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::playerIndex18), u8>, "ShopReplacePacket::playerIndex18 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemIndex18) - sizeof(Packet) == 75, "ShopReplacePacket::itemIndex18 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemIndex18), u8>, "ShopReplacePacket::itemIndex18 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemClassification18) - sizeof(Packet) == 76, "ShopReplacePacket::itemClassification18 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemClassification18), u8>, "ShopReplacePacket::itemClassification18 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, gameIndex19) - sizeof(Packet) == 77, "ShopReplacePacket::gameIndex19 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::gameIndex19), u8>, "ShopReplacePacket::gameIndex19 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, playerIndex19) - sizeof(Packet) == 78, "ShopReplacePacket::playerIndex19 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::playerIndex19), u8>, "ShopReplacePacket::playerIndex19 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemIndex19) - sizeof(Packet) == 79, "ShopReplacePacket::itemIndex19 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemIndex19), u8>, "ShopReplacePacket::itemIndex19 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemClassification19) - sizeof(Packet) == 80, "ShopReplacePacket::itemClassification19 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemClassification19), u8>, "ShopReplacePacket::itemClassification19 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, gameIndex20) - sizeof(Packet) == 81, "ShopReplacePacket::gameIndex20 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::gameIndex20), u8>, "ShopReplacePacket::gameIndex20 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, playerIndex20) - sizeof(Packet) == 82, "ShopReplacePacket::playerIndex20 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::playerIndex20), u8>, "ShopReplacePacket::playerIndex20 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemIndex20) - sizeof(Packet) == 83, "ShopReplacePacket::itemIndex20 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemIndex20), u8>, "ShopReplacePacket::itemIndex20 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemClassification20) - sizeof(Packet) == 84, "ShopReplacePacket::itemClassification20 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemClassification20), u8>, "ShopReplacePacket::itemClassification20 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, gameIndex21) - sizeof(Packet) == 85, "ShopReplacePacket::gameIndex21 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::gameIndex21), u8>, "ShopReplacePacket::gameIndex21 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, playerIndex21) - sizeof(Packet) == 86, "ShopReplacePacket::playerIndex21 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::playerIndex21), u8>, "ShopReplacePacket::playerIndex21 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemIndex21) - sizeof(Packet) == 87, "ShopReplacePacket::itemIndex21 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemIndex21), u8>, "ShopReplacePacket::itemIndex21 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemClassification21) - sizeof(Packet) == 88, "ShopReplacePacket::itemClassification21 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemClassification21), u8>, "ShopReplacePacket::itemClassification21 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, gameIndex22) - sizeof(Packet) == 89, "ShopReplacePacket::gameIndex22 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::gameIndex22), u8>, "ShopReplacePacket::gameIndex22 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, playerIndex22) - sizeof(Packet) == 90, "ShopReplacePacket::playerIndex22 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::playerIndex22), u8>, "ShopReplacePacket::playerIndex22 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemIndex22) - sizeof(Packet) == 91, "ShopReplacePacket::itemIndex22 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemIndex22), u8>, "ShopReplacePacket::itemIndex22 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemClassification22) - sizeof(Packet) == 92, "ShopReplacePacket::itemClassification22 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemClassification22), u8>, "ShopReplacePacket::itemClassification22 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, gameIndex23) - sizeof(Packet) == 93, "ShopReplacePacket::gameIndex23 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::gameIndex23), u8>, "ShopReplacePacket::gameIndex23 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, playerIndex23) - sizeof(Packet) == 94, "ShopReplacePacket::playerIndex23 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::playerIndex23), u8>, "ShopReplacePacket::playerIndex23 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemIndex23) - sizeof(Packet) == 95, "ShopReplacePacket::itemIndex23 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemIndex23), u8>, "ShopReplacePacket::itemIndex23 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemClassification23) - sizeof(Packet) == 96, "ShopReplacePacket::itemClassification23 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemClassification23), u8>, "ShopReplacePacket::itemClassification23 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, gameIndex24) - sizeof(Packet) == 97, "ShopReplacePacket::gameIndex24 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::gameIndex24), u8>, "ShopReplacePacket::gameIndex24 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, playerIndex24) - sizeof(Packet) == 98, "ShopReplacePacket::playerIndex24 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::playerIndex24), u8>, "ShopReplacePacket::playerIndex24 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemIndex24) - sizeof(Packet) == 99, "ShopReplacePacket::itemIndex24 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemIndex24), u8>, "ShopReplacePacket::itemIndex24 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemClassification24) - sizeof(Packet) == 100, "ShopReplacePacket::itemClassification24 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemClassification24), u8>, "ShopReplacePacket::itemClassification24 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, gameIndex25) - sizeof(Packet) == 101, "ShopReplacePacket::gameIndex25 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::gameIndex25), u8>, "ShopReplacePacket::gameIndex25 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, playerIndex25) - sizeof(Packet) == 102, "ShopReplacePacket::playerIndex25 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::playerIndex25), u8>, "ShopReplacePacket::playerIndex25 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemIndex25) - sizeof(Packet) == 103, "ShopReplacePacket::itemIndex25 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemIndex25), u8>, "ShopReplacePacket::itemIndex25 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemClassification25) - sizeof(Packet) == 104, "ShopReplacePacket::itemClassification25 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemClassification25), u8>, "ShopReplacePacket::itemClassification25 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, gameIndex26) - sizeof(Packet) == 105, "ShopReplacePacket::gameIndex26 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::gameIndex26), u8>, "ShopReplacePacket::gameIndex26 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, playerIndex26) - sizeof(Packet) == 106, "ShopReplacePacket::playerIndex26 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::playerIndex26), u8>, "ShopReplacePacket::playerIndex26 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemIndex26) - sizeof(Packet) == 107, "ShopReplacePacket::itemIndex26 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemIndex26), u8>, "ShopReplacePacket::itemIndex26 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemClassification26) - sizeof(Packet) == 108, "ShopReplacePacket::itemClassification26 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemClassification26), u8>, "ShopReplacePacket::itemClassification26 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, gameIndex27) - sizeof(Packet) == 109, "ShopReplacePacket::gameIndex27 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::gameIndex27), u8>, "ShopReplacePacket::gameIndex27 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, playerIndex27) - sizeof(Packet) == 110, "ShopReplacePacket::playerIndex27 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::playerIndex27), u8>, "ShopReplacePacket::playerIndex27 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemIndex27) - sizeof(Packet) == 111, "ShopReplacePacket::itemIndex27 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemIndex27), u8>, "ShopReplacePacket::itemIndex27 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemClassification27) - sizeof(Packet) == 112, "ShopReplacePacket::itemClassification27 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemClassification27), u8>, "ShopReplacePacket::itemClassification27 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, gameIndex28) - sizeof(Packet) == 113, "ShopReplacePacket::gameIndex28 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::gameIndex28), u8>, "ShopReplacePacket::gameIndex28 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, playerIndex28) - sizeof(Packet) == 114, "ShopReplacePacket::playerIndex28 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::playerIndex28), u8>, "ShopReplacePacket::playerIndex28 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemIndex28) - sizeof(Packet) == 115, "ShopReplacePacket::itemIndex28 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemIndex28), u8>, "ShopReplacePacket::itemIndex28 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemClassification28) - sizeof(Packet) == 116, "ShopReplacePacket::itemClassification28 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemClassification28), u8>, "ShopReplacePacket::itemClassification28 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, gameIndex29) - sizeof(Packet) == 117, "ShopReplacePacket::gameIndex29 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::gameIndex29), u8>, "ShopReplacePacket::gameIndex29 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, playerIndex29) - sizeof(Packet) == 118, "ShopReplacePacket::playerIndex29 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::playerIndex29), u8>, "ShopReplacePacket::playerIndex29 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemIndex29) - sizeof(Packet) == 119, "ShopReplacePacket::itemIndex29 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemIndex29), u8>, "ShopReplacePacket::itemIndex29 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemClassification29) - sizeof(Packet) == 120, "ShopReplacePacket::itemClassification29 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemClassification29), u8>, "ShopReplacePacket::itemClassification29 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, gameIndex30) - sizeof(Packet) == 121, "ShopReplacePacket::gameIndex30 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::gameIndex30), u8>, "ShopReplacePacket::gameIndex30 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, playerIndex30) - sizeof(Packet) == 122, "ShopReplacePacket::playerIndex30 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::playerIndex30), u8>, "ShopReplacePacket::playerIndex30 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemIndex30) - sizeof(Packet) == 123, "ShopReplacePacket::itemIndex30 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemIndex30), u8>, "ShopReplacePacket::itemIndex30 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemClassification30) - sizeof(Packet) == 124, "ShopReplacePacket::itemClassification30 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemClassification30), u8>, "ShopReplacePacket::itemClassification30 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, gameIndex31) - sizeof(Packet) == 125, "ShopReplacePacket::gameIndex31 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::gameIndex31), u8>, "ShopReplacePacket::gameIndex31 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, playerIndex31) - sizeof(Packet) == 126, "ShopReplacePacket::playerIndex31 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::playerIndex31), u8>, "ShopReplacePacket::playerIndex31 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemIndex31) - sizeof(Packet) == 127, "ShopReplacePacket::itemIndex31 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemIndex31), u8>, "ShopReplacePacket::itemIndex31 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemClassification31) - sizeof(Packet) == 128, "ShopReplacePacket::itemClassification31 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemClassification31), u8>, "ShopReplacePacket::itemClassification31 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, gameIndex32) - sizeof(Packet) == 129, "ShopReplacePacket::gameIndex32 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::gameIndex32), u8>, "ShopReplacePacket::gameIndex32 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, playerIndex32) - sizeof(Packet) == 130, "ShopReplacePacket::playerIndex32 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::playerIndex32), u8>, "ShopReplacePacket::playerIndex32 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemIndex32) - sizeof(Packet) == 131, "ShopReplacePacket::itemIndex32 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemIndex32), u8>, "ShopReplacePacket::itemIndex32 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemClassification32) - sizeof(Packet) == 132, "ShopReplacePacket::itemClassification32 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemClassification32), u8>, "ShopReplacePacket::itemClassification32 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, gameIndex33) - sizeof(Packet) == 133, "ShopReplacePacket::gameIndex33 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::gameIndex33), u8>, "ShopReplacePacket::gameIndex33 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, playerIndex33) - sizeof(Packet) == 134, "ShopReplacePacket::playerIndex33 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::playerIndex33), u8>, "ShopReplacePacket::playerIndex33 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemIndex33) - sizeof(Packet) == 135, "ShopReplacePacket::itemIndex33 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemIndex33), u8>, "ShopReplacePacket::itemIndex33 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemClassification33) - sizeof(Packet) == 136, "ShopReplacePacket::itemClassification33 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemClassification33), u8>, "ShopReplacePacket::itemClassification33 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, gameIndex34) - sizeof(Packet) == 137, "ShopReplacePacket::gameIndex34 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::gameIndex34), u8>, "ShopReplacePacket::gameIndex34 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, playerIndex34) - sizeof(Packet) == 138, "ShopReplacePacket::playerIndex34 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::playerIndex34), u8>, "ShopReplacePacket::playerIndex34 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemIndex34) - sizeof(Packet) == 139, "ShopReplacePacket::itemIndex34 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemIndex34), u8>, "ShopReplacePacket::itemIndex34 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemClassification34) - sizeof(Packet) == 140, "ShopReplacePacket::itemClassification34 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemClassification34), u8>, "ShopReplacePacket::itemClassification34 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, gameIndex35) - sizeof(Packet) == 141, "ShopReplacePacket::gameIndex35 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::gameIndex35), u8>, "ShopReplacePacket::gameIndex35 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, playerIndex35) - sizeof(Packet) == 142, "ShopReplacePacket::playerIndex35 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::playerIndex35), u8>, "ShopReplacePacket::playerIndex35 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemIndex35) - sizeof(Packet) == 143, "ShopReplacePacket::itemIndex35 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemIndex35), u8>, "ShopReplacePacket::itemIndex35 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemClassification35) - sizeof(Packet) == 144, "ShopReplacePacket::itemClassification35 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemClassification35), u8>, "ShopReplacePacket::itemClassification35 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, gameIndex36) - sizeof(Packet) == 145, "ShopReplacePacket::gameIndex36 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::gameIndex36), u8>, "ShopReplacePacket::gameIndex36 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, playerIndex36) - sizeof(Packet) == 146, "ShopReplacePacket::playerIndex36 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::playerIndex36), u8>, "ShopReplacePacket::playerIndex36 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemIndex36) - sizeof(Packet) == 147, "ShopReplacePacket::itemIndex36 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemIndex36), u8>, "ShopReplacePacket::itemIndex36 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemClassification36) - sizeof(Packet) == 148, "ShopReplacePacket::itemClassification36 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemClassification36), u8>, "ShopReplacePacket::itemClassification36 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, gameIndex37) - sizeof(Packet) == 149, "ShopReplacePacket::gameIndex37 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::gameIndex37), u8>, "ShopReplacePacket::gameIndex37 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, playerIndex37) - sizeof(Packet) == 150, "ShopReplacePacket::playerIndex37 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::playerIndex37), u8>, "ShopReplacePacket::playerIndex37 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemIndex37) - sizeof(Packet) == 151, "ShopReplacePacket::itemIndex37 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemIndex37), u8>, "ShopReplacePacket::itemIndex37 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemClassification37) - sizeof(Packet) == 152, "ShopReplacePacket::itemClassification37 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemClassification37), u8>, "ShopReplacePacket::itemClassification37 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, gameIndex38) - sizeof(Packet) == 153, "ShopReplacePacket::gameIndex38 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::gameIndex38), u8>, "ShopReplacePacket::gameIndex38 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, playerIndex38) - sizeof(Packet) == 154, "ShopReplacePacket::playerIndex38 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::playerIndex38), u8>, "ShopReplacePacket::playerIndex38 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemIndex38) - sizeof(Packet) == 155, "ShopReplacePacket::itemIndex38 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemIndex38), u8>, "ShopReplacePacket::itemIndex38 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemClassification38) - sizeof(Packet) == 156, "ShopReplacePacket::itemClassification38 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemClassification38), u8>, "ShopReplacePacket::itemClassification38 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, gameIndex39) - sizeof(Packet) == 157, "ShopReplacePacket::gameIndex39 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::gameIndex39), u8>, "ShopReplacePacket::gameIndex39 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, playerIndex39) - sizeof(Packet) == 158, "ShopReplacePacket::playerIndex39 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::playerIndex39), u8>, "ShopReplacePacket::playerIndex39 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemIndex39) - sizeof(Packet) == 159, "ShopReplacePacket::itemIndex39 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemIndex39), u8>, "ShopReplacePacket::itemIndex39 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemClassification39) - sizeof(Packet) == 160, "ShopReplacePacket::itemClassification39 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemClassification39), u8>, "ShopReplacePacket::itemClassification39 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, gameIndex40) - sizeof(Packet) == 161, "ShopReplacePacket::gameIndex40 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::gameIndex40), u8>, "ShopReplacePacket::gameIndex40 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, playerIndex40) - sizeof(Packet) == 162, "ShopReplacePacket::playerIndex40 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::playerIndex40), u8>, "ShopReplacePacket::playerIndex40 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemIndex40) - sizeof(Packet) == 163, "ShopReplacePacket::itemIndex40 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemIndex40), u8>, "ShopReplacePacket::itemIndex40 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemClassification40) - sizeof(Packet) == 164, "ShopReplacePacket::itemClassification40 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemClassification40), u8>, "ShopReplacePacket::itemClassification40 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, gameIndex41) - sizeof(Packet) == 165, "ShopReplacePacket::gameIndex41 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::gameIndex41), u8>, "ShopReplacePacket::gameIndex41 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, playerIndex41) - sizeof(Packet) == 166, "ShopReplacePacket::playerIndex41 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::playerIndex41), u8>, "ShopReplacePacket::playerIndex41 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemIndex41) - sizeof(Packet) == 167, "ShopReplacePacket::itemIndex41 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemIndex41), u8>, "ShopReplacePacket::itemIndex41 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemClassification41) - sizeof(Packet) == 168, "ShopReplacePacket::itemClassification41 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemClassification41), u8>, "ShopReplacePacket::itemClassification41 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, gameIndex42) - sizeof(Packet) == 169, "ShopReplacePacket::gameIndex42 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::gameIndex42), u8>, "ShopReplacePacket::gameIndex42 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, playerIndex42) - sizeof(Packet) == 170, "ShopReplacePacket::playerIndex42 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::playerIndex42), u8>, "ShopReplacePacket::playerIndex42 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemIndex42) - sizeof(Packet) == 171, "ShopReplacePacket::itemIndex42 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemIndex42), u8>, "ShopReplacePacket::itemIndex42 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemClassification42) - sizeof(Packet) == 172, "ShopReplacePacket::itemClassification42 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemClassification42), u8>, "ShopReplacePacket::itemClassification42 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, gameIndex43) - sizeof(Packet) == 173, "ShopReplacePacket::gameIndex43 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::gameIndex43), u8>, "ShopReplacePacket::gameIndex43 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, playerIndex43) - sizeof(Packet) == 174, "ShopReplacePacket::playerIndex43 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::playerIndex43), u8>, "ShopReplacePacket::playerIndex43 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemIndex43) - sizeof(Packet) == 175, "ShopReplacePacket::itemIndex43 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemIndex43), u8>, "ShopReplacePacket::itemIndex43 type doesn't match packets.schema");
+static_assert(offsetof(ShopReplacePacket, itemClassification43) - sizeof(Packet) == 176, "ShopReplacePacket::itemClassification43 offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShopReplacePacket::itemClassification43), u8>, "ShopReplacePacket::itemClassification43 type doesn't match packets.schema");
+
+// Deathlink
+static_assert(sizeof(Deathlink) - sizeof(Packet) == 0, "Deathlink size doesn't match packets.schema");
+
+// PlayerDC
+static_assert(sizeof(PlayerDC) - sizeof(Packet) == 0, "PlayerDC size doesn't match packets.schema");
+
+// PingPacket
+static_assert(sizeof(PingPacket) - sizeof(Packet) == 12, "PingPacket size doesn't match packets.schema");
+static_assert(offsetof(PingPacket, timestamp) - sizeof(Packet) == 0, "PingPacket::timestamp offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(PingPacket::timestamp), u64>, "PingPacket::timestamp type doesn't match packets.schema");
+static_assert(offsetof(PingPacket, sequence) - sizeof(Packet) == 8, "PingPacket::sequence offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(PingPacket::sequence), u32>, "PingPacket::sequence type doesn't match packets.schema");
+
+// ShineChecks
+static_assert(offsetof(ShineChecks, entries) - sizeof(Packet) == 2, "ShineChecks size doesn't match packets.schema");
+static_assert(offsetof(ShineChecks, count) - sizeof(Packet) == 0, "ShineChecks::count offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShineChecks::count), u16>, "ShineChecks::count type doesn't match packets.schema");
+static_assert(std::is_same_v<std::remove_extent_t<decltype(ShineChecks::entries)>, s16>, "ShineChecks::entries type doesn't match packets.schema");
+static_assert(offsetof(ShineChecks, entries) + sizeof(ShineChecks::entries) == sizeof(ShineChecks), "ShineChecks::entries isn't the last member");
+
+// ShineColorEntry
+static_assert(sizeof(ShineColorEntry) == 3, "ShineColorEntry size doesn't match packets.schema");
+static_assert(offsetof(ShineColorEntry, shineUid) == 0, "ShineColorEntry::shineUid offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShineColorEntry::shineUid), s16>, "ShineColorEntry::shineUid type doesn't match packets.schema");
+static_assert(offsetof(ShineColorEntry, color) == 2, "ShineColorEntry::color offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShineColorEntry::color), s8>, "ShineColorEntry::color type doesn't match packets.schema");
+
+// ShineReplaceEntry
+static_assert(sizeof(ShineReplaceEntry) == 2, "ShineReplaceEntry size doesn't match packets.schema");
+static_assert(offsetof(ShineReplaceEntry, itemType) == 0, "ShineReplaceEntry::itemType offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShineReplaceEntry::itemType), s8>, "ShineReplaceEntry::itemType type doesn't match packets.schema");
+static_assert(offsetof(ShineReplaceEntry, itemNameIndex) == 1, "ShineReplaceEntry::itemNameIndex offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShineReplaceEntry::itemNameIndex), u8>, "ShineReplaceEntry::itemNameIndex type doesn't match packets.schema");
+
+// ShineColor
+static_assert(offsetof(ShineColor, entries) - sizeof(Packet) == 2, "ShineColor size doesn't match packets.schema");
+static_assert(offsetof(ShineColor, count) - sizeof(Packet) == 0, "ShineColor::count offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShineColor::count), u16>, "ShineColor::count type doesn't match packets.schema");
+static_assert(std::is_same_v<std::remove_extent_t<decltype(ShineColor::entries)>, ShineColorEntry>, "ShineColor::entries type doesn't match packets.schema");
+static_assert(offsetof(ShineColor, entries) + sizeof(ShineColor::entries) == sizeof(ShineColor), "ShineColor::entries isn't the last member");
+
+// ShineReplacePacket
+static_assert(offsetof(ShineReplacePacket, entries) - sizeof(Packet) == 2, "ShineReplacePacket size doesn't match packets.schema");
+static_assert(offsetof(ShineReplacePacket, count) - sizeof(Packet) == 0, "ShineReplacePacket::count offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShineReplacePacket::count), u16>, "ShineReplacePacket::count type doesn't match packets.schema");
+static_assert(std::is_same_v<std::remove_extent_t<decltype(ShineReplacePacket::entries)>, ShineReplaceEntry>, "ShineReplacePacket::entries type doesn't match packets.schema");
+static_assert(offsetof(ShineReplacePacket, entries) + sizeof(ShineReplacePacket::entries) == sizeof(ShineReplacePacket), "ShineReplacePacket::entries isn't the last member");
+
+// SlotBundle
+static_assert(offsetof(SlotBundle, data) - sizeof(Packet) == 4, "SlotBundle size doesn't match packets.schema");
+static_assert(offsetof(SlotBundle, version) - sizeof(Packet) == 0, "SlotBundle::version offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(SlotBundle::version), u8>, "SlotBundle::version type doesn't match packets.schema");
+static_assert(offsetof(SlotBundle, encoding) - sizeof(Packet) == 1, "SlotBundle::encoding offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(SlotBundle::encoding), u8>, "SlotBundle::encoding type doesn't match packets.schema");
+static_assert(offsetof(SlotBundle, rawSize) - sizeof(Packet) == 2, "SlotBundle::rawSize offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(SlotBundle::rawSize), u16>, "SlotBundle::rawSize type doesn't match packets.schema");
+static_assert(std::is_same_v<std::remove_extent_t<decltype(SlotBundle::data)>, u8>, "SlotBundle::data type doesn't match packets.schema");
+static_assert(offsetof(SlotBundle, data) + sizeof(SlotBundle::data) == sizeof(SlotBundle), "SlotBundle::data isn't the last member");
+
+// ShineBitmap
+static_assert(offsetof(ShineBitmap, data) - sizeof(Packet) == 2, "ShineBitmap size doesn't match packets.schema");
+static_assert(offsetof(ShineBitmap, encoding) - sizeof(Packet) == 0, "ShineBitmap::encoding offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShineBitmap::encoding), u8>, "ShineBitmap::encoding type doesn't match packets.schema");
+static_assert(offsetof(ShineBitmap, wordCount) - sizeof(Packet) == 1, "ShineBitmap::wordCount offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(ShineBitmap::wordCount), u8>, "ShineBitmap::wordCount type doesn't match packets.schema");
+static_assert(std::is_same_v<std::remove_extent_t<decltype(ShineBitmap::data)>, u8>, "ShineBitmap::data type doesn't match packets.schema");
+static_assert(offsetof(ShineBitmap, data) + sizeof(ShineBitmap::data) == sizeof(ShineBitmap), "ShineBitmap::data isn't the last member");
+
+// FragmentPacket
+static_assert(offsetof(FragmentPacket, data) - sizeof(Packet) == 8, "FragmentPacket size doesn't match packets.schema");
+static_assert(offsetof(FragmentPacket, messageId) - sizeof(Packet) == 0, "FragmentPacket::messageId offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(FragmentPacket::messageId), u16>, "FragmentPacket::messageId type doesn't match packets.schema");
+static_assert(offsetof(FragmentPacket, fragmentIndex) - sizeof(Packet) == 2, "FragmentPacket::fragmentIndex offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(FragmentPacket::fragmentIndex), u16>, "FragmentPacket::fragmentIndex type doesn't match packets.schema");
+static_assert(offsetof(FragmentPacket, totalLength) - sizeof(Packet) == 4, "FragmentPacket::totalLength offset doesn't match packets.schema");
+static_assert(std::is_same_v<decltype(FragmentPacket::totalLength), u32>, "FragmentPacket::totalLength type doesn't match packets.schema");
+static_assert(std::is_same_v<std::remove_extent_t<decltype(FragmentPacket::data)>, u8>, "FragmentPacket::data type doesn't match packets.schema");
+static_assert(offsetof(FragmentPacket, data) + sizeof(FragmentPacket::data) == sizeof(FragmentPacket), "FragmentPacket::data isn't the last member");
@@ -0,0 +1,10 @@
+#pragma once
+
+#include "Packet.h"
+
+// used for both PING and PONG, a PONG echoes the PING it answers untouched
+struct PACKED PingPacket : Packet {
+    PingPacket() : Packet() {this->mType = PacketType::PING; mPacketSize = sizeof(PingPacket) - sizeof(Packet);};
+    u64 timestamp = 0; // senders clock, only ever compared by the side that sent the PING
+    u32 sequence = 0;
+};
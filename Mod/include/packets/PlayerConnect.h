@@ -1,7 +1,9 @@
 #pragma once
 
 #include "Packet.h"
+#include "SlotBundle.h"
 
+#include <cstddef>
 #include <cstdint>
 
 struct PACKED PlayerConnect : Packet {
@@ -9,4 +11,9 @@ struct PACKED PlayerConnect : Packet {
     ConnectionTypes conType;
     u16 maxPlayerCount = USHRT_MAX;
     char clientName[COSTUMEBUFSIZE] = {};
+    u32 slotTableHashes[SLOTTABLECOUNT] = {}; // see Client::getSlotTableHash, lets the connector skip tables we already hold
+    u8 sessionId = NOSESSION; // set by the server on the other players it announces, ours goes out as NOSESSION
+
+    // servers from before session ids send a shorter packet
+    u8 getSessionId() const { return mPacketSize > (short)(offsetof(PlayerConnect, sessionId) - sizeof(Packet)) ? sessionId : NOSESSION; }
 };
\ No newline at end of file
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Packet.h"
+
+// fields carried by a PlayerInfDelta, the rest are the same as in the keyframe it references
+enum PlayerInfField : u8 {
+    POSITION = 1 << 0,
+    ROTATION = 1 << 1,
+    BLENDWEIGHTS = 1 << 2,
+    ANIMS = 1 << 3,
+};
+
+// largest payload, a keyframe with every field set
+#define PLAYERINFDELTADATASIZE (sizeof(sead::Vector3f) + sizeof(u32) + 6 + sizeof(s16) * 2)
+
+// quantized PlayerInf, used for both PLAYERINFKEY and PLAYERINFDELTA
+// a PLAYERINFKEY holds every field with an absolute position, a PLAYERINFDELTA holds only the fields that differ
+// from the keyframe with the same id, its position as a fixed point offset from the keyframe's
+struct PACKED PlayerInfDelta : Packet {
+    PlayerInfDelta() : Packet() {mType = PacketType::PLAYERINFDELTA; mPacketSize = 2;};
+    u8 keyframeId = 0;
+    u8 fieldMask = 0; // PlayerInfField
+    u8 data[PLAYERINFDELTADATASIZE] = {}; // set fields back to back in PlayerInfField order, mPacketSize only covers the ones used
+};
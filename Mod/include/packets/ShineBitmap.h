@@ -0,0 +1,20 @@
+#pragma once
+
+#include "Packet.h"
+#include "SlotBundle.h"
+
+#define SHINEBITMAPWORDS 37 // size of Client::collectedShines, enough for every shine uid
+#define SHINEBITMAPSIZE (SHINEBITMAPWORDS * sizeof(u32))
+#define SHINEBITMAPHEADERSIZE 2
+#define SHINEBITMAPDATASIZE (MAXPACKSIZE - sizeof(Packet) - SHINEBITMAPHEADERSIZE)
+
+// every collected shine as one bitmap, bit uid % 32 of little endian word uid / 32. Sent both ways on connect so
+// either side only catches up on the shines it is missing instead of replaying every uid
+struct PACKED ShineBitmap : Packet {
+    ShineBitmap() : Packet() {mType = PacketType::SHINEBITMAP; mPacketSize = SHINEBITMAPHEADERSIZE;};
+    u8 encoding = ENCODING_RAW; // BundleEncoding, the connector run length encodes it when that comes out smaller
+    u8 wordCount = SHINEBITMAPWORDS; // words once decoded
+    u8 data[SHINEBITMAPDATASIZE] = {}; // mPacketSize only covers the bytes used
+};
+
+static_assert(SHINEBITMAPSIZE <= SHINEBITMAPDATASIZE, "a raw shine bitmap must fit in one packet");
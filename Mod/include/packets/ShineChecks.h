@@ -1,110 +1,6 @@
 #pragma once
 
-#include "Packet.h"
+#include "ArrayPacket.h"
 
-struct PACKED ShineChecks : Packet {
-    ShineChecks() : Packet() {
-        this->mType = PacketType::SHINECHECKS;
-        mPacketSize = sizeof(ShineChecks) - sizeof(Packet);
-    };
-    short shineUid0;
-    short shineUid1;
-    short shineUid2;
-    short shineUid3;
-    short shineUid4;
-    short shineUid5;
-    short shineUid6;
-    short shineUid7;
-    short shineUid8;
-    short shineUid9;
-    short shineUid10;
-    short shineUid11;
-    short shineUid12;
-    short shineUid13;
-    short shineUid14;
-    short shineUid15;
-    short shineUid16;
-    short shineUid17;
-    short shineUid18;
-    short shineUid19;
-    short shineUid20;
-    short shineUid21;
-    short shineUid22;
-    short shineUid23;
-    short shineUid24;
-    short shineUid25;
-    short shineUid26;
-    short shineUid27;
-    short shineUid28;
-    short shineUid29;
-    short shineUid30;
-    short shineUid31;
-    short shineUid32;
-    short shineUid33;
-    short shineUid34;
-    short shineUid35;
-    short shineUid36;
-    short shineUid37;
-    short shineUid38;
-    short shineUid39;
-    short shineUid40;
-    short shineUid41;
-    short shineUid42;
-    short shineUid43;
-    short shineUid44;
-    short shineUid45;
-    short shineUid46;
-    short shineUid47;
-    short shineUid48;
-    short shineUid49;
-    short shineUid50;
-    short shineUid51;
-    short shineUid52;
-    short shineUid53;
-    short shineUid54;
-    short shineUid55;
-    short shineUid56;
-    short shineUid57;
-    short shineUid58;
-    short shineUid59;
-    short shineUid60;
-    short shineUid61;
-    short shineUid62;
-    short shineUid63;
-    short shineUid64;
-    short shineUid65;
-    short shineUid66;
-    short shineUid67;
-    short shineUid68;
-    short shineUid69;
-    short shineUid70;
-    short shineUid71;
-    short shineUid72;
-    short shineUid73;
-    short shineUid74;
-    short shineUid75;
-    short shineUid76;
-    short shineUid77;
-    short shineUid78;
-    short shineUid79;
-    short shineUid80;
-    short shineUid81;
-    short shineUid82;
-    short shineUid83;
-    short shineUid84;
-    short shineUid85;
-    short shineUid86;
-    short shineUid87;
-    short shineUid88;
-    short shineUid89;
-    short shineUid90;
-    short shineUid91;
-    short shineUid92;
-    short shineUid93;
-    short shineUid94;
-    short shineUid95;
-    short shineUid96;
-    short shineUid97;
-    short shineUid98;
-    short shineUid99;
-};
\ No newline at end of file
+// shine uids the connector has already seen collected, sent on connect so the save catches up
+struct PACKED ShineChecks : ArrayPacket<PacketType::SHINECHECKS, s16> {};
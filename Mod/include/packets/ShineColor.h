@@ -1,178 +1,10 @@
 #pragma once
 
-#include "Packet.h"
+#include "ArrayPacket.h"
 
-struct PACKED ShineColor : Packet {
-    ShineColor() : Packet() {
-        this->mType = PacketType::SHINECOLOR;
-        mPacketSize = sizeof(ShineColor) - sizeof(Packet);
-    };
-    short shineUid0;
-    s8 color0;
-    short shineUid1;
-    s8 color1;
-    short shineUid2;
-    s8 color2;
-    short shineUid3;
-    s8 color3;
-    short shineUid4;
-    s8 color4;
-    short shineUid5;
-    s8 color5;
-    short shineUid6;
-    s8 color6;
-    short shineUid7;
-    s8 color7;
-    short shineUid8;
-    s8 color8;
-    short shineUid9;
-    s8 color9;
-    short shineUid10;
-    s8 color10;
-    short shineUid11;
-    s8 color11;
-    short shineUid12;
-    s8 color12;
-    short shineUid13;
-    s8 color13;
-    short shineUid14;
-    s8 color14;
-    short shineUid15;
-    s8 color15;
-    short shineUid16;
-    s8 color16;
-    short shineUid17;
-    s8 color17;
-    short shineUid18;
-    s8 color18;
-    short shineUid19;
-    s8 color19;
-    short shineUid20;
-    s8 color20;
-    short shineUid21;
-    s8 color21;
-    short shineUid22;
-    s8 color22;
-    short shineUid23;
-    s8 color23;
-    short shineUid24;
-    s8 color24;
-    short shineUid25;
-    s8 color25;
-    short shineUid26;
-    s8 color26;
-    short shineUid27;
-    s8 color27;
-    short shineUid28;
-    s8 color28;
-    short shineUid29;
-    s8 color29;
-    short shineUid30;
-    s8 color30;
-    short shineUid31;
-    s8 color31;
-    short shineUid32;
-    s8 color32;
-    short shineUid33;
-    s8 color33;
-    short shineUid34;
-    s8 color34;
-    short shineUid35;
-    s8 color35;
-    short shineUid36;
-    s8 color36;
-    short shineUid37;
-    s8 color37;
-    short shineUid38;
-    s8 color38;
-    short shineUid39;
-    s8 color39;
-    short shineUid40;
-    s8 color40;
-    short shineUid41;
-    s8 color41;
-    short shineUid42;
-    s8 color42;
-    short shineUid43;
-    s8 color43;
-    short shineUid44;
-    s8 color44;
-    short shineUid45;
-    s8 color45;
-    short shineUid46;
-    s8 color46;
-    short shineUid47;
-    s8 color47;
-    short shineUid48;
-    s8 color48;
-    short shineUid49;
-    s8 color49;
-    short shineUid50;
-    s8 color50;
-    /*short shineUid51;
-    u8 color51;
-    short shineUid52;
-    u8 color52;
-    short shineUid53;
-    u8 color53;
-    short shineUid54;
-    u8 color54;
-    short shineUid55;
-    u8 color55;
-    short shineUid56;
-    u8 color56;
-    short shineUid57;
-    u8 color57;
-    short shineUid58;
-    u8 color58;
-    short shineUid59;
-    u8 color59;
-    short shineUid60;
-    u8 color60;
-    short shineUid61;
-    u8 color61;
-    short shineUid62;
-    u8 color62;
-    short shineUid63;
-    u8 color63;
-    short shineUid64;
-    u8 color64;
-    short shineUid65;
-    u8 color65;
-    short shineUid66;
-    u8 color66;
-    short shineUid67;
-    u8 color67;
-    short shineUid68;
-    u8 color68;
-    short shineUid69;
-    u8 color69;
-    short shineUid70;
-    u8 color70;
-    short shineUid71;
-    u8 color71;
-    short shineUid72;
-    u8 color72;
-    short shineUid73;
-    u8 color73;
-    short shineUid74;
-    u8 color74;
-    short shineUid75;
-    u8 color75;
-    short shineUid76;
-    u8 color76;
-    short shineUid77;
-    u8 color77;
-    short shineUid78;
-    u8 color78;
-    short shineUid79;
-    u8 color79;
-    short shineUid80;
-    u8 color80;
-    short shineUid81;
-    u8 color81;
-    short shineUid82;
-    u8 color82;
-    short shineUid83;
-    u8 color83;*/
-};
\ No newline at end of file
+struct PACKED ShineColorEntry {
+    s16 shineUid;
+    s8 color;
+};
+
+struct PACKED ShineColor : ArrayPacket<PacketType::SHINECOLOR, ShineColorEntry> {};
@@ -1,211 +1,11 @@
 #pragma once
 
-#include "Packet.h"
+#include "ArrayPacket.h"
 
-struct PACKED ShineReplacePacket : Packet {
-    ShineReplacePacket() : Packet() {
-        this->mType = PacketType::SHINEREPLACE;
-        mPacketSize = sizeof(ShineReplacePacket) - sizeof(Packet);
-    };
-    s8 itemType0;
-    u8 itemNameIndex0;
-    s8 itemType1;
-    u8 itemNameIndex1;
-    s8 itemType2;
-    u8 itemNameIndex2;
-    s8 itemType3;
-    u8 itemNameIndex3;
-    s8 itemType4;
-    u8 itemNameIndex4;
-    s8 itemType5;
-    u8 itemNameIndex5;
-    s8 itemType6;
-    u8 itemNameIndex6;
-    s8 itemType7;
-    u8 itemNameIndex7;
-    s8 itemType8;
-    u8 itemNameIndex8;
-    s8 itemType9;
-    u8 itemNameIndex9;
-    s8 itemType10;
-    u8 itemNameIndex10;
-    s8 itemType11;
-    u8 itemNameIndex11;
-    s8 itemType12;
-    u8 itemNameIndex12;
-    s8 itemType13;
-    u8 itemNameIndex13;
-    s8 itemType14;
-    u8 itemNameIndex14;
-    s8 itemType15;
-    u8 itemNameIndex15;
-    s8 itemType16;
-    u8 itemNameIndex16;
-    s8 itemType17;
-    u8 itemNameIndex17;
-    s8 itemType18;
-    u8 itemNameIndex18;
-    s8 itemType19;
-    u8 itemNameIndex19;
-    s8 itemType20;
-    u8 itemNameIndex20;
-    s8 itemType21;
-    u8 itemNameIndex21;
-    s8 itemType22;
-    u8 itemNameIndex22;
-    s8 itemType23;
-    u8 itemNameIndex23;
-    s8 itemType24;
-    u8 itemNameIndex24;
-    s8 itemType25;
-    u8 itemNameIndex25;
-    s8 itemType26;
-    u8 itemNameIndex26;
-    s8 itemType27;
-    u8 itemNameIndex27;
-    s8 itemType28;
-    u8 itemNameIndex28;
-    s8 itemType29;
-    u8 itemNameIndex29;
-    s8 itemType30;
-    u8 itemNameIndex30;
-    s8 itemType31;
-    u8 itemNameIndex31;
-    s8 itemType32;
-    u8 itemNameIndex32;
-    s8 itemType33;
-    u8 itemNameIndex33;
-    s8 itemType34;
-    u8 itemNameIndex34;
-    s8 itemType35;
-    u8 itemNameIndex35;
-    s8 itemType36;
-    u8 itemNameIndex36;
-    s8 itemType37;
-    u8 itemNameIndex37;
-    s8 itemType38;
-    u8 itemNameIndex38;
-    s8 itemType39;
-    u8 itemNameIndex39;
-    s8 itemType40;
-    u8 itemNameIndex40;
-    s8 itemType41;
-    u8 itemNameIndex41;
-    s8 itemType42;
-    u8 itemNameIndex42;
-    s8 itemType43;
-    u8 itemNameIndex43;
-    s8 itemType44;
-    u8 itemNameIndex44;
-    s8 itemType45;
-    u8 itemNameIndex45;
-    s8 itemType46;
-    u8 itemNameIndex46;
-    s8 itemType47;
-    u8 itemNameIndex47;
-    s8 itemType48;
-    u8 itemNameIndex48;
-    s8 itemType49;
-    u8 itemNameIndex49;
-    s8 itemType50;
-    u8 itemNameIndex50;
-    s8 itemType51;
-    u8 itemNameIndex51;
-    s8 itemType52;
-    u8 itemNameIndex52;
-    s8 itemType53;
-    u8 itemNameIndex53;
-    s8 itemType54;
-    u8 itemNameIndex54;
-    s8 itemType55;
-    u8 itemNameIndex55;
-    s8 itemType56;
-    u8 itemNameIndex56;
-    s8 itemType57;
-    u8 itemNameIndex57;
-    s8 itemType58;
-    u8 itemNameIndex58;
-    s8 itemType59;
-    u8 itemNameIndex59;
-    s8 itemType60;
-    u8 itemNameIndex60;
-    s8 itemType61;
-    u8 itemNameIndex61;
-    s8 itemType62;
-    u8 itemNameIndex62;
-    s8 itemType63;
-    u8 itemNameIndex63;
-    s8 itemType64;
-    u8 itemNameIndex64;
-    s8 itemType65;
-    u8 itemNameIndex65;
-    s8 itemType66;
-    u8 itemNameIndex66;
-    s8 itemType67;
-    u8 itemNameIndex67;
-    s8 itemType68;
-    u8 itemNameIndex68;
-    s8 itemType69;
-    u8 itemNameIndex69;
-    s8 itemType70;
-    u8 itemNameIndex70;
-    s8 itemType71;
-    u8 itemNameIndex71;
-    s8 itemType72;
-    u8 itemNameIndex72;
-    s8 itemType73;
-    u8 itemNameIndex73;
-    s8 itemType74;
-    u8 itemNameIndex74;
-    s8 itemType75;
-    u8 itemNameIndex75;
-    s8 itemType76;
-    u8 itemNameIndex76;
-    s8 itemType77;
-    u8 itemNameIndex77;
-    s8 itemType78;
-    u8 itemNameIndex78;
-    s8 itemType79;
-    u8 itemNameIndex79;
-    s8 itemType80;
-    u8 itemNameIndex80;
-    s8 itemType81;
-    u8 itemNameIndex81;
-    s8 itemType82;
-    u8 itemNameIndex82;
-    s8 itemType83;
-    u8 itemNameIndex83;
-    s8 itemType84;
-    u8 itemNameIndex84;
-    s8 itemType85;
-    u8 itemNameIndex85;
-    s8 itemType86;
-    u8 itemNameIndex86;
-    s8 itemType87;
-    u8 itemNameIndex87;
-    s8 itemType88;
-    u8 itemNameIndex88;
-    s8 itemType89;
-    u8 itemNameIndex89;
-    s8 itemType90;
-    u8 itemNameIndex90;
-    s8 itemType91;
-    u8 itemNameIndex91;
-    s8 itemType92;
-    u8 itemNameIndex92;
-    s8 itemType93;
-    u8 itemNameIndex93;
-    s8 itemType94;
-    u8 itemNameIndex94;
-    s8 itemType95;
-    u8 itemNameIndex95;
-    s8 itemType96;
-    u8 itemNameIndex96;
-    s8 itemType97;
-    u8 itemNameIndex97;
-    s8 itemType98;
-    u8 itemNameIndex98;
-    s8 itemType99;
-    u8 itemNameIndex99;
-    
-};
\ No newline at end of file
+struct PACKED ShineReplaceEntry {
+    s8 itemType;
+    u8 itemNameIndex;
+};
+
+// replacement text for the shines of the current kingdom, entry i replaces shineTextReplacements[i]
+struct PACKED ShineReplacePacket : ArrayPacket<PacketType::SHINEREPLACE, ShineReplaceEntry> {};
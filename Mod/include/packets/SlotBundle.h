@@ -0,0 +1,33 @@
+#pragma once
+
+#include "Packet.h"
+
+#define SLOTBUNDLEVERSION 2 // bumped whenever the layout read by Client::updateSlotBundle changes
+#define SLOTBUNDLEHEADERSIZE 4
+#define SLOTBUNDLEDATASIZE (MAXMESSAGESIZE - sizeof(Packet) - SLOTBUNDLEHEADERSIZE)
+
+enum BundleEncoding : u8 {
+    ENCODING_RAW,
+    ENCODING_RLE, // see BundleReader
+};
+
+// tables a bundle can carry, a bundle only holds the ones that changed since the last PlayerConnect
+enum SlotTable : u8 {
+    TABLE_OPTIONS, // world pay counts and option flags
+    TABLE_SHINECOLORS,
+    TABLE_SHOP, // shop*TextReplacements
+    TABLE_GAMENAMES,
+    TABLE_SLOTNAMES,
+    TABLE_ITEMNAMES,
+    TABLE_SHINETEXT, // shineTextReplacements and shineItemNames of the current kingdom
+    SLOTTABLECOUNT
+};
+
+// slot data tables sent by the connector, large enough that it usually arrives as FRAGMENTs
+struct PACKED SlotBundle : Packet {
+    SlotBundle() : Packet() {mType = PacketType::SLOTBUNDLE; mPacketSize = SLOTBUNDLEHEADERSIZE;};
+    u8 version = SLOTBUNDLEVERSION;
+    u8 encoding = ENCODING_RAW; // BundleEncoding
+    u16 rawSize = 0; // size of data once decoded
+    u8 data[SLOTBUNDLEDATASIZE] = {}; // mPacketSize only covers the bytes used
+};
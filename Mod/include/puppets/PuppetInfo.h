@@ -2,6 +2,7 @@
 
 #include "algorithms/PlayerAnims.h"
 #include "packets/Packet.h"
+#include "server/PlayerInfCodec.hpp"
 
 #include "al/LiveActor/LiveActor.h"
 
@@ -15,9 +16,11 @@ struct PuppetInfo {
     char puppetName[0x10] = {}; // max user account name size is 10 chars, so this could go down to 0xB
     bool isConnected = false;
     nn::account::Uid playerID;
+    u8 sessionId = NOSESSION; // Client::mSessionPuppets index, NOSESSION if the server didn't give one
     // Puppet Translation Info
     sead::Vector3f playerPos = sead::Vector3f(0.f,0.f,0.f);
     sead::Quatf playerRot = sead::Quatf(0.f,0.f,0.f,0.f);
+    PlayerInfKeyframe playerKeyframe; // base for this puppet's PlayerInfDelta packets
     // Puppet Stage Info
     u8 scenarioNo = -1;
     char stageName[0x40] = {};
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "types.h"
+
+/**
+ * @brief fixed size set of bits stored as little endian u32 words, bit i is bit i % 32 of word i / 32
+ *
+ * Every operation is a shift and a mask, indices outside of [0, N) are ignored by set and reset and never test as set,
+ * so a failed lookup returning -1 can be passed straight in.
+ *
+ * @tparam N amount of bits
+ */
+template <u32 N>
+class Bitset {
+    static_assert(N > 0, "Bitset needs at least one bit");
+
+    public:
+        static constexpr u32 sWordCount = (N + 31) / 32;
+
+        static constexpr bool isInRange(int index) { return index >= 0 && (u32)index < N; }
+        static constexpr u32 size() { return N; }
+
+        constexpr void set(int index) {
+            if (isInRange(index))
+                mWords[index >> 5] |= 1u << (index & 31);
+        }
+
+        constexpr void reset(int index) {
+            if (isInRange(index))
+                mWords[index >> 5] &= ~(1u << (index & 31));
+        }
+
+        constexpr bool test(int index) const {
+            return isInRange(index) && (mWords[index >> 5] >> (index & 31)) & 1;
+        }
+
+        constexpr void clear() {
+            for (u32 i = 0; i < sWordCount; i++)
+                mWords[i] = 0;
+        }
+
+        // ORs another set into this one
+        constexpr void merge(const Bitset& other) {
+            for (u32 i = 0; i < sWordCount; i++)
+                mWords[i] |= other.mWords[i];
+        }
+
+        // ORs one word of an external bitmap in the same layout into this one, bits past N are dropped
+        constexpr void mergeWord(u32 wordIndex, u32 word) {
+            if (wordIndex < sWordCount)
+                mWords[wordIndex] |= word & getWordMask(wordIndex);
+        }
+
+        constexpr u32 count() const {
+            u32 result = 0;
+            for (u32 i = 0; i < sWordCount; i++)
+                result += __builtin_popcount(mWords[i]);
+            return result;
+        }
+
+        // calls func(int index) for every set bit in ascending order
+        template <typename Func>
+        constexpr void forEach(Func func) const {
+            for (u32 i = 0; i < sWordCount; i++) {
+                for (u32 word = mWords[i]; word != 0; word &= word - 1)
+                    func((int)(i * 32 + __builtin_ctz(word)));
+            }
+        }
+
+        constexpr u32 getWord(u32 wordIndex) const { return wordIndex < sWordCount ? mWords[wordIndex] : 0; }
+        const u32* getWords() const { return mWords; }
+
+    private:
+        static constexpr u32 getWordMask(u32 wordIndex) {
+            return wordIndex + 1 < sWordCount || N % 32 == 0 ? ~0u : (1u << (N % 32)) - 1;
+        }
+
+        u32 mWords[sWordCount] = {};
+};
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "types.h"
+
+/**
+ * @brief reads bundle data front to back, expanding run length encoding on the fly so it never needs a buffer of its own
+ *
+ * RLE data is a sequence of runs, each starting with a control byte c:
+ *   c <  0x80  c + 1 literal bytes follow
+ *   c >= 0x80  the next byte is repeated c - 0x7D times (3 to 130)
+ */
+class BundleReader {
+    public:
+        BundleReader(const u8* data, u32 size, bool isRle);
+
+        // false once the data runs out or turns out to be malformed, every read after that fails as well
+        bool read(void* out, u32 size);
+        bool skip(u32 size);
+
+        template <typename T>
+        bool read(T* out) {
+            return read(out, sizeof(T));
+        }
+
+        // reads a u8 byte length followed by that much UTF-8, converted to at most maxLength - 1 UTF-16 units plus a terminator
+        bool readString(char16_t* out, u32 maxLength);
+        // same as above but keeps the string as UTF-8, dropping a character that doesn't fit whole
+        bool readString(char* out, u32 maxLength);
+
+        bool isFailed() const { return mIsFailed; }
+        u32 getReadCount() const { return mReadCount; }
+
+    private:
+        bool readByte(u8* out);
+
+        const u8* mData = nullptr;
+        u32 mSize = 0;
+        u32 mOffset = 0;
+        u32 mReadCount = 0; // decoded bytes handed out so far
+        bool mIsRle = false;
+        bool mIsFailed = false;
+
+        // state of the current RLE run
+        u32 mRunLeft = 0;
+        bool mIsRepeatRun = false;
+        u8 mRepeatValue = 0;
+};
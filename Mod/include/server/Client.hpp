@@ -57,6 +57,10 @@
 
 #include "logger.hpp"
 #include "server/SocketClient.hpp"
+#include "server/PlayerInfCodec.hpp"
+#include "server/SendRateScheduler.hpp"
+#include "server/BundleReader.hpp"
+#include "server/Bitset.hpp"
 #include "helpers.hpp"
 #include "puppets/HackModelHolder.hpp"
 #include "puppets/PuppetHolder.hpp"
@@ -66,16 +70,37 @@
 
 #include "puppets/PuppetInfo.h"
 
+#include <atomic>
 #include <cstddef>
 #include <stdlib.h>
 
 #define MAXPUPINDEX 32
 
+#define SENDBATCHCOUNT 16 // most packets the send thread puts into one TCP frame
+#define SENDFLUSHDEADLINE 1000 // us the send thread waits for the rest of a frame's packets, well under one game frame
+
 struct UIDIndexNode {
     nn::account::Uid uid;
     int puppetIndex;
 };
 
+// size of GameDataFile::mShineHintList
+#define SHINEHINTCOUNT 0x400
+
+// cap, cloth, sticker, gift and moon shop items, in the order of the shop text replacement arrays
+#define SHOPITEMCOUNT (44 + 44 + 17 + 26 + 13)
+// longest name (an ap item name) plus the longest explain (two ap names and the fixed text) of one item, nul terminated
+#define SHOPITEMTEXTSIZE (40 + 168)
+#define SHOPTEXTSIZE 200
+
+static_assert(SHOPITEMCOUNT * SHOPITEMTEXTSIZE <= 0x10000, "shop text offsets are u16");
+
+// what a shine in the current stage resolved to, cached by its index in the hint list
+struct stageShineInfo {
+    s16 shineUid;  // -1 until resolved, 0 for a hint art moon without a known hint art
+    s16 textIndex; // index into shineTextReplacements, -1 if there's no replacement text
+};
+
 class HideAndSeekIcon;
 
 class Client {
@@ -108,6 +133,10 @@ class Client {
         static void sendCaptureInfPacket(const PlayerActorHakoniwa *player);
         void resendInitPackets();
 
+        static void setSendRate(float hz);
+        static float getPlayerSendHz() { return sInstance ? sInstance->mPlayerSendRate.getCurrentHz() : 0.f; }
+        static float getTargetSendHz() { return sInstance ? sInstance->mPlayerSendRate.getTargetHz() : 0.f; }
+
         int getCollectedShinesCount() { return curCollectedShines.size(); }
         int getShineID(int index) { if (index < curCollectedShines.size()) { return curCollectedShines[index]; } return -1; }
 
@@ -159,31 +188,23 @@ class Client {
 
         static void addShine(int uid);
         static bool hasShine(int uid);
-        static int getShineChecks(int index);
-        static void setShineChecks(int index, int checks);
+        static void writeShineBitmap(ShineBitmap* packet);
+        static void clearCollected();
 
         static void addOutfit(const ShopItem::ItemInfo* info);
         static bool hasOutfit(const ShopItem::ItemInfo* info);
-        static int getOutfitChecks(int index);
-        static void setOutfitChecks(int index, int checks);
 
         static void addSticker(const ShopItem::ItemInfo* info);
         static bool hasSticker(const ShopItem::ItemInfo* info);
-        static int getStickerChecks(int index);
-        static void setStickerChecks(int index, int checks);
 
         static void addSouvenir(const ShopItem::ItemInfo* info);
         static bool hasSouvenir(const ShopItem::ItemInfo* info);
-        static int getSouvenirChecks(int index);
-        static void setSouvenirChecks(int index, int checks);
 
         static bool hasItem(const ShopItem::ItemInfo* info);
         static void addItem(const ShopItem::ItemInfo* info);
 
         static void addCapture(const char* capture);
         static bool hasCapture(const char* capture);
-        static int getCaptureChecks(int index);
-        static void setCaptureChecks(int index, int checks);
         static void addCaptureCheck(const char* capture);
         static bool hasCaptureCheck(const char* capture);
 
@@ -200,6 +221,9 @@ class Client {
         
         static sead::FixedSafeString<0x20> getUsername() { return sInstance ? sInstance->mUsername : sead::FixedSafeString<0x20>::cEmptyString;}
 
+        // hash the connector gave each slot table we hold, 0 for tables we never received
+        static u32 getSlotTableHash(SlotTable table) { return sInstance ? sInstance->mSlotTableHashes[table] : 0; }
+
         static sead::FixedSafeString<0x4B> getAPChatMessage1() { return sInstance ? sInstance->apChatLine1 : sead::FixedSafeString<0x20>::cEmptyString;}
         static sead::FixedSafeString<0x4B> getAPChatMessage2() { return sInstance ? sInstance->apChatLine2 : sead::FixedSafeString<0x20>::cEmptyString;}
         static sead::FixedSafeString<0x4B> getAPChatMessage3() { return sInstance ? sInstance->apChatLine3 : sead::FixedSafeString<0x20>::cEmptyString;}
@@ -210,6 +234,7 @@ class Client {
         static bool getRegionalsFlag() { return sInstance ? sInstance->regionals : false; }
         static bool getCapturesFlag() { return sInstance ? sInstance->captures : false; }
 
+        static int getShineUid(Shine* curShine);
         static const char* getShineReplacementText();
         static int getShineColor(Shine* curShine);
         static const char16_t* getShopReplacementText(const char* fileName, const char* key);
@@ -253,17 +278,28 @@ class Client {
         SocketClient *mSocket;
 
     private:
-        void updatePlayerInfo(PlayerInf *packet);
+        void updatePlayerInfo(PlayerInf *packet, PuppetInfo* curInfo = nullptr);
+        void updatePlayerInfDelta(PlayerInfDelta *packet);
+        bool isSendBacklogged(PacketType type);
         void updateHackCapInfo(HackCapInf *packet);
         void updateGameInfo(GameInf *packet);
         void updateCostumeInfo(CostumeInf *packet);
         void updateChatMessages(ArchipelagoChatMessage *packet);
         void addApInfo(ApInfo *packet);
         void updateSentShines(ShineChecks* packet);
+        void updateShineBitmap(ShineBitmap* packet);
         void updateShineReplace(ShineReplacePacket *packet);
         void updateShineColor(ShineColor* packet);
         void updateShopReplace(ShopReplacePacket *packet);
         void updateSlotData(SlotData* packet);
+        void updateSlotBundle(SlotBundle* packet);
+        bool readSlotTable(BundleReader& reader, SlotTable table);
+
+        int findShopItemIndex(const char* fileName, const char* itemName) const;
+        const shopReplaceText& getShopItem(int shopItemIndex) const;
+        void renderShopText(sead::WFixedSafeString<SHOPTEXTSIZE>& message, const shopReplaceText& item, bool isExplain) const;
+        void rebuildShopText();
+
         void updateWorlds(UnlockWorld *packet);
         void receiveCheck(Check* packet);
         void receiveDeath(Deathlink *packet);
@@ -273,9 +309,15 @@ class Client {
         void sendToStage(ChangeStagePacket* packet);
         void sendUdpHolePunch();
         void sendUdpInit();
+        void sendPongPacket(const PingPacket* ping);
         void disconnectPlayer(PlayerDC *packet);
 
         PuppetInfo* findPuppetInfo(const nn::account::Uid& id, bool isFindAvailable);
+        PuppetInfo* findPuppetInfo(const Packet* packet);
+
+        void resolveHintArts(GameDataHolderAccessor accessor);
+        const hintArtInfo* findHintArt(Shine* curShine) const;
+        stageShineInfo findStageShineInfo(Shine* curShine);
 
         bool startConnection();
 
@@ -314,21 +356,28 @@ class Client {
         bool apDeath = false;
         int checkIndex = 0;
 
-        // List of 37 ints to track which shine's have been grabbed
-        sead::SafeArray<int, 37> collectedShines;
+        // which shines have been grabbed, by shine uid. Sent to the connector as is in a SHINEBITMAP
+        Bitset<SHINEBITMAPWORDS * 32> collectedShines;
 
-        // List of 11 u8s for tracking which caps and clothes have been grabbed
-        sead::SafeArray<u8, 11> collectedOutfits;
+        // which caps and clothes have been grabbed, by costume list index + 44 for caps
+        Bitset<88> collectedOutfits;
 
-        // List of 3 u8s for tracking which stickers have been grabbed
-        sead::SafeArray<u8, 3> collectedStickers;
+        // which stickers have been grabbed
+        Bitset<24> collectedStickers;
 
-        // List of 4 u8s for tracking which souvenirs have been grabbed
-        sead::SafeArray<u8, 4> collectedSouvenirs;
+        // which souvenirs have been grabbed
+        Bitset<32> collectedSouvenirs;
         
-        // List of 7 u8s for tracking which captures have been grabbed
-        sead::SafeArray<u8, 7> collectedCaptures;
-        sead::SafeArray<u8, 7> checkedCaptures;
+        // which captures have been grabbed, and which ones have already been sent as checks
+        Bitset<56> collectedCaptures;
+        Bitset<56> checkedCaptures;
+
+        // worldHintArts with the Dark Side entry resolved for the current main stage, refreshed on every stage load
+        hintArtInfo mHintArts[WORLDCOUNT] = {};
+
+        // uid and label of every shine looked up since the stage loaded, by shine index. Colors and labels are still
+        // read by uid from shineColors and shineTextReplacements, so their packets never invalidate this.
+        stageShineInfo mStageShines[SHINEHINTCOUNT];
 
         // Moon Text Replacement Handling
         Shine* recentShine = nullptr;
@@ -351,9 +400,23 @@ class Client {
         int numApGames = 0;
         int numApSlots = 0;
         int numApItems = 0;
+        u32 mSlotTableHashes[SLOTTABLECOUNT] = {};
+
+        // name and explain text of every shop item rendered back to back, the name of item i starts at
+        // mShopTextOffsets[2 * i] and its explain at mShopTextOffsets[2 * i + 1]. Set dirty from the read thread
+        // whenever the data above changes, and rendered again on the main thread by the next lookup. Allocated
+        // from mHeap once in the constructor so a rebuild never allocates.
+        char16 *mShopText = nullptr;
+        u16 mShopTextOffsets[SHOPITEMCOUNT * 2] = {};
+        std::atomic<bool> mIsShopTextDirty = true;
 
         // Backups for our last player/game packets, used for example to re-send them for newly connected clients
         PlayerInf lastPlayerInfPacket = PlayerInf();
+        PlayerInfCodec mPlayerInfCodec;
+
+        // decide when player and cap updates are worth sending
+        SendRateScheduler mPlayerSendRate = SendRateScheduler(PLAYERSENDHZ, PLAYERPOSERRORBOUND);
+        SendRateScheduler mCapSendRate = SendRateScheduler(PLAYERSENDHZ, CAPPOSERRORBOUND);
         GameInf lastGameInfPacket = GameInf();
         GameInf emptyGameInfPacket = GameInf();
         CostumeInf lastCostumeInfPacket = CostumeInf();
@@ -401,6 +464,7 @@ class Client {
         int maxPuppets = 9;  // default max player count is 10, so default max puppets will be 9
         
         PuppetInfo *mPuppetInfoArr[MAXPUPINDEX] = {};
+        PuppetInfo *mSessionPuppets[MAXSESSIONCOUNT] = {}; // by the session id the server announced each player with
 
         PuppetHolder *mPuppetHolder = nullptr;
 
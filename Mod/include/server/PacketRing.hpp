@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+
+#include "types.h"
+
+/**
+ * @brief bounded lock-free single producer/single consumer ring
+ *
+ * @tparam T element type, kept small (packet pointers or pool slot indices)
+ * @tparam Capacity max amount of elements held at once, must be a power of two
+ */
+template <typename T, u32 Capacity>
+class PacketRing {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "PacketRing capacity must be a power of two");
+
+    public:
+        /**
+         * @brief pushes a value onto the ring, must only be called from the producer thread
+         * @return false if the ring was full and the value was not added
+         */
+        bool push(T value) {
+            u32 tail = mTail.load(std::memory_order_relaxed);
+
+            if (tail - mHead.load(std::memory_order_acquire) >= Capacity) {
+                mDropCount.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+
+            mItems[tail & (Capacity - 1)] = value;
+            mTail.store(tail + 1, std::memory_order_release);
+
+            return true;
+        }
+
+        /**
+         * @brief pops the oldest value off the ring, must only be called from the consumer thread
+         * @return false if the ring was empty
+         */
+        bool pop(T* out) {
+            u32 head = mHead.load(std::memory_order_relaxed);
+
+            if (head == mTail.load(std::memory_order_acquire)) {
+                return false;
+            }
+
+            *out = mItems[head & (Capacity - 1)];
+            mHead.store(head + 1, std::memory_order_release);
+
+            return true;
+        }
+
+        u32 getCount() const { return mTail.load(std::memory_order_acquire) - mHead.load(std::memory_order_acquire); }
+        u32 getMaxCount() const { return Capacity; }
+        bool isFull() const { return getCount() >= Capacity; }
+        bool isEmpty() const { return getCount() == 0; }
+
+        // amount of pushes rejected because the ring was full
+        u32 getDropCount() const { return mDropCount.load(std::memory_order_relaxed); }
+        void addDrop() { mDropCount.fetch_add(1, std::memory_order_relaxed); }
+
+    private:
+        T mItems[Capacity] = {};
+
+        // head and tail are free running counters, only masked when indexing
+        alignas(64) std::atomic<u32> mHead = 0;
+        alignas(64) std::atomic<u32> mTail = 0;
+
+        std::atomic<u32> mDropCount = 0;
+};
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <atomic>
+
+#include "packets/Packet.h"
+
+#define KEYFRAMEINTERVAL 20 // encodes between keyframes, bounds how long a lost keyframe stalls a puppet's position
+#define POSDELTASCALE 8.f   // fixed point steps per unit for positions relative to a keyframe
+
+/**
+ * @brief PlayerInf with every field quantized the way PlayerInfDelta carries it
+ */
+struct PlayerInfState {
+    sead::Vector3f pos = sead::Vector3f(0.f, 0.f, 0.f);
+    u32 rot = 0; // smallest three, 0 if the rotation was never set
+    u8 blendWeights[6] = {};
+    PlayerAnims::Type actName = PlayerAnims::Type::Unknown;
+    PlayerAnims::Type subActName = PlayerAnims::Type::Unknown;
+
+    void set(const PlayerInf& info);
+    void apply(PlayerInf* info) const;
+};
+
+/**
+ * @brief last keyframe received from a puppet, deltas referencing any other keyframe are dropped
+ */
+struct PlayerInfKeyframe {
+    PlayerInfState state;
+    u8 id = 0;
+    bool isValid = false;
+};
+
+/**
+ * @brief turns PlayerInf updates into PLAYERINFKEY/PLAYERINFDELTA packets and back
+ *
+ * Deltas only ever reference the latest keyframe and not the previous delta, so any of them can be lost or
+ * coalesced away on the send queue without the puppet drifting.
+ */
+class PlayerInfCodec {
+    public:
+        /**
+         * @brief quantizes info into out, as a keyframe every KEYFRAMEINTERVAL encodes or when the position moved out of delta range
+         * @return false if out is the same as the last packet and doesn't need to be sent
+         */
+        bool encode(const PlayerInf& info, PlayerInfDelta* out);
+
+        // makes the next encode a keyframe, for when a player joins and has nothing to apply deltas to
+        void requestKeyframe() { mIsKeyframeNeeded = true; }
+
+        /**
+         * @brief applies a received packet on top of the sender's keyframe
+         * @return false if the packet references a keyframe that never arrived or is malformed
+         */
+        static bool decode(const PlayerInfDelta* packet, PlayerInfKeyframe* keyframe, PlayerInf* out);
+
+        static u32 packQuat(const sead::Quatf& quat);
+        static void unpackQuat(u32 packed, sead::Quatf* out);
+
+    private:
+        bool tryWriteDelta(const PlayerInfState& state, PlayerInfDelta* out);
+        void writeKeyframe(const PlayerInfState& state, PlayerInfDelta* out);
+
+        PlayerInfState mKeyframe;
+        u8 mKeyframeId = 0;
+        int mEncodesSinceKeyframe = 0;
+        std::atomic<bool> mIsKeyframeNeeded = true; // set from the socket threads
+
+        // payload of the last packet, to skip deltas that would be repeats
+        u8 mLastFieldMask = 0;
+        u8 mLastData[PLAYERINFDELTADATASIZE] = {};
+        int mLastDataSize = 0;
+};
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "sead/math/seadVector.h"
+#include "types.h"
+
+#define PLAYERSENDHZ 30.f        // default most player/cap updates sent per second
+#define MAXPLAYERSENDHZ 60.f     // one update per game frame
+#define SENDRATESTEP 5.f         // change of the target rate per step in the debug menu
+#define IDLESENDHZ 2.f           // rate movement within the error bound is still sent at
+#define PLAYERPOSERRORBOUND 12.f // units a puppet may trail behind before an update is due
+#define CAPPOSERRORBOUND 25.f    // the cap moves fast and is small, so it can trail further
+#define MAXSENDBACKOFF 8.f       // most the send interval stretches while the send queue is behind
+#define PLAYERROTERROR 0.0003f   // 1 - |dot| between rotations, ~3 degrees
+#define PLAYERWEIGHTERROR 0.02f  // blend weight change that's worth an update
+
+/**
+ * @brief decides each frame whether a realtime stream (player, cap) should send an update
+ *
+ * Puppets smooth towards the last position they received, so the error receivers see is how far the sender has
+ * moved since its last update. Fast movement crosses the error bound every frame and sends at the target rate,
+ * slow movement only sends once it's drifted far enough, and standing still sends nothing. Every time an update is
+ * due while the previous one is still waiting in the send queue the interval doubles, and it recovers as updates
+ * go out again.
+ */
+class SendRateScheduler {
+    public:
+        SendRateScheduler(float targetHz, float errorBound) : mTargetHz(targetHz), mErrorBound(errorBound) {}
+
+        /**
+         * @param pos position receivers are smoothing towards
+         * @param isStateChanged whether something receivers can't smooth over changed, e.g. animation or visibility
+         * @param isBacklogged whether the last update is still waiting to be sent
+         * @return true if an update should be sent now, which is then treated as sent
+         */
+        bool update(const sead::Vector3f& pos, bool isStateChanged, bool isBacklogged);
+
+        // false while the current send interval is running, so callers can skip gathering an update that can't be sent
+        bool isIntervalElapsed() const;
+
+        // makes the next due update go out without waiting for the interval
+        void reset() { mHasSent = false; }
+
+        void setTargetHz(float hz) { mTargetHz = hz > 1.f ? hz : 1.f; }
+        float getTargetHz() const { return mTargetHz; }
+        float getCurrentHz() const { return mTargetHz / mBackoff; }
+
+    private:
+        float mTargetHz;
+        float mErrorBound;
+        float mBackoff = 1.f;
+
+        sead::Vector3f mLastPos = sead::Vector3f(0.f, 0.f, 0.f);
+        u64 mLastSendTick = 0;
+        bool mHasSent = false;
+};
@@ -14,19 +14,50 @@
 
 #include "syssocket/sockdefines.h"
 
-#include "thread/seadMessageQueue.h"
-#include "thread/seadMutex.h"
+#include "nn/os.h"
 #include "types.h"
 
 #include "packets/Packet.h"
+#include "server/PacketRing.hpp"
+
+#define MAXSENDFRAMESIZE (MAXPACKSIZE * 0x10) // largest amount of data the send thread will coalesce into one Send call
+#define RECVSTREAMSIZE (MAXPACKSIZE * 0x10) // size of the buffer tcp data is streamed into before being split into packets
+#define SENDQUEUESIZE 128 // must be a power of two
+#define RECVQUEUESIZE 128 // must be a power of two
+#define MESSAGESLOTCOUNT 2 // reassembled FRAGMENT messages that can be held at once, must be a power of two
+#define MESSAGESLOTFLAG 0x8000 // marks recv queue entries that point into the message pool instead of the packet pool
+#define LATESTSLOTCOUNT 3 // amount of packet types that only ever keep their newest queued packet (see getLatestSlotIndex)
+
+#define RECONNECTBASEDELAY 250 // ms waited before the first reconnect attempt, doubled for every failed attempt after that
+#define RECONNECTMAXDELAY 10000 // ms
+#define MAXCACHEDADDRFAILS 3 // failed attempts in a row before the server hostname is resolved again
+#define PINGINTERVAL 1000 // ms between heartbeat pings
+#define DEADPEERTIMEOUT 5000 // ms without any data before a server that answers pings is considered gone
 
 class Client;
 
+enum ConnectionState : u8 {
+    CONN_DISCONNECTED,
+    CONN_RESOLVING,
+    CONN_CONNECTING,
+    CONN_HANDSHAKE,
+    CONN_CONNECTED
+};
+
+// send lanes in the order the send thread drains them
+enum SendLane : u8 {
+    CRITICAL, // items, deathlinks and anything else a player waits on
+    NORMAL,
+    REALTIME, // lossy movement state, only the newest packet of each type is kept
+    LANECOUNT
+};
+
 class SocketClient : public SocketBase {
     public:
         SocketClient(const char* name, sead::Heap* heap, Client* client);
         nn::Result init(const char* ip, u16 port) override;
-        bool tryReconnect();
+        bool waitForConnection();
+        void requestReconnect();
         bool closeSocket() override;
 
         bool startThreads();
@@ -42,20 +73,42 @@ class SocketClient : public SocketBase {
         void sendFunc();
         void recvFunc();
 
-        Packet *tryGetPacket(sead::MessageQueue::BlockType blockType = sead::MessageQueue::BlockType::Blocking);
+        Packet *tryGetPacket(bool isBlocking = true);
+        void releasePacket(Packet* packet);
 
         void printPacket(Packet* packet);
-        bool isConnected() { return socket_log_state == SOCKET_LOG_CONNECTED; }
+        bool isConnected() { return mConnState == CONN_CONNECTED; }
+        // whether the send thread may write to the sockets, only the handshake's own sends go out before this
+        bool isSendAllowed() const { return mConnState == CONN_CONNECTED && !mIsReconnectNeeded; }
+        ConnectionState getConnState() { return mConnState; }
+        const char* getConnStateChar();
+        int getReconnectAttempts() { return mReconnectAttempts; }
+
+        // smoothed round trip time and jitter to the server in microseconds, rtt is negative until the first PONG arrives
+        s32 getSmoothedRtt() { return mSmoothedRtt.load(std::memory_order_relaxed); }
+        s32 getRttJitter() { return mRttJitter.load(std::memory_order_relaxed); }
 
         u16 getLocalUdpPort();
         s32 setPeerUdpPort(u16 port);
         const char* getUdpStateChar();
 
-        u32 getSendCount() { return mSendQueue.getCount(); }
-        u32 getSendMaxCount() { return mSendQueue.getMaxCount(); }
+        static SendLane getSendLane(PacketType type);
+        static const char* getSendLaneName(SendLane lane);
+
+        u32 getSendCount(SendLane lane);
+        u32 getSendMaxCount(SendLane lane);
+        u32 getSendDropCount(SendLane lane);
+        u32 getSentCount(SendLane lane) { return mSentCounts[lane].load(std::memory_order_relaxed); }
+        u32 getCoalesceCount() { return mCoalesceCount.load(std::memory_order_relaxed); }
+        bool isRealtimePending(PacketType type);
+
+        // session id the server gave the sender of a packet from tryGetPacket, NOSESSION unless it came in on a compact header
+        u8 getPacketSessionId(const Packet* packet);
+        u8 getSessionId() { return mSessionId.load(std::memory_order_relaxed); }
 
         u32 getRecvCount() { return mRecvQueue.getCount(); }
         u32 getRecvMaxCount() { return mRecvQueue.getMaxCount(); }
+        u32 getRecvDropCount() { return mRecvQueue.getDropCount(); }
 
         void clearMessageQueues();
         void setQueueOpen(bool value) { mPacketQueueOpen = value; }
@@ -63,6 +116,18 @@ class SocketClient : public SocketBase {
 
         void setIsFirstConn(bool value) { mIsFirstConnect = value; }
 
+        /**
+         * @brief configures how the send thread batches queued packets into a single frame
+         * 
+         * @param maxBatchCount max amount of packets drained from the send queue per frame
+         * @param flushDeadlineUs how long the send thread waits for more packets once the queue is empty before flushing a
+         * frame, 0 to flush right away. Frames holding a CRITICAL packet never wait
+         */
+        void setSendBatchLimits(int maxBatchCount, s64 flushDeadlineUs) {
+            mMaxBatchCount = maxBatchCount > 0 ? maxBatchCount : 1;
+            mFlushDeadlineUs = flushDeadlineUs > 0 ? flushDeadlineUs : 0;
+        }
+
     private:
         sead::Heap* mHeap = nullptr;
         Client* client = nullptr;
@@ -70,22 +135,117 @@ class SocketClient : public SocketBase {
         al::AsyncFunctorThread* mRecvThread = nullptr;
         al::AsyncFunctorThread* mSendThread = nullptr;
         
-        sead::MessageQueue mRecvQueue;
-        sead::MessageQueue mSendQueue;
+        // filled by the recv thread, drained by the read thread
+        PacketRing<u16, RECVQUEUESIZE> mRecvQueue;
+        nn::os::EventType mRecvEvent;
+        std::atomic<bool> mRecvWake = false;
+
+        // critical and normal lanes, filled by the game, read and socket threads (pushes are serialized by mSendPushLock), drained by the send thread
+        PacketRing<Packet*, SENDQUEUESIZE> mSendQueues[SendLane::REALTIME];
+        nn::os::MutexType mSendPushLock;
+        nn::os::EventType mSendEvent;
+        std::atomic<bool> mSendWake = false;
+
+        // realtime lane, latest-value-wins slots for high frequency state packets so a slow link never queues stale movement
+        std::atomic<Packet*> mLatestPackets[LATESTSLOTCOUNT] = {};
+        std::atomic<u32> mCoalesceCount = 0;
+
+        std::atomic<u32> mSentCounts[SendLane::LANECOUNT] = {};
+
+        // connection state machine, only ever advanced by the recv thread
+        std::atomic<ConnectionState> mConnState = CONN_DISCONNECTED;
+        std::atomic<bool> mIsConnectRequested = false;
+        std::atomic<bool> mIsReconnectNeeded = false;
+        nn::os::EventType mStateEvent; // cuts a backoff wait short
+        nn::os::EventType mConnectedEvent; // signaled while connected, other threads park on it
+        int mReconnectAttempts = 0;
+        bool mIsNifmInitialized = false;
+        bool mIsHostAddressCached = false;
+        in_addr mHostAddress = { 0 };
+
+        // heartbeat, only touched by the recv thread apart from the rtt readouts
+        u64 mLastPingTick = 0;
+        u64 mLastRecvTick = 0;
+        u32 mPingSequence = 0;
+        bool mHasRecvPong = false;
+        std::atomic<s32> mSmoothedRtt = -1;
+        std::atomic<s32> mRttJitter = 0;
+
         char* recvBuf = nullptr;
 
-        int maxBufSize = 100;
+        // fixed pool of MAXPACKSIZE slots backing every packet in mRecvQueue, returned through mFreeRecvSlots by the read thread
+        char* mRecvPool = nullptr;
+        int mRecvPoolSize = 0;
+        PacketRing<u16, RECVQUEUESIZE * 2> mFreeRecvSlots;
+        u8* mRecvSessionIds = nullptr; // session id of the sender of each pool slot, see getPacketSessionId
+
+        // bytes read from the tcp socket that have not been split into packets yet, only ever holds a partial packet between reads
+        char* mRecvStream = nullptr;
+        int mRecvStreamSize = 0;
+
+        // MAXMESSAGESIZE slots FRAGMENTs are reassembled into, handed to the read thread like any other pool slot
+        char* mMessagePool = nullptr;
+        PacketRing<u16, MESSAGESLOTCOUNT> mFreeMessageSlots;
+        // message currently being reassembled, only touched by the recv thread
+        s32 mAssemblySlot = -1; // held until the message is handed off, so a dropped message doesn't leak its slot
+        bool mIsAssembling = false;
+        u16 mAssemblyId = 0;
+        u32 mAssemblyLength = 0;
+        u32 mAssemblyRecvSize = 0;
+
+        u16 mNextMessageId = 0; // send thread only
+
+        char* mSendFrame = nullptr;
+        int mSendFrameSize = 0;
+        Packet* mHeldPacket = nullptr; // send thread only, popped but not sent when the connection dropped
+        SendLane mHeldLane = SendLane::NORMAL;
+        int mMaxBatchCount = 16;
+        s64 mFlushDeadlineUs = 0;
+
         bool mIsFirstConnect = true;
         bool mPacketQueueOpen = true;
         int pollTime = 0;
 
 
-        bool mHasRecvUdp;
-        s32 mUdpSocket;
+        bool mHasRecvUdp = false;
+        s32 mUdpSocket = -1;
         sockaddr mUdpAddress;
 
+        // session ids from the handshake, udp datagrams switch to the CompactPacket header once we have one
+        std::atomic<u8> mSessionId = NOSESSION;
+        nn::account::Uid mSessionUids[MAXSESSIONCOUNT] = {}; // recv thread only, filled from PLAYERCON
+
+        void setConnState(ConnectionState state);
+        void stepConnection();
+        s64 getBackoffDelay();
+        bool tryResolve();
+        bool tryConnect();
+        bool tryHandshake();
+        void onConnectFailed();
+        void disconnect();
+
+        void updateHeartbeat();
+        void onPong(const PingPacket* pong);
+
         bool recvTcp();
         bool recvUdp();
+        bool recvCompact(int valread);
+        bool pushRecvPacket(const char* data, int size, u8 sessionId = NOSESSION);
+        void updateSessions(const Packet* packet);
+        bool pushFragment(const FragmentPacket* fragment);
+        void resetAssembly();
+        void releaseRecvSlot(u16 slot);
+
+        static bool isLoggedPacket(PacketType type);
+        static s32 getLatestSlotIndex(PacketType type);
+        Packet* popSendPacket(SendLane* laneOut);
+        void wakeQueues();
+
+        bool isUdpPacket(Packet* packet);
+        bool sendBuffer(s32 fd, const char* buffer, int size);
+        bool appendToSendFrame(Packet* packet);
+        bool appendFragments(Packet* packet);
+        bool flushSendFrame();
 
         /**
          * @param str a string containing an IPv4 address or a hostname that can be resolved via DNS
@@ -0,0 +1,96 @@
+# checkPackets.py
+# Conformance test for the packet layouts in packets.schema, writes nothing and exits non zero on the first mismatch.
+#   - PacketLayout.h and the connector's PacketCodecs.py are what genPackets.py generates from the schema now
+#   - the game's headers compile against PacketLayout.h, so every struct member matches its schema field
+#   - every connector codec round trips at the schema's offsets
+#
+# usage: python3 scripts/checkPackets.py [--no-compile]
+#   --no-compile  skip the header check, for machines without a C++ compiler. CXX picks the compiler, g++ by default
+
+import os
+import shutil
+import struct
+import subprocess
+import sys
+
+import genPackets
+
+# the parts of the game's build flags the packet headers care about
+CXXFLAGS = ["-std=gnu++20", "-fsyntax-only", "-DNNSDK", "-DSWITCH", "-DEMU=0", "-DSMOVER=100",
+            "-Wno-invalid-offsetof", "-Wno-volatile", "-fno-rtti", "-fno-exceptions", "-w"]
+INCLUDES = ["include", "include/sead"]
+
+
+def check_outputs(outputs):
+    for path, text in outputs.items():
+        with open(path, "r") as f:
+            if f.read() != text:
+                sys.exit("%s is out of date, run make packets" % os.path.relpath(path))
+
+    print("%d generated files up to date" % len(outputs))
+
+
+def check_header():
+    compiler = os.environ.get("CXX", "g++")
+    if not shutil.which(compiler):
+        sys.exit("no C++ compiler %s to check PacketLayout.h with, set CXX or pass --no-compile" % compiler)
+
+    root = os.path.join(genPackets.SCRIPT_DIR, "..")
+    command = [compiler] + CXXFLAGS + ["-I" + os.path.join(root, path) for path in INCLUDES] + ["-x", "c++", "-"]
+    result = subprocess.run(command, input="#include \"packets/Packet.h\"\n", capture_output=True, text=True)
+
+    if result.returncode != 0:
+        errors = [line for line in result.stderr.splitlines() if "error" in line]
+        sys.exit("PacketLayout.h doesn't hold for the game's structs:\n" + "\n".join(errors or [result.stderr]))
+
+    print("PacketLayout.h holds for the game's structs")
+
+
+def sample_value(field, seed):
+    # distinct values near the top of each range so swapped or truncated fields show up
+    seed %= 64
+    if field.type_name == "char":
+        return bytes((seed + i) % 95 + 32 for i in range(field.count))
+    if field.type_name == "bool":
+        return seed % 2 == 0
+    bits = genPackets.TYPES[field.type_name][1] * 8
+    if field.type_name.startswith("s"):
+        value = (1 << (bits - 1)) - 1 - seed
+        return -value if seed % 2 else value
+    return (1 << bits) - 1 - seed
+
+
+def check_codecs(codecs):
+    for codec_name, layout in codecs.items():
+        codec = struct.Struct(layout.get_format())
+        if codec.size != layout.get_size():
+            sys.exit("%s packs to %d bytes instead of %d" % (codec_name, codec.size, layout.get_size()))
+
+        values = []
+        for field in layout.get_fixed_fields():
+            if struct.calcsize("<" + "".join(f.get_format() for f in layout.fields[:layout.fields.index(field)])) != field.offset:
+                sys.exit("%s.%s isn't at offset %d" % (codec_name, field.py_name, field.offset))
+            repeat = 1 if field.type_name == "char" else field.count
+            values += [sample_value(field, len(values)) for _ in range(repeat)]
+
+        # packed at an odd offset into a larger buffer, as Packets.py does right after the header
+        buffer = bytearray(codec.size + 3)
+        codec.pack_into(buffer, 3, *values)
+        unpacked = list(codec.unpack_from(memoryview(buffer), 3))
+        if unpacked != values:
+            sys.exit("%s doesn't round trip: %s != %s" % (codec_name, unpacked, values))
+
+    print("%d codecs round trip" % len(codecs))
+
+
+def main():
+    outputs, codecs = genPackets.generate()
+
+    check_outputs(outputs)
+    if "--no-compile" not in sys.argv:
+        check_header()
+    check_codecs(codecs)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,309 @@
+# genPackets.py
+# Generates the packet layout checks for the game and the packet codecs for the connector from packets.schema.
+#
+# usage: python3 scripts/genPackets.py   regenerate both files
+# scripts/checkPackets.py checks them against the schema without writing anything.
+
+import os
+import re
+import sys
+
+SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
+SCHEMA_PATH = os.path.join(SCRIPT_DIR, "packets.schema")
+HEADER_PATH = os.path.join(SCRIPT_DIR, "..", "include", "packets", "PacketLayout.h")
+CODECS_PATH = os.path.join(SCRIPT_DIR, "..", "..", "World", "smo", "Connector", "PacketCodecs.py")
+
+PACKET_HEADER_SIZE = 20
+
+# type -> (struct format char, size, C++ type)
+TYPES = {
+    "u8": ("B", 1, "u8"),
+    "s8": ("b", 1, "s8"),
+    "u16": ("H", 2, "u16"),
+    "s16": ("h", 2, "s16"),
+    "u32": ("I", 4, "u32"),
+    "s32": ("i", 4, "s32"),
+    "u64": ("Q", 8, "u64"),
+    "bool": ("?", 1, "bool"),
+    "char": ("s", 1, "char"),
+}
+
+FIELD_PATTERN = re.compile(r"^(\w+)(?:\[(\w*)\])?(?:=([\w:]+))?$")
+
+
+class Field:
+    def __init__(self, type_name, cpp_type, count, cpp_name, py_name, is_tail):
+        self.type_name = type_name
+        self.cpp_type = cpp_type
+        self.count = count
+        self.cpp_name = cpp_name
+        self.py_name = py_name
+        self.is_tail = is_tail
+        self.offset = 0
+        self.is_cpp_type_set = False  # an enum or struct of the same size instead of the plain type
+        self.group = None  # line of the repeat block it came from, the codec sees the whole block as one field
+
+    def get_format(self):
+        char = TYPES[self.type_name][0]
+        if self.type_name == "char":
+            return "%ds" % self.count
+        return char if self.count == 1 else "%d%s" % (self.count, char)
+
+    def get_size(self):
+        return TYPES[self.type_name][1] * self.count
+
+
+class Layout:
+    def __init__(self, kind, cpp_name, codec_name, line):
+        self.kind = kind
+        self.cpp_name = cpp_name
+        self.codec_name = codec_name
+        self.line = line
+        self.fields = []
+
+    def get_fixed_fields(self):
+        return [field for field in self.fields if not field.is_tail]
+
+    def get_tail(self):
+        return self.fields[-1] if self.fields and self.fields[-1].is_tail else None
+
+    # the fields of the codec, a repeat block is one field named after the block
+    def get_py_fields(self):
+        fields = self.get_fixed_fields()
+        return [field for i, field in enumerate(fields) if field.group is None or i == 0 or fields[i - 1].group != field.group]
+
+    def get_format(self):
+        # a repeat block of one type packs as a single run, 176 u8s as 176B
+        parts = []
+        group = None
+        for field in self.get_fixed_fields():
+            char = TYPES[field.type_name][0]
+            if char != "s" and field.group is not None and field.group == group and parts[-1][1] == char:
+                parts[-1][0] += field.count
+            else:
+                parts.append([field.count, char])
+            group = field.group
+        return "<" + "".join(char if count == 1 and char != "s" else "%d%s" % (count, char) for count, char in parts)
+
+    def get_size(self):
+        return sum(field.get_size() for field in self.get_fixed_fields())
+
+
+def snake_case(name):
+    if re.match(r"^m[A-Z]", name):
+        name = name[1:]
+    return re.sub(r"(?<=[a-z0-9])([A-Z])", r"_\1", name).lower()
+
+
+def fail(line, message):
+    sys.exit("packets.schema:%d: %s" % (line, message))
+
+
+def parse_schema(path):
+    consts = {}
+    layouts = []
+
+    with open(path, "r") as f:
+        lines = f.readlines()
+
+    repeat = None
+
+    def add_fields(layout, fields):
+        for field in fields:
+            if layout.get_tail():
+                fail(layout.line, "nothing can follow a variable sized tail")
+            field.offset = layout.get_size()
+            layout.fields.append(field)
+
+    def end_repeat():
+        if repeat:
+            layout, count, py_name, indent, line, fields = repeat
+            if not fields:
+                fail(line, "empty repeat")
+            for i in range(count):
+                for field in fields:
+                    copy = Field(field.type_name, field.cpp_type, field.count, field.cpp_name.replace("$", str(i)), py_name,
+                                 False)
+                    copy.is_cpp_type_set = field.is_cpp_type_set
+                    copy.group = line
+                    add_fields(layout, [copy])
+
+    for number, line in enumerate(lines, 1):
+        text = line.split("#", 1)[0].rstrip()
+        if not text:
+            continue
+        words = text.split()
+        indent = len(text) - len(text.lstrip())
+
+        if repeat and indent <= repeat[3]:
+            end_repeat()
+            repeat = None
+
+        if not line[0].isspace():
+            if words[0] == "const" and len(words) == 3:
+                consts[words[1]] = int(words[2], 0)
+            elif words[0] in ("header", "packet", "entry") and len(words) == 3:
+                layouts.append(Layout(words[0], words[1], words[2], number))
+            else:
+                fail(number, "expected const, header, packet or entry")
+            continue
+
+        if not layouts:
+            fail(number, "field outside of a struct")
+        layout = layouts[-1]
+
+        if words[0] == "repeat":
+            if repeat or len(words) != 3:
+                fail(number, "repeat needs a count and a python field and can't be nested")
+            repeat = (layout, consts.get(words[1]) or int(words[1], 0), words[2], indent, number, [])
+            continue
+
+        if len(words) not in (2, 3) or (repeat and len(words) != 2):
+            fail(number, "malformed field")
+
+        match = FIELD_PATTERN.match(words[0])
+        count_text = match.group(2) if match else None
+        is_tail = count_text == ""
+
+        entries = [other.cpp_name for other in layouts if other.kind == "entry"]
+        if match and match.group(1) in TYPES:
+            cpp_type = TYPES[match.group(1)][2]
+        elif match and is_tail and match.group(1) in entries:
+            cpp_type = match.group(1)
+        else:
+            fail(number, "unknown type %s" % words[0])
+
+        if count_text is None:
+            count = 1
+        elif is_tail:
+            count = 0
+        elif count_text in consts:
+            count = consts[count_text]
+        else:
+            count = int(count_text, 0)
+
+        if is_tail and repeat:
+            fail(number, "a repeat can't hold the tail")
+
+        field = Field(match.group(1), cpp_type, count, words[1], words[2] if len(words) == 3 else snake_case(words[1]), is_tail)
+        if match.group(3):
+            field.cpp_type = match.group(3)
+            field.is_cpp_type_set = True
+
+        if repeat:
+            if "$" not in field.cpp_name:
+                fail(number, "fields in a repeat need a $ for the index in their name")
+            repeat[5].append(field)
+        else:
+            add_fields(layout, [field])
+
+    end_repeat()
+
+    codecs = {}
+    for layout in layouts:
+        other = codecs.setdefault(layout.codec_name, layout)
+        if other.get_format() != layout.get_format() or \
+                [f.py_name for f in other.get_py_fields()] != [f.py_name for f in layout.get_py_fields()]:
+            fail(layout.line, "%s doesn't match the other structs using %s" % (layout.cpp_name, layout.codec_name))
+
+    return consts, layouts, codecs
+
+
+def get_cpp_type(field):
+    return field.cpp_type if field.count == 1 or field.is_cpp_type_set else "%s[%d]" % (field.cpp_type, field.count)
+
+
+def generate_header(consts, layouts):
+    out = []
+    out.append("#pragma once")
+    out.append("")
+    out.append("// generated by scripts/genPackets.py from scripts/packets.schema, edit that and run make packets instead")
+    out.append("")
+    out.append("#include <cstddef>")
+    out.append("#include <type_traits>")
+    out.append("")
+    out.append("#include \"Packet.h\"")
+    out.append("")
+
+    for name, value in consts.items():
+        out.append("static_assert(%s == 0x%X, \"%s doesn't match packets.schema\");" % (name, value, name))
+
+    for layout in layouts:
+        base = "" if layout.kind != "packet" else " - sizeof(Packet)"
+        out.append("")
+        out.append("// %s" % layout.cpp_name)
+        if layout.get_tail():
+            size_check = "offsetof(%s, %s)%s == %d" % (layout.cpp_name, layout.get_tail().cpp_name, base, layout.get_size())
+        else:
+            size_check = "sizeof(%s)%s == %d" % (layout.cpp_name, base, layout.get_size())
+        out.append("static_assert(%s, \"%s size doesn't match packets.schema\");" % (size_check, layout.cpp_name))
+
+        for field in layout.get_fixed_fields():
+            out.append("static_assert(offsetof(%s, %s)%s == %d, \"%s::%s offset doesn't match packets.schema\");" %
+                       (layout.cpp_name, field.cpp_name, base, field.offset, layout.cpp_name, field.cpp_name))
+            out.append("static_assert(std::is_same_v<decltype(%s::%s), %s>, \"%s::%s type doesn't match packets.schema\");" %
+                       (layout.cpp_name, field.cpp_name, get_cpp_type(field), layout.cpp_name, field.cpp_name))
+            if field.is_cpp_type_set:
+                out.append("static_assert(sizeof(%s::%s) == %d, \"%s::%s size doesn't match packets.schema\");" %
+                           (layout.cpp_name, field.cpp_name, field.get_size(), layout.cpp_name, field.cpp_name))
+
+        # the tail is sized for the largest packet, it only has to hold the schema's type and be the last member
+        tail = layout.get_tail()
+        if tail:
+            name = "%s::%s" % (layout.cpp_name, tail.cpp_name)
+            out.append("static_assert(std::is_same_v<std::remove_extent_t<decltype(%s)>, %s>, \"%s type doesn't match packets.schema\");" %
+                       (name, tail.cpp_type, name))
+            out.append("static_assert(offsetof(%s, %s) + sizeof(%s) == sizeof(%s), \"%s isn't the last member\");" %
+                       (layout.cpp_name, tail.cpp_name, name, layout.cpp_name, name))
+
+    out.append("")
+    return "\n".join(out)
+
+
+def generate_codecs(layouts, codecs):
+    out = []
+    out.append("# Generated by Mod/scripts/genPackets.py from Mod/scripts/packets.schema, edit that and run make packets instead.")
+    out.append("# Every codec packs straight into a preallocated buffer (pack_into) and unpacks from a memoryview (unpack_from).")
+    out.append("import struct")
+    out.append("")
+    out.append("HEADER_SIZE : int = %d" % PACKET_HEADER_SIZE)
+
+    for codec_name, layout in codecs.items():
+        users = [other.cpp_name for other in layouts if other.codec_name == codec_name]
+        where = " after the header" if layout.kind == "packet" else ""
+        out.append("")
+        out.append("# %s, %d bytes%s" % (", ".join(users), layout.get_size(), where))
+        if layout.fields:
+            out.append("# " + "  ".join("%s@%d" % (field.py_name, field.offset) for field in layout.get_py_fields()))
+        tail = layout.get_tail()
+        if tail:
+            out[-1] += ", then %s" % tail.py_name
+            entry = next((other for other in layouts if other.cpp_name == tail.cpp_type), None)
+            if entry:
+                out[-1] += " (%s)" % entry.codec_name
+        out.append("%s : struct.Struct = struct.Struct(\"%s\")" % (codec_name, layout.get_format()))
+
+    out.append("")
+    return "\n".join(out)
+
+
+def generate(schema_path=SCHEMA_PATH):
+    consts, layouts, codecs = parse_schema(schema_path)
+    outputs = {
+        HEADER_PATH: generate_header(consts, layouts),
+        CODECS_PATH: generate_codecs(layouts, codecs),
+    }
+    return outputs, codecs
+
+
+def main():
+    outputs, _ = generate()
+
+    for path, text in outputs.items():
+        with open(path, "w") as f:
+            f.write(text)
+        print("wrote " + os.path.relpath(path))
+
+
+if __name__ == "__main__":
+    main()
@@ -1,4 +1,5 @@
 #include "helpers.hpp"
+#include "algorithms/crc32.h"
 #include "al/LiveActor/LiveActor.h"
 #include "logger.hpp"
 #include "sead/math/seadMathCalcCommon.h"
@@ -88,64 +89,106 @@ float quatAngle(sead::Quatf const &q1, sead::Quatf &q2) {
     return dotAngle > 1.0f - 0.000001f ? 0.0f : DEG(sead::Mathf::acos(dotAngle) * 2.0f);
 }
 
-bool isInCostumeList(const char *costumeName) {
-    for (size_t i = 0; i < sizeof(costumeNames)/sizeof(costumeNames[0]); i++)
-    {
-        if(al::isEqualString(costumeNames[i], costumeName)) {
-            return true;
-        }
+// name -> index lookups, built at compile time like the anim and capture tables
+
+// these ifdefs are really dumb but it makes clangd happy so /shrug
+#ifndef ANALYZER
+static constexpr crc32::HashArray costumeHashes(costumeNames);
+static constexpr crc32::HashArray stickerHashes(stickerNames);
+static constexpr crc32::HashArray souvenirHashes(souvenirNames);
+static constexpr crc32::HashArray captureListHashes(captureListNames);
+static constexpr crc32::HashArray moonItemHashes(moonItemNames);
+static constexpr crc32::HashArray worldHomeStageHashes(worldHomeStageNames);
+
+static constexpr crc32::HashArray classHackHashes([] {
+    std::array<const char*, ACNT(classHackNames)> classNames = {};
+    for (size_t i = 0; i < classNames.size(); i++) {
+        classNames[i] = classHackNames[i].className;
     }
-    return false;
+    return classNames;
+}());
+
+static_assert(!costumeHashes.HasCollisions(), "costumeNames has a duplicate or colliding name");
+static_assert(!stickerHashes.HasCollisions(), "stickerNames has a duplicate or colliding name");
+static_assert(!souvenirHashes.HasCollisions(), "souvenirNames has a duplicate or colliding name");
+static_assert(!captureListHashes.HasCollisions(), "captureListNames has a duplicate or colliding name");
+static_assert(!moonItemHashes.HasCollisions(), "moonItemNames has a duplicate or colliding name");
+static_assert(!worldHomeStageHashes.HasCollisions(), "worldHomeStageNames has a duplicate or colliding name");
+static_assert(!classHackHashes.HasCollisions(), "classHackNames has a duplicate or colliding name");
+
+static_assert(costumeHashes.FindIndex("MarioInvisible") == ACNT(costumeNames) - 1);
+static_assert(captureListHashes.FindIndex("Yoshi") == ACNT(captureListNames) - 1);
+static_assert(classHackHashes.FindIndex("Koopa") == ACNT(classHackNames) - 1);
+
+/**
+ * @brief looks a name up in a hashed table, names that aren't in it can still share a hash with one that is,
+ * so a hit is compared against the table before it's returned
+ * @return index of name in names, -1 if it isn't there
+ */
+template <size_t Length>
+static int findNameIndex(const crc32::HashArray<Length>& hashes, const char* const (&names)[Length], const char* name) {
+    if (!name) {
+        return -1;
+    }
+
+    int index = hashes.FindIndex(name);
+    if (index < 0 || !al::isEqualString(names[index], name)) {
+        return -1;
+    }
+    return index;
+}
+#endif
+
+bool isInCostumeList(const char *costumeName) {
+    return getIndexCostumeList(costumeName) != -1;
 }
 
 int getIndexCostumeList(const char *costumeName) {
-    for (size_t i = 0; i < sizeof(costumeNames)/sizeof(costumeNames[0]); i++)
-    {
-        if(al::isEqualString(costumeNames[i], costumeName)) {
-            return i;
-        }
-    }
+#ifndef ANALYZER
+    return findNameIndex(costumeHashes, costumeNames, costumeName);
+#else
     return -1;
+#endif
 }
 
 int getIndexStickerList(const char *stickerName) {
-    for (size_t i = 0; i < sizeof(stickerNames)/sizeof(stickerNames[0]); i++)
-    {
-        if (al::isEqualString(stickerNames[i], stickerName)) {
-            return i;
-        }
-    }
+#ifndef ANALYZER
+    return findNameIndex(stickerHashes, stickerNames, stickerName);
+#else
     return -1;
+#endif
 }
 
 int getIndexSouvenirList(const char *souvenirName) {
-    for (size_t i = 0; i < sizeof(souvenirNames) / sizeof(souvenirNames[0]); i++)
-    {
-        if (al::isEqualString(souvenirNames[i], souvenirName)) {
-            return i;
-        }
-    }
+#ifndef ANALYZER
+    return findNameIndex(souvenirHashes, souvenirNames, souvenirName);
+#else
     return -1;
+#endif
 }
 
 int getIndexCaptureList(const char *captureName) {
-    for (size_t i = 0; i < sizeof(captureListNames) / sizeof(captureListNames[0]); i++)
-    {
-        if (al::isEqualString(captureListNames[i], captureName)) {
-            return i;
-        }
-    }
+#ifndef ANALYZER
+    return findNameIndex(captureListHashes, captureListNames, captureName);
+#else
     return -1;
+#endif
 }
 
 int getIndexMoonItemList(const char *moonItem) {
-    for (size_t i = 0; i < sizeof(moonItemNames) / sizeof(moonItemNames[0]); i++)
-    {
-        if (al::isEqualString(moonItemNames[i], moonItem)) {
-            return i;
-        }
-    }
+#ifndef ANALYZER
+    return findNameIndex(moonItemHashes, moonItemNames, moonItem);
+#else
+    return -1;
+#endif
+}
+
+int getIndexWorldHomeStage(const char *stageName) {
+#ifndef ANALYZER
+    return findNameIndex(worldHomeStageHashes, worldHomeStageNames, stageName);
+#else
     return -1;
+#endif
 }
 
 const char *tryGetPuppetCapName(PuppetInfo *info) {
@@ -165,12 +208,16 @@ const char *tryGetPuppetBodyName(PuppetInfo *info) {
 }
 
 const char *tryConvertName(const char *className) {
-    for (size_t i = 0; i < ACNT(classHackNames); i++)
-    {
-        if(al::isEqualString(classHackNames[i].className, className)) {
-            return classHackNames[i].hackName;
-        }
+    if (!className) {
+        return className;
+    }
+
+#ifndef ANALYZER
+    int index = classHackHashes.FindIndex(className);
+    if (index >= 0 && al::isEqualString(classHackNames[index].className, className)) {
+        return classHackNames[index].hackName;
     }
+#endif
     return className;
 }
 
@@ -53,13 +53,16 @@ static int updateCounterTimer = 0;
 
 void updatePlayerInfo(GameDataHolderAccessor holder, PlayerActorBase* playerBase, bool isYukimaru) {
     
-    if (pInfSendTimer >= 3) {
+    // called every frame, the send rate schedulers decide whether an update is actually due
+    Client::sendPlayerInfPacket(playerBase, isYukimaru);
 
-        Client::sendPlayerInfPacket(playerBase, isYukimaru);
+    if (!isYukimaru) {
+        Client::sendHackCapInfPacket(((PlayerActorHakoniwa*)playerBase)->mHackCap);
+    }
 
-        if (!isYukimaru) {
-            Client::sendHackCapInfPacket(((PlayerActorHakoniwa*)playerBase)->mHackCap);
+    if (pInfSendTimer >= 3) {
 
+        if (!isYukimaru) {
             Client::sendCaptureInfPacket((PlayerActorHakoniwa*)playerBase);
         }
         
@@ -285,19 +288,40 @@ void drawMainHook(HakoniwaSequence* curSequence, sead::Viewport* viewport,
 
         gTextWriter->printf("Client Socket Connection Status: %s\n",
                             Client::instance()->mSocket->getStateChar());
+        gTextWriter->printf("Connection State: %s Reconnect Attempts: %d\n",
+                            Client::instance()->mSocket->getConnStateChar(),
+                            Client::instance()->mSocket->getReconnectAttempts());
         gTextWriter->printf("Udp socket status: %s\n",
                             Client::instance()->mSocket->getUdpStateChar());
+        if (Client::instance()->mSocket->getSmoothedRtt() >= 0) {
+            gTextWriter->printf("Ping: %.2fms Jitter: %.2fms\n",
+                                Client::instance()->mSocket->getSmoothedRtt() * 0.001f,
+                                Client::instance()->mSocket->getRttJitter() * 0.001f);
+        } else {
+            gTextWriter->printf("Ping: Waiting for Pong\n");
+        }
         // gTextWriter->printf("nn::socket::GetLastErrno: 0x%x\n",
         // Client::instance()->mSocket->socket_errno);
         gTextWriter->printf("Connected Players: %d/%d\n", Client::getConnectCount() + 1,
                             Client::getMaxPlayerCount());
 
-        gTextWriter->printf("Send Queue Count: %d/%d\n",
-                            Client::instance()->mSocket->getSendCount(),
-                            Client::instance()->mSocket->getSendMaxCount());
-        gTextWriter->printf("Recv Queue Count: %d/%d\n",
+        for (int lane = SendLane::CRITICAL; lane < SendLane::LANECOUNT; lane++) {
+            SendLane sendLane = static_cast<SendLane>(lane);
+            gTextWriter->printf("%s Send Lane: %d/%d Sent: %d Dropped: %d\n",
+                                SocketClient::getSendLaneName(sendLane),
+                                Client::instance()->mSocket->getSendCount(sendLane),
+                                Client::instance()->mSocket->getSendMaxCount(sendLane),
+                                Client::instance()->mSocket->getSentCount(sendLane),
+                                Client::instance()->mSocket->getSendDropCount(sendLane));
+        }
+        gTextWriter->printf("Realtime Packets Coalesced: %d\n",
+                            Client::instance()->mSocket->getCoalesceCount());
+        gTextWriter->printf("Player Max Send Rate: %.1f/%.1f Hz (ZL + Up/Down)\n", Client::getPlayerSendHz(),
+                            Client::getTargetSendHz());
+        gTextWriter->printf("Recv Queue Count: %d/%d Dropped: %d\n",
                             Client::instance()->mSocket->getRecvCount(),
-                            Client::instance()->mSocket->getRecvMaxCount());
+                            Client::instance()->mSocket->getRecvMaxCount(),
+                            Client::instance()->mSocket->getRecvDropCount());
 
         PlayerActorBase* playerBase = rs::getPlayerActor(curScene);
 
@@ -493,92 +517,15 @@ bool isGotShineByHintIdx(GameDataHolderAccessor accessor, int worldId, int hintI
 
 void sendShinePacket(GameDataHolderAccessor thisPtr, Shine* curShine) {
 
-    GameDataFile::HintInfo* curHintInfo =
-    &thisPtr.mData->mGameDataFile->mShineHintList[curShine->mShineIdx];
-
     Client::setRecentShine(curShine);
 
-    if (curHintInfo->mUniqueID == 0) {
-        if (strcmp(curShine->curShineInfo->stageName.cstr(), "CapWorldHomeStage") == 0) {
-            Client::sendCheckPacket(1086, -1);
-        }
-        if (strcmp(curShine->curShineInfo->stageName.cstr(), "SandWorldHomeStage") == 0) {
-            Client::sendCheckPacket(1096, -1);
-        }
-        if (strcmp(curShine->curShineInfo->stageName.cstr(), "LakeWorldHomeStage") == 0) {
-            Client::sendCheckPacket(1094, -1);
-        }
-        if (strcmp(curShine->curShineInfo->stageName.cstr(), "ForestWorldHomeStage") == 0) {
-            Client::sendCheckPacket(1089, -1);
-        }
-        if (strcmp(curShine->curShineInfo->stageName.cstr(), "CityWorldHomeStage") == 0) {
-            Client::sendCheckPacket(1088, -1);
-        }
-        if (strcmp(curShine->curShineInfo->stageName.cstr(), "SnowWorldHomeStage") == 0) {
-            Client::sendCheckPacket(1087, -1);
-        }
-        if (strcmp(curShine->curShineInfo->stageName.cstr(), "SeaWorldHomeStage") == 0) {
-            Client::sendCheckPacket(1095, -1);
-        }
-        if (strcmp(curShine->curShineInfo->stageName.cstr(), "LavaWorldHomeStage") == 0) {
-            Client::sendCheckPacket(1090, -1);
-        }
-        if (strcmp(curShine->curShineInfo->stageName.cstr(), "SkyWorldHomeStage") == 0) {
-            Client::sendCheckPacket(1091, -1);
-        }
-        if (strcmp(curShine->curShineInfo->stageName.cstr(), "MoonWorldHomeStage") == 0) {
-            Client::sendCheckPacket(1165, -1);
-        }
-        if (strcmp(curShine->curShineInfo->stageName.cstr(), "PeachWorldHomeStage") == 0) {
-            Client::sendCheckPacket(1152, -1);
-        }
-        if (strcmp(curShine->curShineInfo->stageName.cstr(), "Special1WorldHomeStage") == 0) {
-            if (strcmp(GameDataFunction::tryGetCurrentMainStageName(thisPtr),
-                       "WaterfallWorldHomeStage") == 0) {
-                Client::sendCheckPacket(1132, -1);
-            }
-            if (strcmp(GameDataFunction::tryGetCurrentMainStageName(thisPtr),
-                       "LakeWorldHomeStage") == 0) {
-                Client::sendCheckPacket(1128, -1);
-            }
-            if (strcmp(GameDataFunction::tryGetCurrentMainStageName(thisPtr),
-                       "CloudWorldHomeStage") == 0) {
-                Client::sendCheckPacket(1124, -1);
-            }
-            if (strcmp(GameDataFunction::tryGetCurrentMainStageName(thisPtr),
-                       "ClashWorldHomeStage") == 0) {
-                Client::sendCheckPacket(1126, -1);
-            }
-            if (strcmp(GameDataFunction::tryGetCurrentMainStageName(thisPtr),
-                       "CityWorldHomeStage") == 0) {
-                Client::sendCheckPacket(1130, -1);
-            }
-            if (strcmp(GameDataFunction::tryGetCurrentMainStageName(thisPtr),
-                       "SnowWorldHomeStage") == 0) {
-                Client::sendCheckPacket(1129, -1);
-            }
-            if (strcmp(GameDataFunction::tryGetCurrentMainStageName(thisPtr),
-                       "SeaWorldHomeStage") == 0) {
-                Client::sendCheckPacket(1127, -1);
-            }
-            if (strcmp(GameDataFunction::tryGetCurrentMainStageName(thisPtr),
-                       "LavaWorldHomeStage") == 0) {
-                Client::sendCheckPacket(1123, -1);
-            }
-            if (strcmp(GameDataFunction::tryGetCurrentMainStageName(thisPtr),
-                       "BossRaidWorldHomeStage") == 0) {
-                Client::sendCheckPacket(1125, -1);
-            }
-            if (strcmp(GameDataFunction::tryGetCurrentMainStageName(thisPtr),
-                       "PeachWorldHomeStage") == 0) {
-                Client::sendCheckPacket(1131, -1);
-            }
-        }
-    } else {
-        Client::sendCheckPacket(curHintInfo->mUniqueID, -1);
+    // hint art moons are sent as the hint art they came from, or not at all if that can't be found.
+    // Recorded under the same uid, so the bitmap sent on connect holds the check (their own uid is 0 for all of them)
+    int shineUid = Client::getShineUid(curShine);
+    if (shineUid != 0) {
+        Client::sendCheckPacket(shineUid, -1);
+        Client::addShine(shineUid);
     }
-    // Add some way to sync shinechecks grabbed before connecting, probably handle on connect or something
-    Client::addShine(curHintInfo->mUniqueID);
 }
 
 void sendItemPacket(GameDataFile thisPtr, ShopItem::ItemInfo* info, bool flag) {
@@ -723,10 +670,7 @@ void setShineModelColor(Shine* thisPtr, char* stageName, int color, bool isSetMt
 const char16_t* getShopItemMessage(al::IUseMessageSystem const* messageSystem, char const* fileName, char const* key) 
 {
     const char16_t* msg =  Client::getShopReplacementText(fileName, key);
-    sead::WFixedSafeString<200> confirm;
-    confirm = confirm.cEmptyString;
-    confirm.append(msg);
-    if (!confirm.isEmpty())
+    if (msg[0] != u'\0')
     {
         return msg;
     }
@@ -777,25 +721,7 @@ void onNewGameDemoStart(char* name, bool unkBool) {
         Client::setScenario(i, 1);
     }
 
-    for (int i = 0; i < 25; i++) {
-        Client::setShineChecks(i, 0);
-    }
-
-    for (int i = 0; i < 12; i++) {
-        Client::setOutfitChecks(i, 0);
-    }
-
-    for (int i = 0; i < 4; i++) {
-        Client::setStickerChecks(i, 0);
-    }
-
-    for (int i = 0; i < 5; i++) {
-        Client::setSouvenirChecks(i, 0);
-    }
-
-    for (int i = 0; i < 8; i++) {
-        Client::setCaptureChecks(i, 0);
-    }
+    Client::clearCollected();
 
     Client::setCheckIndex(-1);
 
@@ -945,6 +871,10 @@ bool hakoniwaSequenceHook(HakoniwaSequence* sequence) {
             }
             if (debugPuppetIndex >= Client::getMaxPlayerCount() - 1)
                 debugPuppetIndex = 0;
+
+            // steps the player/cap send rate shown on the debug screen
+            if (al::isPadTriggerUp(-1)) Client::setSendRate(Client::getTargetSendHz() + SENDRATESTEP);
+            if (al::isPadTriggerDown(-1)) Client::setSendRate(Client::getTargetSendHz() - SENDRATESTEP);
         }
 
     } else if (al::isPadHoldL(-1)) {
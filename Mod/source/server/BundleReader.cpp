@@ -0,0 +1,163 @@
+#include "server/BundleReader.hpp"
+
+BundleReader::BundleReader(const u8* data, u32 size, bool isRle) : mData(data), mSize(size), mIsRle(isRle) {}
+
+bool BundleReader::readByte(u8* out) {
+
+    if (!mIsRle) {
+        if (mOffset >= mSize)
+            return false;
+
+        *out = mData[mOffset++];
+        return true;
+    }
+
+    if (mRunLeft == 0) {
+        if (mOffset >= mSize)
+            return false;
+
+        u8 control = mData[mOffset++];
+
+        mIsRepeatRun = control >= 0x80;
+        mRunLeft = mIsRepeatRun ? control - 0x7D : control + 1;
+
+        if (mIsRepeatRun) {
+            if (mOffset >= mSize)
+                return false;
+
+            mRepeatValue = mData[mOffset++];
+        }
+    }
+
+    if (mIsRepeatRun) {
+        *out = mRepeatValue;
+    } else {
+        if (mOffset >= mSize)
+            return false;
+
+        *out = mData[mOffset++];
+    }
+
+    mRunLeft--;
+    return true;
+}
+
+bool BundleReader::read(void* out, u32 size) {
+
+    if (mIsFailed)
+        return false;
+
+    u8* bytes = static_cast<u8*>(out);
+
+    for (u32 i = 0; i < size; i++) {
+        if (!readByte(&bytes[i])) {
+            mIsFailed = true;
+            return false;
+        }
+    }
+
+    mReadCount += size;
+    return true;
+}
+
+bool BundleReader::skip(u32 size) {
+    u8 discard = 0;
+
+    for (u32 i = 0; i < size; i++) {
+        if (!read(&discard))
+            return false;
+    }
+
+    return true;
+}
+
+bool BundleReader::readString(char16_t* out, u32 maxLength) {
+
+    u8 length = 0;
+    u32 outLength = 0;
+
+    if (!read(&length))
+        return false;
+
+    for (u32 i = 0; i < length; i++) {
+        u8 lead = 0;
+
+        if (!read(&lead))
+            return false;
+
+        u32 codePoint = lead;
+        u32 continuationCount = 0;
+
+        if (lead >= 0xF0) {
+            codePoint = lead & 0x07;
+            continuationCount = 3;
+        } else if (lead >= 0xE0) {
+            codePoint = lead & 0x0F;
+            continuationCount = 2;
+        } else if (lead >= 0xC0) {
+            codePoint = lead & 0x1F;
+            continuationCount = 1;
+        }
+
+        for (u32 j = 0; j < continuationCount && i + 1 < length; j++, i++) {
+            u8 continuation = 0;
+
+            if (!read(&continuation))
+                return false;
+
+            codePoint = (codePoint << 6) | (continuation & 0x3F);
+        }
+
+        // the game's font has nothing outside the basic plane anyway
+        if (codePoint > 0xFFFF)
+            codePoint = '?';
+
+        if (outLength + 1 < maxLength)
+            out[outLength++] = codePoint;
+    }
+
+    if (maxLength > 0)
+        out[outLength] = u'\0';
+
+    return true;
+}
+
+bool BundleReader::readString(char* out, u32 maxLength) {
+
+    u8 length = 0;
+    u32 outLength = 0;
+
+    if (!read(&length))
+        return false;
+
+    for (u32 i = 0; i < length; i++) {
+        u8 value = 0;
+
+        if (!read(&value))
+            return false;
+
+        if (outLength + 1 < maxLength)
+            out[outLength++] = value;
+    }
+
+    // back off a multi byte character that got cut in half
+    if (outLength < length) {
+        u32 end = outLength;
+
+        while (end > 0 && (static_cast<u8>(out[end - 1]) & 0xC0) == 0x80)
+            end--;
+
+        if (end > 0) {
+            u8 lead = out[end - 1];
+            u32 sequenceLength = lead >= 0xF0 ? 4 : lead >= 0xE0 ? 3 : lead >= 0xC0 ? 2 : 1;
+
+            if (end - 1 + sequenceLength > outLength)
+                outLength = end - 1;
+        }
+    }
+
+    if (maxLength > 0)
+        out[outLength] = '\0';
+
+    return true;
+}
@@ -6,6 +6,7 @@
 #include "logger.hpp"
 #include "packets/Packet.h"
 #include "server/hns/HideAndSeekMode.hpp"
+#include "server/BundleReader.hpp"
 
 SEAD_SINGLETON_DISPOSER_IMPL(Client)
 
@@ -28,6 +29,10 @@ Client::Client() {
     mKeyboard = new Keyboard(nn::swkbd::GetRequiredStringBufferSize());
 
     mSocket = new SocketClient("SocketClient", mHeap, this);
+    // packets queued during the same game frame (e.g. GameInf and CostumeInf on a stage change) go out in one Send
+    mSocket->setSendBatchLimits(SENDBATCHCOUNT, SENDFLUSHDEADLINE);
+
+    mShopText = new char16[SHOPITEMCOUNT * SHOPITEMTEXTSIZE](); // ~60KB of the 0x50000 above
     
     mPuppetHolder = new PuppetHolder(maxPuppets);
 
@@ -63,16 +68,10 @@ Client::Client() {
     worldScenarios.fill(1);
     worldPayCounts.fill(-1);
 
-    collectedShines.fill(0);
-    collectedOutfits.fill(0);
-    collectedStickers.fill(0);
-    collectedSouvenirs.fill(0);
-    collectedCaptures.fill(0);
-    checkedCaptures.fill(0);
-
     shineTextReplacements.fill({0, 0});
     shineItemNames.fill(sead::FixedSafeString<40>());
     shineColors.fill(0);
+    memset(mStageShines, 0xFF, sizeof(mStageShines));
 
     shopCapTextReplacements.fill({254, 255, 255, 255});
     shopClothTextReplacements.fill({254, 255, 255, 255});
@@ -163,13 +162,8 @@ bool Client::startConnection() {
         SaveDataAccessFunction::startSaveDataWrite(mHolder.mData);
     }
 
-    // This might need to be changed later
-    // Repeat connection attempts until successful
-    while (!mIsConnectionActive) {
-        mIsConnectionActive = mSocket->init(mServerIP.cstr(), mServerPort).isSuccess();
-        nn::os::YieldThread();
-        nn::os::SleepThread(nn::TimeSpan::FromNanoSeconds(2500000000));
-    }
+    // the socket retries with backoff on its own, so this only returns once a connection has been made
+    mIsConnectionActive = mSocket->init(mServerIP.cstr(), mServerPort).isSuccess();
 
     if (mIsConnectionActive) {
 
@@ -194,7 +188,7 @@ bool Client::startConnection() {
                     waitingForInitPacket = false;
                 }
 
-                mHeap->free(curPacket);
+                mSocket->releasePacket(curPacket);
 
             } else {
                 Logger::log("Receive failed! Stopping Connection.\n");
@@ -358,6 +352,10 @@ void Client::readFunc() {
             case PacketType::PLAYERINF:
                 updatePlayerInfo((PlayerInf*)curPacket);
                 break;
+            case PacketType::PLAYERINFKEY:
+            case PacketType::PLAYERINFDELTA:
+                updatePlayerInfDelta((PlayerInfDelta*)curPacket);
+                break;
             case PacketType::GAMEINF:
                 updateGameInfo((GameInf*)curPacket);
                 break;
@@ -382,6 +380,10 @@ void Client::readFunc() {
                 // No need to send player/costume packets if they're empty
                 if (lastPlayerInfPacket.mUserID == mUserID)
                     mSocket->send(&lastPlayerInfPacket);
+
+                // the new player has no keyframe to apply our deltas to yet
+                mPlayerInfCodec.requestKeyframe();
+
                 if (lastCostumeInfPacket.mUserID == mUserID)
                     mSocket->send(&lastCostumeInfPacket);
                 if (lastTagInfPacket.mUserID == mUserID)
@@ -399,12 +401,18 @@ void Client::readFunc() {
             case PacketType::SHINECHECKS:
                 updateSentShines((ShineChecks*)curPacket);
                 break;
+            case PacketType::SHINEBITMAP:
+                updateShineBitmap((ShineBitmap*)curPacket);
+                break;
             case PacketType::APCHATMESSAGE:
                 updateChatMessages((ArchipelagoChatMessage*)curPacket);
                 break;
             case PacketType::SLOTDATA:
                 updateSlotData((SlotData*)curPacket);
                 break;
+            case PacketType::SLOTBUNDLE:
+                updateSlotBundle((SlotBundle*)curPacket);
+                break;
             case PacketType::APINFO:
                 addApInfo((ApInfo*)curPacket);
                 break;
@@ -453,12 +461,15 @@ void Client::readFunc() {
 			case PacketType::HOLEPUNCH: 
 				sendUdpHolePunch();
 				break;
+            case PacketType::PING:
+                sendPongPacket((PingPacket*)curPacket);
+                break;
             default:
                 Logger::log("Discarding Unknown Packet Type.\n");
                 break;
             }
 
-            mHeap->free(curPacket);
+            mSocket->releasePacket(curPacket);
 
         }else { // if false, socket has errored or disconnected, so restart the connection
             Logger::log("Client Socket Encountered an Error, restarting connection! Errno: 0x%x\n", mSocket->socket_errno);
@@ -486,9 +497,15 @@ void Client::sendPlayerInfPacket(const PlayerActorBase *playerBase, bool isYukim
         return;
     }
 
+    // runs every frame, so don't bother looking up animations for an update that couldn't go out anyway
+    if (!sInstance->mPlayerSendRate.isIntervalElapsed()) {
+        return;
+    }
+
     sead::ScopedCurrentHeapSetter setter(sInstance->mHeap);
 
-    PlayerInf *packet = new PlayerInf();
+    PlayerInf info;
+    PlayerInf *packet = &info;
     packet->mUserID = sInstance->mUserID;
 
     packet->playerPos = al::getTrans(playerBase);
@@ -543,11 +560,32 @@ void Client::sendPlayerInfPacket(const PlayerActorBase *playerBase, bool isYukim
         packet->subActName = PlayerAnims::Type::Unknown;
     }
     
-    if(sInstance->lastPlayerInfPacket != *packet) {
-        sInstance->lastPlayerInfPacket = *packet; // deref packet and store in client memory
-        sInstance->mSocket->queuePacket(packet);
+    PlayerInf& lastInfo = sInstance->lastPlayerInfPacket;
+
+    bool isPoseChanged = lastInfo.actName != info.actName || lastInfo.subActName != info.subActName;
+
+    for (size_t i = 0; i < 6 && !isPoseChanged; i++) {
+        isPoseChanged = fabsf(lastInfo.animBlendWeights[i] - info.animBlendWeights[i]) > PLAYERWEIGHTERROR;
+    }
+
+    float rotDot = lastInfo.playerRot.x * info.playerRot.x + lastInfo.playerRot.y * info.playerRot.y +
+                   lastInfo.playerRot.z * info.playerRot.z + lastInfo.playerRot.w * info.playerRot.w;
+
+    isPoseChanged |= 1.f - fabsf(rotDot) > PLAYERROTERROR;
+
+    if (!sInstance->mPlayerSendRate.update(info.playerPos, isPoseChanged, sInstance->isSendBacklogged(PacketType::PLAYERINFDELTA))) {
+        return;
+    }
+
+    sInstance->lastPlayerInfPacket = info; // store in client memory
+
+    PlayerInfDelta *delta = new PlayerInfDelta();
+
+    // small enough changes quantize to the packet already sent
+    if (sInstance->mPlayerInfCodec.encode(info, delta)) {
+        sInstance->mSocket->queuePacket(delta);
     } else {
-        sInstance->mHeap->free(packet); // free packet if we're not using it
+        sInstance->mHeap->free(delta);
     }
 
 }
@@ -568,8 +606,12 @@ void Client::sendHackCapInfPacket(const HackCap* hackCap) {
     
     bool isFlying = hackCap->isFlying();
 
-    // if cap is in flying state, send packet as often as this function is called
     if (isFlying) {
+        // the throw itself always goes out, after that the cap is only sent as often as its movement needs
+        if (!sInstance->mCapSendRate.update(al::getTrans(hackCap), !sInstance->isSentHackInf, sInstance->isSendBacklogged(PacketType::HACKCAPINF))) {
+            return;
+        }
+
         HackCapInf *packet = new HackCapInf();
         packet->mUserID = sInstance->mUserID;
         packet->capPos = al::getTrans(hackCap);
@@ -595,7 +637,34 @@ void Client::sendHackCapInfPacket(const HackCap* hackCap) {
         packet->capQuat = sead::Quatf::unit;
         sInstance->mSocket->queuePacket(packet);
         sInstance->isSentHackInf = false;
+        sInstance->mCapSendRate.reset();
+    }
+}
+
+/**
+ * @brief sets the most player and cap updates sent per second, the actual rate is lower whenever movement allows it.
+ * Stepped with ZL + Up/Down on the debug screen
+ * 
+ * @param hz clamped to [SENDRATESTEP, MAXPLAYERSENDHZ]
+ */
+void Client::setSendRate(float hz) {
+    if (!sInstance) {
+        Logger::log("Static Instance is Null!\n");
+        return;
     }
+
+    hz = hz < SENDRATESTEP ? SENDRATESTEP : hz > MAXPLAYERSENDHZ ? MAXPLAYERSENDHZ : hz;
+
+    sInstance->mPlayerSendRate.setTargetHz(hz);
+    sInstance->mCapSendRate.setTargetHz(hz);
+}
+
+/**
+ * @return true if the send thread hasn't caught up with the last update of this type, or the normal lane is filling up
+ */
+bool Client::isSendBacklogged(PacketType type) {
+    return mSocket->isRealtimePending(type) ||
+           mSocket->getSendCount(SendLane::NORMAL) > mSocket->getSendMaxCount(SendLane::NORMAL) / 2;
 }
 
 /**
@@ -758,25 +827,30 @@ void Client::sendCaptureInfPacket(const PlayerActorHakoniwa* player) {
  * @brief
  */
 void Client::resendInitPackets() {
+    // sent directly as this runs during the socket handshake, and the last packets aren't heap allocated so can't be queued
+
     // CostumeInfPacket
     if (lastCostumeInfPacket.mUserID == mUserID) {
-        mSocket->queuePacket(&lastCostumeInfPacket);
+        mSocket->send(&lastCostumeInfPacket);
     }
 
     // GameInfPacket
     if (lastGameInfPacket != emptyGameInfPacket) {
-        mSocket->queuePacket(&lastGameInfPacket);
+        mSocket->send(&lastGameInfPacket);
     }
 
     // TagInfPacket
     if (lastTagInfPacket.mUserID == mUserID) {
-        mSocket->queuePacket(&lastTagInfPacket);
+        mSocket->send(&lastTagInfPacket);
     }
 
     // CaptureInfPacket
     if (lastCaptureInfPacket.mUserID == mUserID) {
-        mSocket->queuePacket(&lastCaptureInfPacket);
+        mSocket->send(&lastCaptureInfPacket);
     }
+
+    // players that joined while we were gone have nothing to apply our deltas to
+    mPlayerInfCodec.requestKeyframe();
 }
 
 /**
@@ -835,9 +909,11 @@ void Client::setApDeath(bool value)
  * 
  * @param packet 
  */
-void Client::updatePlayerInfo(PlayerInf *packet) {
+void Client::updatePlayerInfo(PlayerInf *packet, PuppetInfo* curInfo) {
 
-    PuppetInfo* curInfo = findPuppetInfo(packet->mUserID, false);
+    if (!curInfo) {
+        curInfo = findPuppetInfo(packet);
+    }
 
     if (!curInfo) {
         return;
@@ -891,6 +967,28 @@ void Client::updatePlayerInfo(PlayerInf *packet) {
 
 }
 
+/**
+ * @brief decodes a quantized PlayerInf against the sending puppet's keyframe and applies it like a full one
+ * 
+ * @param packet 
+ */
+void Client::updatePlayerInfDelta(PlayerInfDelta *packet) {
+
+    PuppetInfo* curInfo = findPuppetInfo(packet);
+
+    if (!curInfo) {
+        return;
+    }
+
+    PlayerInf decoded;
+    decoded.mUserID = packet->mUserID;
+
+    // deltas for a keyframe that was lost are dropped until the next keyframe arrives
+    if (PlayerInfCodec::decode(packet, &curInfo->playerKeyframe, &decoded)) {
+        updatePlayerInfo(&decoded, curInfo);
+    }
+}
+
 /**
  * @brief 
  * 
@@ -898,7 +996,7 @@ void Client::updatePlayerInfo(PlayerInf *packet) {
  */
 void Client::updateHackCapInfo(HackCapInf *packet) {
 
-    PuppetInfo* curInfo = findPuppetInfo(packet->mUserID, false);
+    PuppetInfo* curInfo = findPuppetInfo(packet);
 
     if (curInfo) {
         curInfo->capPos = packet->capPos;
@@ -989,6 +1087,19 @@ void Client::updatePlayerConnect(PlayerConnect* packet) {
 
         mConnectCount++;
     }
+
+    // players already connected get announced again with new session ids after a reconnect
+    if (curInfo->playerID == packet->mUserID) {
+
+        if (curInfo->sessionId != NOSESSION) {
+            mSessionPuppets[curInfo->sessionId] = nullptr;
+        }
+
+        curInfo->sessionId = packet->getSessionId();
+        if (curInfo->sessionId != NOSESSION) {
+            mSessionPuppets[curInfo->sessionId] = curInfo;
+        }
+    }
 }
 
 /**
@@ -1113,6 +1224,28 @@ void Client::sendUdpInit() {
 	
     sInstance->mSocket->queuePacket(packet);
 }
+/**
+ * @brief 
+ * Answer a heartbeat ping from the server, echoing its timestamp so it can measure the round trip
+ */
+void Client::sendPongPacket(const PingPacket* ping) {
+
+    if (!sInstance) {
+        Logger::log("Static Instance is Null!\n");
+        return;
+    }
+
+    sead::ScopedCurrentHeapSetter setter(sInstance->mHeap);
+
+    PingPacket *packet = new PingPacket();
+
+    packet->mType = PacketType::PONG;
+    packet->mUserID = sInstance->mUserID;
+    packet->timestamp = ping->timestamp;
+    packet->sequence = ping->sequence;
+
+    sInstance->mSocket->queuePacket(packet);
+}
 /**
  * @brief 
  * 
@@ -1127,6 +1260,12 @@ void Client::disconnectPlayer(PlayerDC *packet) {
     }
     
     curInfo->isConnected = false;
+    curInfo->playerKeyframe = PlayerInfKeyframe();
+
+    if (curInfo->sessionId != NOSESSION) {
+        mSessionPuppets[curInfo->sessionId] = nullptr;
+        curInfo->sessionId = NOSESSION;
+    }
 
     curInfo->scenarioNo = -1;
     strcpy(curInfo->stageName, "");
@@ -1186,6 +1325,23 @@ PuppetInfo* Client::findPuppetInfo(const nn::account::Uid& id, bool isFindAvaila
     return firstAvailable;
 }
 
+/**
+ * @brief finds the puppet a received packet belongs to, by index if it came in on a compact header
+ * 
+ * @param packet a packet from mSocket->tryGetPacket
+ */
+PuppetInfo* Client::findPuppetInfo(const Packet* packet) {
+
+    PuppetInfo* curInfo = mSessionPuppets[mSocket->getPacketSessionId(packet)];
+
+    // session ids can be handed to someone else after a disconnect, so the uid still has to match
+    if (curInfo && curInfo->playerID == packet->mUserID) {
+        return curInfo;
+    }
+
+    return findPuppetInfo(packet->mUserID, false);
+}
+
 /**
  * @brief 
  * 
@@ -1479,106 +1635,9 @@ void Client::updateSentShines(ShineChecks* packet)
         return;
     }
 
-    addShine(packet->shineUid0);
-    addShine(packet->shineUid1);
-    addShine(packet->shineUid2);
-    addShine(packet->shineUid3);
-    addShine(packet->shineUid4);
-    addShine(packet->shineUid5);
-    addShine(packet->shineUid6);
-    addShine(packet->shineUid7);
-    addShine(packet->shineUid8);
-    addShine(packet->shineUid9);
-    addShine(packet->shineUid10);
-    addShine(packet->shineUid11);
-    addShine(packet->shineUid12);
-    addShine(packet->shineUid13);
-    addShine(packet->shineUid14);
-    addShine(packet->shineUid15);
-    addShine(packet->shineUid16);
-    addShine(packet->shineUid17);
-    addShine(packet->shineUid18);
-    addShine(packet->shineUid19);
-    addShine(packet->shineUid20);
-    addShine(packet->shineUid21);
-    addShine(packet->shineUid22);
-    addShine(packet->shineUid23);
-    addShine(packet->shineUid24);
-    addShine(packet->shineUid25);
-    addShine(packet->shineUid26);
-    addShine(packet->shineUid27);
-    addShine(packet->shineUid28);
-    addShine(packet->shineUid29);
-    addShine(packet->shineUid30);
-    addShine(packet->shineUid31);
-    addShine(packet->shineUid32);
-    addShine(packet->shineUid33);
-    addShine(packet->shineUid34);
-    addShine(packet->shineUid35);
-    addShine(packet->shineUid36);
-    addShine(packet->shineUid37);
-    addShine(packet->shineUid38);
-    addShine(packet->shineUid39);
-    addShine(packet->shineUid40);
-    addShine(packet->shineUid41);
-    addShine(packet->shineUid42);
-    addShine(packet->shineUid43);
-    addShine(packet->shineUid44);
-    addShine(packet->shineUid45);
-    addShine(packet->shineUid46);
-    addShine(packet->shineUid47);
-    addShine(packet->shineUid48);
-    addShine(packet->shineUid49);
-    addShine(packet->shineUid50);
-    addShine(packet->shineUid51);
-    addShine(packet->shineUid52);
-    addShine(packet->shineUid53);
-    addShine(packet->shineUid54);
-    addShine(packet->shineUid55);
-    addShine(packet->shineUid56);
-    addShine(packet->shineUid57);
-    addShine(packet->shineUid58);
-    addShine(packet->shineUid59);
-    addShine(packet->shineUid60);
-    addShine(packet->shineUid61);
-    addShine(packet->shineUid62);
-    addShine(packet->shineUid63);
-    addShine(packet->shineUid64);
-    addShine(packet->shineUid65);
-    addShine(packet->shineUid66);
-    addShine(packet->shineUid67);
-    addShine(packet->shineUid68);
-    addShine(packet->shineUid69);
-    addShine(packet->shineUid70);
-    addShine(packet->shineUid71);
-    addShine(packet->shineUid72);
-    addShine(packet->shineUid73);
-    addShine(packet->shineUid74);
-    addShine(packet->shineUid75);
-    addShine(packet->shineUid76);
-    addShine(packet->shineUid77);
-    addShine(packet->shineUid78);
-    addShine(packet->shineUid79);
-    addShine(packet->shineUid80);
-    addShine(packet->shineUid81);
-    addShine(packet->shineUid82);
-    addShine(packet->shineUid83);
-    addShine(packet->shineUid84);
-    addShine(packet->shineUid85);
-    addShine(packet->shineUid86);
-    addShine(packet->shineUid87);
-    addShine(packet->shineUid88);
-    addShine(packet->shineUid89);
-    addShine(packet->shineUid90);
-    addShine(packet->shineUid91);
-    addShine(packet->shineUid92);
-    addShine(packet->shineUid93);
-    addShine(packet->shineUid94);
-    addShine(packet->shineUid95);
-    addShine(packet->shineUid96);
-    addShine(packet->shineUid97);
-    addShine(packet->shineUid98);
-    addShine(packet->shineUid99);
+    for (s16 shineUid : packet->getEntries()) {
+        sInstance->collectedShines.set(shineUid);
+    }
 }
 
 int Client::getWorldUnlockCount(int worldId) {
@@ -1597,21 +1656,7 @@ void Client::addShine(int uid)
         return;
     }
 
-    int shines = sInstance->collectedShines[uid / 32];
-
-    int index = (uid / 32) * 32;
-    int i = 1;
-    while (i > 0) {
-        if (index == uid) {
-            shines = shines | i;
-            break;
-        }
-        i = i << 1;
-        index += 1;
-    }
-
-
-    sInstance->collectedShines[uid / 32] = shines;
+    sInstance->collectedShines.set(uid);
 }
 
 void Client::setRecentShine(Shine* curShine)
@@ -1630,65 +1675,73 @@ bool Client::hasShine(int uid)
         return false;
     }
 
-    int shines = sInstance->collectedShines[uid / 32];
-
-    int index = (uid / 32) * 32;
-    int i = 1;
-    while (i > 0) {
-        if (index == uid) {
-            shines = shines & i;
-            return (shines == i);
-        }
-        i = i << 1;
-        index += 1;
-    }
-    return false;
+    return sInstance->collectedShines.test(uid);
 }
 
-int Client::getShineChecks(int index)
+/**
+ * @brief forgets every shine, item and capture collected so far, for a new save file
+ */
+void Client::clearCollected()
 {
     if (!sInstance) {
         Logger::log("Static Instance is Null!\n");
-        return 0;
+        return;
     }
 
-    return sInstance->collectedShines[index];
+    sInstance->collectedShines.clear();
+    sInstance->collectedOutfits.clear();
+    sInstance->collectedStickers.clear();
+    sInstance->collectedSouvenirs.clear();
+    sInstance->collectedCaptures.clear();
 }
 
-void Client::setShineChecks(int index, int checks)
+/**
+ * @brief fills a raw SHINEBITMAP with every shine collected so far, sent on connect so the connector can send the
+ * checks it missed while we were offline
+ */
+void Client::writeShineBitmap(ShineBitmap* packet)
 {
     if (!sInstance) {
         Logger::log("Static Instance is Null!\n");
         return;
     }
 
-    sInstance->collectedShines[index] = checks;
+    packet->encoding = ENCODING_RAW;
+    packet->wordCount = SHINEBITMAPWORDS;
+    memcpy(packet->data, sInstance->collectedShines.getWords(), SHINEBITMAPSIZE);
+    packet->mPacketSize = SHINEBITMAPHEADERSIZE + SHINEBITMAPSIZE;
 }
 
-void Client::addOutfit(const ShopItem::ItemInfo *info)
+/**
+ * @brief merges the connector's bitmap of checked shines into ours, replacing a SHINECHECKS list of every uid
+ */
+void Client::updateShineBitmap(ShineBitmap* packet)
 {
     if (!sInstance) {
         Logger::log("Static Instance is Null!\n");
         return;
     }
 
-    int index = getIndexCostumeList(info->mName) + 44 * static_cast<int>(info->mType);
-
-    int outfits = sInstance->collectedOutfits[index / 8];
+    BundleReader reader(packet->data, packet->mPacketSize - SHINEBITMAPHEADERSIZE, packet->encoding == ENCODING_RLE);
 
-    int curIndex = (index / 8) * 8;
-    int i = 1;
-    while (i < 0x100) {
-        if (curIndex == index) {
-            outfits = outfits | i;
+    for (int i = 0; i < packet->wordCount; i++) {
+        u32 word = 0;
+        if (!reader.read(&word)) {
+            Logger::log("Shine bitmap was cut short at word %d!\n", i);
             break;
         }
-        i = i << 1;
-        curIndex += 1;
+        sInstance->collectedShines.mergeWord(i, word);
     }
+}
 
+void Client::addOutfit(const ShopItem::ItemInfo *info)
+{
+    if (!sInstance) {
+        Logger::log("Static Instance is Null!\n");
+        return;
+    }
 
-    sInstance->collectedOutfits[index / 8] = outfits;
+    sInstance->collectedOutfits.set(getIndexCostumeList(info->mName) + 44 * static_cast<int>(info->mType));
 }
 
 bool Client::hasOutfit(const ShopItem::ItemInfo *info)
@@ -1704,37 +1757,7 @@ bool Client::hasOutfit(const ShopItem::ItemInfo *info)
         return false;
     }
 
-    u8 outfits = sInstance->collectedOutfits[index / 8];
-
-    int curIndex = (index / 8) * 8;
-    int i = 1;
-    while (i < 0x100) {
-        if (curIndex == index) {
-            outfits = outfits & i;
-            return (outfits == i);
-        }
-        i = i << 1;
-        curIndex += 1;
-    }
-}
-
-int Client::getOutfitChecks(int index)
-{
-    if (!sInstance) {
-        Logger::log("Static Instance is Null!\n");
-        return 0;
-    }
-
-    return static_cast<int>(sInstance->collectedOutfits[index]);
-}
-
-void Client::setOutfitChecks(int index, int checks) {
-    if (!sInstance) {
-        Logger::log("Static Instance is Null!\n");
-        return;
-    }
-    u8 u8Checks = static_cast<u8>(checks);
-    sInstance->collectedOutfits[index] = u8Checks;
+    return sInstance->collectedOutfits.test(index);
 }
 
 void Client::addSticker(const ShopItem::ItemInfo *info)
@@ -1744,23 +1767,7 @@ void Client::addSticker(const ShopItem::ItemInfo *info)
         return;
     }
 
-    int index = getIndexStickerList(info->mName);
-
-    int stickers = sInstance->collectedStickers[index / 8];
-
-    int curIndex = (index / 8) * 8;
-    int i = 1;
-    while (i < 0x100) {
-        if (curIndex == index) {
-            stickers = stickers | i;
-            break;
-        }
-        i = i << 1;
-        curIndex += 1;
-    }
-
-
-    sInstance->collectedStickers[index / 8] = stickers;
+    sInstance->collectedStickers.set(getIndexStickerList(info->mName));
 }
 
 bool Client::hasSticker(const ShopItem::ItemInfo *info)
@@ -1776,36 +1783,7 @@ bool Client::hasSticker(const ShopItem::ItemInfo *info)
         return false;
     }
 
-    u8 stickers = sInstance->collectedStickers[index / 8];
-
-    int curIndex = (index / 8) * 8;
-    int i = 1;
-    while (i < 0x100) {
-        if (curIndex == index) {
-            stickers = stickers & i;
-            return (stickers == i);
-        }
-        i = i << 1;
-        curIndex += 1;
-    }
-}
-
-int Client::getStickerChecks(int index) {
-    if (!sInstance) {
-        Logger::log("Static Instance is Null!\n");
-        return 0;
-    }
-
-    return static_cast<int>(sInstance->collectedStickers[index]);
-}
-
-void Client::setStickerChecks(int index, int checks) {
-    if (!sInstance) {
-        Logger::log("Static Instance is Null!\n");
-        return;
-    }
-    u8 u8Checks = static_cast<u8>(checks);
-    sInstance->collectedStickers[index] = u8Checks;
+    return sInstance->collectedStickers.test(index);
 }
 
 void Client::addSouvenir(const ShopItem::ItemInfo *info)
@@ -1815,23 +1793,7 @@ void Client::addSouvenir(const ShopItem::ItemInfo *info)
         return;
     }
 
-    int index = getIndexSouvenirList(info->mName);
-
-    int souvenirs = sInstance->collectedSouvenirs[index / 8];
-
-    int curIndex = (index / 8) * 8;
-    int i = 1;
-    while (i < 0x100) {
-        if (curIndex == index) {
-            souvenirs = souvenirs | i;
-            break;
-        }
-        i = i << 1;
-        curIndex += 1;
-    }
-
-
-    sInstance->collectedSouvenirs[index / 8] = souvenirs;
+    sInstance->collectedSouvenirs.set(getIndexSouvenirList(info->mName));
 }
 
 bool Client::hasSouvenir(const ShopItem::ItemInfo *info)
@@ -1847,36 +1809,7 @@ bool Client::hasSouvenir(const ShopItem::ItemInfo *info)
         return false;
     }
 
-    u8 souvenirs = sInstance->collectedSouvenirs[index / 8];
-
-    int curIndex = (index / 8) * 8;
-    int i = 1;
-    while (i < 0x100) {
-        if (curIndex == index) {
-            souvenirs = souvenirs & i;
-            return (souvenirs == i);
-        }
-        i = i << 1;
-        curIndex += 1;
-    }
-}
-
-int Client::getSouvenirChecks(int index) {
-    if (!sInstance) {
-        Logger::log("Static Instance is Null!\n");
-        return 0;
-    }
-
-    return static_cast<int>(sInstance->collectedSouvenirs[index]);
-}
-
-void Client::setSouvenirChecks(int index, int checks) {
-    if (!sInstance) {
-        Logger::log("Static Instance is Null!\n");
-        return;
-    }
-    u8 u8Checks = static_cast<u8>(checks);
-    sInstance->collectedSouvenirs[index] = u8Checks;
+    return sInstance->collectedSouvenirs.test(index);
 }
 
 bool Client::hasItem(const ShopItem::ItemInfo* info)
@@ -1925,23 +1858,7 @@ void Client::addCapture(const char *capture)
         return;
     }
 
-    int index = getIndexCaptureList(capture);
-
-    int checkedCaptures = sInstance->collectedCaptures[index / 8];
-
-    int curIndex = (index / 8) * 8;
-    int i = 1;
-    while (i < 0x100) {
-        if (curIndex == index) {
-            checkedCaptures = checkedCaptures | i;
-            break;
-        }
-        i = i << 1;
-        curIndex += 1;
-    }
-
-
-    sInstance->collectedCaptures[index / 8] = checkedCaptures;
+    sInstance->collectedCaptures.set(getIndexCaptureList(capture));
 }
 
 bool Client::hasCapture(const char* capture) {
@@ -1961,38 +1878,7 @@ bool Client::hasCapture(const char* capture) {
         return false;
     }
 
-    u8 checkedCaptures = sInstance->collectedCaptures[index / 8];
-
-    int curIndex = (index / 8) * 8;
-    int i = 1;
-    while (i < 0x100) {
-        if (curIndex == index) {
-            checkedCaptures = checkedCaptures & i;
-            return (checkedCaptures == i);
-        }
-        i = i << 1;
-        curIndex += 1;
-    }
-    return false;
-}
-
-int Client::getCaptureChecks(int index) {
-    if (!sInstance) {
-        Logger::log("Static Instance is Null!\n");
-        return 0;
-    }
-
-    return static_cast<int>(sInstance->collectedCaptures[index]);
-}
-
-void Client::setCaptureChecks(int index, int checks) {
-    if (!sInstance) {
-        Logger::log("Static Instance is Null!\n");
-        return;
-    }
-
-    u8 u8Checks = static_cast<u8>(checks);
-    sInstance->collectedCaptures[index] = u8Checks;
+    return sInstance->collectedCaptures.test(index);
 }
 
 void Client::addCaptureCheck(const char* capture) {
@@ -2001,22 +1887,7 @@ void Client::addCaptureCheck(const char* capture) {
         return;
     }
 
-    int index = getIndexCaptureList(capture);
-
-    int checkedCaptures = sInstance->checkedCaptures[index / 8];
-
-    int curIndex = (index / 8) * 8;
-    int i = 1;
-    while (i < 0x100) {
-        if (curIndex == index) {
-            checkedCaptures = checkedCaptures | i;
-            break;
-        }
-        i = i << 1;
-        curIndex += 1;
-    }
-
-    sInstance->checkedCaptures[index / 8] = checkedCaptures;
+    sInstance->checkedCaptures.set(getIndexCaptureList(capture));
 }
 
 bool Client::hasCaptureCheck(const char* capture) {
@@ -2035,19 +1906,7 @@ bool Client::hasCaptureCheck(const char* capture) {
         return false;
     }
 
-    u8 checkedCaptures = sInstance->checkedCaptures[index / 8];
-
-    int curIndex = (index / 8) * 8;
-    int i = 1;
-    while (i < 0x100) {
-        if (curIndex == index) {
-            checkedCaptures = checkedCaptures & i;
-            return (checkedCaptures == i);
-        }
-        i = i << 1;
-        curIndex += 1;
-    }
-    return false;
+    return sInstance->checkedCaptures.test(index);
 }
 
 void Client::startShineCount() {
@@ -2226,6 +2085,7 @@ void Client::addApInfo(ApInfo* packet)
         }
     }
 
+    sInstance->mIsShopTextDirty = true;
 }
 
 void Client::updateShineReplace(ShineReplacePacket* packet)
@@ -2235,106 +2095,17 @@ void Client::updateShineReplace(ShineReplacePacket* packet)
         return;
     }
 
-    sInstance->shineTextReplacements[0] = {packet->itemType0, packet->itemNameIndex0};
-    sInstance->shineTextReplacements[1] = {packet->itemType1, packet->itemNameIndex1};
-    sInstance->shineTextReplacements[2] = {packet->itemType2, packet->itemNameIndex2};
-    sInstance->shineTextReplacements[3] = {packet->itemType3, packet->itemNameIndex3};
-    sInstance->shineTextReplacements[4] = {packet->itemType4, packet->itemNameIndex4};
-    sInstance->shineTextReplacements[5] = {packet->itemType5, packet->itemNameIndex5};
-    sInstance->shineTextReplacements[6] = {packet->itemType6, packet->itemNameIndex6};
-    sInstance->shineTextReplacements[7] = {packet->itemType7, packet->itemNameIndex7};
-    sInstance->shineTextReplacements[8] = {packet->itemType8, packet->itemNameIndex8};
-    sInstance->shineTextReplacements[9] = {packet->itemType9, packet->itemNameIndex9};
-    sInstance->shineTextReplacements[10] = {packet->itemType10, packet->itemNameIndex10};
-    sInstance->shineTextReplacements[11] = {packet->itemType11, packet->itemNameIndex11};
-    sInstance->shineTextReplacements[12] = {packet->itemType12, packet->itemNameIndex12};
-    sInstance->shineTextReplacements[13] = {packet->itemType13, packet->itemNameIndex13};
-    sInstance->shineTextReplacements[14] = {packet->itemType14, packet->itemNameIndex14};
-    sInstance->shineTextReplacements[15] = {packet->itemType15, packet->itemNameIndex15};
-    sInstance->shineTextReplacements[16] = {packet->itemType16, packet->itemNameIndex16};
-    sInstance->shineTextReplacements[17] = {packet->itemType17, packet->itemNameIndex17};
-    sInstance->shineTextReplacements[18] = {packet->itemType18, packet->itemNameIndex18};
-    sInstance->shineTextReplacements[19] = {packet->itemType19, packet->itemNameIndex19};
-    sInstance->shineTextReplacements[20] = {packet->itemType20, packet->itemNameIndex20};
-    sInstance->shineTextReplacements[21] = {packet->itemType21, packet->itemNameIndex21};
-    sInstance->shineTextReplacements[22] = {packet->itemType22, packet->itemNameIndex22};
-    sInstance->shineTextReplacements[23] = {packet->itemType23, packet->itemNameIndex23};
-    sInstance->shineTextReplacements[24] = {packet->itemType24, packet->itemNameIndex24};
-    sInstance->shineTextReplacements[25] = {packet->itemType25, packet->itemNameIndex25};
-    sInstance->shineTextReplacements[26] = {packet->itemType26, packet->itemNameIndex26};
-    sInstance->shineTextReplacements[27] = {packet->itemType27, packet->itemNameIndex27};
-    sInstance->shineTextReplacements[28] = {packet->itemType28, packet->itemNameIndex28};
-    sInstance->shineTextReplacements[29] = {packet->itemType29, packet->itemNameIndex29};
-    sInstance->shineTextReplacements[30] = {packet->itemType30, packet->itemNameIndex30};
-    sInstance->shineTextReplacements[31] = {packet->itemType31, packet->itemNameIndex31};
-    sInstance->shineTextReplacements[32] = {packet->itemType32, packet->itemNameIndex32};
-    sInstance->shineTextReplacements[33] = {packet->itemType33, packet->itemNameIndex33};
-    sInstance->shineTextReplacements[34] = {packet->itemType34, packet->itemNameIndex34};
-    sInstance->shineTextReplacements[35] = {packet->itemType35, packet->itemNameIndex35};
-    sInstance->shineTextReplacements[36] = {packet->itemType36, packet->itemNameIndex36};
-    sInstance->shineTextReplacements[37] = {packet->itemType37, packet->itemNameIndex37};
-    sInstance->shineTextReplacements[38] = {packet->itemType38, packet->itemNameIndex38};
-    sInstance->shineTextReplacements[39] = {packet->itemType39, packet->itemNameIndex39};
-    sInstance->shineTextReplacements[40] = {packet->itemType40, packet->itemNameIndex40};
-    sInstance->shineTextReplacements[41] = {packet->itemType41, packet->itemNameIndex41};
-    sInstance->shineTextReplacements[42] = {packet->itemType42, packet->itemNameIndex42};
-    sInstance->shineTextReplacements[43] = {packet->itemType43, packet->itemNameIndex43};
-    sInstance->shineTextReplacements[44] = {packet->itemType44, packet->itemNameIndex44};
-    sInstance->shineTextReplacements[45] = {packet->itemType45, packet->itemNameIndex45};
-    sInstance->shineTextReplacements[46] = {packet->itemType46, packet->itemNameIndex46};
-    sInstance->shineTextReplacements[47] = {packet->itemType47, packet->itemNameIndex47};
-    sInstance->shineTextReplacements[48] = {packet->itemType48, packet->itemNameIndex48};
-    sInstance->shineTextReplacements[49] = {packet->itemType49, packet->itemNameIndex49};
-    sInstance->shineTextReplacements[50] = {packet->itemType50, packet->itemNameIndex50};
-    sInstance->shineTextReplacements[51] = {packet->itemType51, packet->itemNameIndex51};
-    sInstance->shineTextReplacements[52] = {packet->itemType52, packet->itemNameIndex52};
-    sInstance->shineTextReplacements[53] = {packet->itemType53, packet->itemNameIndex53};
-    sInstance->shineTextReplacements[54] = {packet->itemType54, packet->itemNameIndex54};
-    sInstance->shineTextReplacements[55] = {packet->itemType55, packet->itemNameIndex55};
-    sInstance->shineTextReplacements[56] = {packet->itemType56, packet->itemNameIndex56};
-    sInstance->shineTextReplacements[57] = {packet->itemType57, packet->itemNameIndex57};
-    sInstance->shineTextReplacements[58] = {packet->itemType58, packet->itemNameIndex58};
-    sInstance->shineTextReplacements[59] = {packet->itemType59, packet->itemNameIndex59};
-    sInstance->shineTextReplacements[60] = {packet->itemType60, packet->itemNameIndex60};
-    sInstance->shineTextReplacements[61] = {packet->itemType61, packet->itemNameIndex61};
-    sInstance->shineTextReplacements[62] = {packet->itemType62, packet->itemNameIndex62};
-    sInstance->shineTextReplacements[63] = {packet->itemType63, packet->itemNameIndex63};
-    sInstance->shineTextReplacements[64] = {packet->itemType64, packet->itemNameIndex64};
-    sInstance->shineTextReplacements[65] = {packet->itemType65, packet->itemNameIndex65};
-    sInstance->shineTextReplacements[66] = {packet->itemType66, packet->itemNameIndex66};
-    sInstance->shineTextReplacements[67] = {packet->itemType67, packet->itemNameIndex67};
-    sInstance->shineTextReplacements[68] = {packet->itemType68, packet->itemNameIndex68};
-    sInstance->shineTextReplacements[69] = {packet->itemType69, packet->itemNameIndex69};
-    sInstance->shineTextReplacements[70] = {packet->itemType70, packet->itemNameIndex70};
-    sInstance->shineTextReplacements[71] = {packet->itemType71, packet->itemNameIndex71};
-    sInstance->shineTextReplacements[72] = {packet->itemType72, packet->itemNameIndex72};
-    sInstance->shineTextReplacements[73] = {packet->itemType73, packet->itemNameIndex73};
-    sInstance->shineTextReplacements[74] = {packet->itemType74, packet->itemNameIndex74};
-    sInstance->shineTextReplacements[75] = {packet->itemType75, packet->itemNameIndex75};
-    sInstance->shineTextReplacements[76] = {packet->itemType76, packet->itemNameIndex76};
-    sInstance->shineTextReplacements[77] = {packet->itemType77, packet->itemNameIndex77};
-    sInstance->shineTextReplacements[78] = {packet->itemType78, packet->itemNameIndex78};
-    sInstance->shineTextReplacements[79] = {packet->itemType79, packet->itemNameIndex79};
-    sInstance->shineTextReplacements[80] = {packet->itemType80, packet->itemNameIndex80};
-    sInstance->shineTextReplacements[81] = {packet->itemType81, packet->itemNameIndex81};
-    sInstance->shineTextReplacements[82] = {packet->itemType82, packet->itemNameIndex82};
-    sInstance->shineTextReplacements[83] = {packet->itemType83, packet->itemNameIndex83};
-    sInstance->shineTextReplacements[84] = {packet->itemType84, packet->itemNameIndex84};
-    sInstance->shineTextReplacements[85] = {packet->itemType85, packet->itemNameIndex85};
-    sInstance->shineTextReplacements[86] = {packet->itemType86, packet->itemNameIndex86};
-    sInstance->shineTextReplacements[87] = {packet->itemType87, packet->itemNameIndex87};
-    sInstance->shineTextReplacements[88] = {packet->itemType88, packet->itemNameIndex88};
-    sInstance->shineTextReplacements[89] = {packet->itemType89, packet->itemNameIndex89};
-    sInstance->shineTextReplacements[90] = {packet->itemType90, packet->itemNameIndex90};
-    sInstance->shineTextReplacements[91] = {packet->itemType91, packet->itemNameIndex91};
-    sInstance->shineTextReplacements[92] = {packet->itemType92, packet->itemNameIndex92};
-    sInstance->shineTextReplacements[93] = {packet->itemType93, packet->itemNameIndex93};
-    sInstance->shineTextReplacements[94] = {packet->itemType94, packet->itemNameIndex94};
-    sInstance->shineTextReplacements[95] = {packet->itemType95, packet->itemNameIndex95};
-    sInstance->shineTextReplacements[96] = {packet->itemType96, packet->itemNameIndex96};
-    sInstance->shineTextReplacements[97] = {packet->itemType97, packet->itemNameIndex97};
-    sInstance->shineTextReplacements[98] = {packet->itemType98, packet->itemNameIndex98};
-    sInstance->shineTextReplacements[99] = {packet->itemType99, packet->itemNameIndex99};
+    int index = 0;
+    for (ShineReplaceEntry entry : packet->getEntries()) {
+        if (index >= sInstance->shineTextReplacements.size())
+            break;
+        sInstance->shineTextReplacements[index++] = {entry.itemType, entry.itemNameIndex};
+    }
+
+    // the packet only carries the new kingdom's entries, anything past them still belongs to the previous one
+    for (; index < sInstance->shineTextReplacements.size(); index++) {
+        sInstance->shineTextReplacements[index] = {0, 0};
+    }
 }
 
 void Client::updateShineColor(ShineColor* packet)
@@ -2343,91 +2114,11 @@ void Client::updateShineColor(ShineColor* packet)
         Logger::log("Static Instance is Null!\n");
         return;
     }
-    //setMessage(1, "Entering udpateShineColor");
-    sInstance->shineColors[static_cast<int>(packet->shineUid0)] = packet->color0;
-    sInstance->shineColors[static_cast<int>(packet->shineUid1)] = packet->color1;
-    sInstance->shineColors[static_cast<int>(packet->shineUid2)] = packet->color2;
-    sInstance->shineColors[static_cast<int>(packet->shineUid3)] = packet->color3;
-    sInstance->shineColors[static_cast<int>(packet->shineUid4)] = packet->color4;
-    sInstance->shineColors[static_cast<int>(packet->shineUid5)] = packet->color5;
-    sInstance->shineColors[static_cast<int>(packet->shineUid6)] = packet->color6;
-    sInstance->shineColors[static_cast<int>(packet->shineUid7)] = packet->color7;
-    sInstance->shineColors[static_cast<int>(packet->shineUid8)] = packet->color8;
-    sInstance->shineColors[static_cast<int>(packet->shineUid9)] = packet->color9;
-    sInstance->shineColors[static_cast<int>(packet->shineUid10)] = packet->color10;
-    sInstance->shineColors[static_cast<int>(packet->shineUid11)] = packet->color11;
-    sInstance->shineColors[static_cast<int>(packet->shineUid12)] = packet->color12;
-    sInstance->shineColors[static_cast<int>(packet->shineUid13)] = packet->color13;
-    sInstance->shineColors[static_cast<int>(packet->shineUid14)] = packet->color14;
-    sInstance->shineColors[static_cast<int>(packet->shineUid15)] = packet->color15;
-    sInstance->shineColors[static_cast<int>(packet->shineUid16)] = packet->color16;
-    sInstance->shineColors[static_cast<int>(packet->shineUid17)] = packet->color17;
-    sInstance->shineColors[static_cast<int>(packet->shineUid18)] = packet->color18;
-    sInstance->shineColors[static_cast<int>(packet->shineUid19)] = packet->color19;
-    sInstance->shineColors[static_cast<int>(packet->shineUid20)] = packet->color20;
-    sInstance->shineColors[static_cast<int>(packet->shineUid21)] = packet->color21;
-    sInstance->shineColors[static_cast<int>(packet->shineUid22)] = packet->color22;
-    sInstance->shineColors[static_cast<int>(packet->shineUid23)] = packet->color23;
-    sInstance->shineColors[static_cast<int>(packet->shineUid24)] = packet->color24;
-    sInstance->shineColors[static_cast<int>(packet->shineUid25)] = packet->color25;
-    sInstance->shineColors[static_cast<int>(packet->shineUid26)] = packet->color26;
-    sInstance->shineColors[static_cast<int>(packet->shineUid27)] = packet->color27;
-    sInstance->shineColors[static_cast<int>(packet->shineUid28)] = packet->color28;
-    sInstance->shineColors[static_cast<int>(packet->shineUid29)] = packet->color29;
-    sInstance->shineColors[static_cast<int>(packet->shineUid30)] = packet->color30;
-    sInstance->shineColors[static_cast<int>(packet->shineUid31)] = packet->color31;
-    sInstance->shineColors[static_cast<int>(packet->shineUid32)] = packet->color32;
-    sInstance->shineColors[static_cast<int>(packet->shineUid33)] = packet->color33;
-    sInstance->shineColors[static_cast<int>(packet->shineUid34)] = packet->color34;
-    sInstance->shineColors[static_cast<int>(packet->shineUid35)] = packet->color35;
-    sInstance->shineColors[static_cast<int>(packet->shineUid36)] = packet->color36;
-    sInstance->shineColors[static_cast<int>(packet->shineUid37)] = packet->color37;
-    sInstance->shineColors[static_cast<int>(packet->shineUid38)] = packet->color38;
-    sInstance->shineColors[static_cast<int>(packet->shineUid39)] = packet->color39;
-    sInstance->shineColors[static_cast<int>(packet->shineUid40)] = packet->color40;
-    sInstance->shineColors[static_cast<int>(packet->shineUid41)] = packet->color41;
-    sInstance->shineColors[static_cast<int>(packet->shineUid42)] = packet->color42;
-    sInstance->shineColors[static_cast<int>(packet->shineUid43)] = packet->color43;
-    sInstance->shineColors[static_cast<int>(packet->shineUid44)] = packet->color44;
-    sInstance->shineColors[static_cast<int>(packet->shineUid45)] = packet->color45;
-    sInstance->shineColors[static_cast<int>(packet->shineUid46)] = packet->color46;
-    sInstance->shineColors[static_cast<int>(packet->shineUid47)] = packet->color47;
-    sInstance->shineColors[static_cast<int>(packet->shineUid48)] = packet->color48;
-    sInstance->shineColors[static_cast<int>(packet->shineUid49)] = packet->color49;
-    sInstance->shineColors[static_cast<int>(packet->shineUid50)] = packet->color50;
-    //sInstance->shineColors[static_cast<int>(packet->shineUid51)] = packet->color51;
-    //sInstance->shineColors[static_cast<int>(packet->shineUid52)] = packet->color52;
-    //sInstance->shineColors[static_cast<int>(packet->shineUid53)] = packet->color53;
-    //sInstance->shineColors[static_cast<int>(packet->shineUid54)] = packet->color54;
-    //sInstance->shineColors[static_cast<int>(packet->shineUid55)] = packet->color55;
-    //sInstance->shineColors[static_cast<int>(packet->shineUid56)] = packet->color56;
-    //sInstance->shineColors[static_cast<int>(packet->shineUid57)] = packet->color57;
-    //sInstance->shineColors[static_cast<int>(packet->shineUid58)] = packet->color58;
-    //sInstance->shineColors[static_cast<int>(packet->shineUid59)] = packet->color59;
-    //sInstance->shineColors[static_cast<int>(packet->shineUid60)] = packet->color60;
-    //sInstance->shineColors[static_cast<int>(packet->shineUid61)] = packet->color61;
-    //sInstance->shineColors[static_cast<int>(packet->shineUid62)] = packet->color62;
-    //sInstance->shineColors[static_cast<int>(packet->shineUid63)] = packet->color63;
-    //sInstance->shineColors[static_cast<int>(packet->shineUid64)] = packet->color64;
-    //sInstance->shineColors[static_cast<int>(packet->shineUid65)] = packet->color65;
-    //sInstance->shineColors[static_cast<int>(packet->shineUid66)] = packet->color66;
-    //sInstance->shineColors[static_cast<int>(packet->shineUid67)] = packet->color67;
-    //sInstance->shineColors[static_cast<int>(packet->shineUid68)] = packet->color68;
-    //sInstance->shineColors[static_cast<int>(packet->shineUid69)] = packet->color69;
-    //sInstance->shineColors[static_cast<int>(packet->shineUid70)] = packet->color70;
-    //sInstance->shineColors[static_cast<int>(packet->shineUid71)] = packet->color71;
-    //sInstance->shineColors[static_cast<int>(packet->shineUid72)] = packet->color72;
-    //sInstance->shineColors[static_cast<int>(packet->shineUid73)] = packet->color73;
-    //sInstance->shineColors[static_cast<int>(packet->shineUid74)] = packet->color74;
-    //sInstance->shineColors[static_cast<int>(packet->shineUid75)] = packet->color75;
-    //sInstance->shineColors[static_cast<int>(packet->shineUid76)] = packet->color76;
-    //sInstance->shineColors[static_cast<int>(packet->shineUid77)] = packet->color77;
-    //sInstance->shineColors[static_cast<int>(packet->shineUid78)] = packet->color78;
-    //sInstance->shineColors[static_cast<int>(packet->shineUid79)] = packet->color79;
-    //sInstance->shineColors[static_cast<int>(packet->shineUid80)] = packet->color80;
-    //sInstance->shineColors[static_cast<int>(packet->shineUid81)] = packet->color81;
-    //sInstance->shineColors[static_cast<int>(packet->shineUid82)] = packet->color82;
-    //sInstance->shineColors[static_cast<int>(packet->shineUid83)] = packet->color83;
+
+    for (ShineColorEntry entry : packet->getEntries()) {
+        if (entry.shineUid >= 0 && entry.shineUid < sInstance->shineColors.size())
+            sInstance->shineColors[entry.shineUid] = entry.color;
+    }
 }
 
 void Client::updateShopReplace(ShopReplacePacket* packet)
@@ -2850,92 +2541,95 @@ void Client::updateShopReplace(ShopReplacePacket* packet)
                                                    packet->itemClassification12};
     }
 
+    sInstance->mIsShopTextDirty = true;
 }
 
-const char* Client::getShineReplacementText() 
-{
-    if (!sInstance) {
-        Logger::log("Static Instance is Null!\n");
-        return "";
+/**
+ * @brief fills mHintArts from worldHintArts, picking the Dark Side hint art for the current main stage
+ *
+ * @param accessor
+ */
+void Client::resolveHintArts(GameDataHolderAccessor accessor) {
+    memcpy(mHintArts, worldHintArts, sizeof(mHintArts));
+
+    int mainWorldId = getIndexWorldHomeStage(GameDataFunction::tryGetCurrentMainStageName(accessor));
+    mHintArts[GameDataFunction::getWorldIndexSpecial1()].shineUid = mainWorldId < 0 ? 0 : darkSideHintArtUids[mainWorldId];
+}
+
+/**
+ * @brief finds the hint art a moon without a uid of its own belongs to
+ *
+ * @param curShine
+ * @return hint art of the kingdom in the shine's info, nullptr if that kingdom has none
+ */
+const hintArtInfo* Client::findHintArt(Shine* curShine) const {
+    int worldId = getIndexWorldHomeStage(curShine->curShineInfo->stageName.cstr());
+    if (worldId < 0 || mHintArts[worldId].shineUid == 0) {
+        return nullptr;
     }
+    return &mHintArts[worldId];
+}
 
-    GameDataHolderAccessor accessor(sInstance->mCurStageScene);
+/**
+ * @brief resolves a shine's uid and label index, once per stage
+ *
+ * @param curShine
+ * @return the cached entry, resolved now if this is the first lookup of the shine since the stage loaded
+ */
+stageShineInfo Client::findStageShineInfo(Shine* curShine) {
+    bool isCacheable = (u32)curShine->mShineIdx < SHINEHINTCOUNT;
+    if (isCacheable && mStageShines[curShine->mShineIdx].shineUid >= 0) {
+        return mStageShines[curShine->mShineIdx];
+    }
 
-    Shine* curShine = sInstance->recentShine;
+    GameDataHolderAccessor accessor(mCurStageScene);
 
     GameDataFile::HintInfo* info =
         &accessor.mData->mGameDataFile->mShineHintList[curShine->mShineIdx];
 
-    shineReplaceText curReplaceText;
+    stageShineInfo result = {(s16)info->mUniqueID, (s16)info->mHintIdx};
 
+    // Hint arts Uid is 0 on the moon object in the other world.
+    // Stage name in the shine info is still the kingdom the hint art comes from.
     if (info->mUniqueID == 0) {
-        if (strcmp(curShine->curShineInfo->stageName.cstr(), "CapWorldHomeStage") == 0) {
-            curReplaceText = sInstance->shineTextReplacements[98];
-        }
-        if (strcmp(curShine->curShineInfo->stageName.cstr(), "SandWorldHomeStage") == 0) {
-            curReplaceText = sInstance->shineTextReplacements[98];
-        }
-        if (strcmp(curShine->curShineInfo->stageName.cstr(), "LakeWorldHomeStage") == 0) {
-            curReplaceText = sInstance->shineTextReplacements[98];
-        }
-        if (strcmp(curShine->curShineInfo->stageName.cstr(), "ForestWorldHomeStage") == 0) {
-            curReplaceText = sInstance->shineTextReplacements[98];
-        }
-        if (strcmp(curShine->curShineInfo->stageName.cstr(), "CityWorldHomeStage") == 0) {
-            curReplaceText = sInstance->shineTextReplacements[98];
-        }
-        if (strcmp(curShine->curShineInfo->stageName.cstr(), "SnowWorldHomeStage") == 0) {
-            curReplaceText = sInstance->shineTextReplacements[98];
-        }
-        if (strcmp(curShine->curShineInfo->stageName.cstr(), "SeaWorldHomeStage") == 0) {
-            curReplaceText = sInstance->shineTextReplacements[98];
-        }
-        if (strcmp(curShine->curShineInfo->stageName.cstr(), "LavaWorldHomeStage") == 0) {
-            curReplaceText = sInstance->shineTextReplacements[98];
-        }
-        if (strcmp(curShine->curShineInfo->stageName.cstr(), "SkyWorldHomeStage") == 0) {
-            curReplaceText = sInstance->shineTextReplacements[99];
-        }
-        if (strcmp(curShine->curShineInfo->stageName.cstr(), "MoonWorldHomeStage") == 0) {
-            curReplaceText = sInstance->shineTextReplacements[98];
-        }
-        if (strcmp(curShine->curShineInfo->stageName.cstr(), "PeachWorldHomeStage") == 0) {
-            curReplaceText = sInstance->shineTextReplacements[98];
-        }
-        if (strcmp(curShine->curShineInfo->stageName.cstr(), "Special1WorldHomeStage") == 0) {
-            if (strcmp(GameDataFunction::tryGetCurrentMainStageName(accessor), "WaterfallWorldHomeStage") == 0) {
-                curReplaceText = sInstance->shineTextReplacements[99];
-            }
-            if (strcmp(GameDataFunction::tryGetCurrentMainStageName(accessor), "LakeWorldHomeStage") == 0) {
-                curReplaceText = sInstance->shineTextReplacements[99];
-            }
-            if (strcmp(GameDataFunction::tryGetCurrentMainStageName(accessor), "CloudWorldHomeStage") == 0) {
-                curReplaceText = sInstance->shineTextReplacements[99];
-            }
-            if (strcmp(GameDataFunction::tryGetCurrentMainStageName(accessor), "ClashWorldHomeStage") == 0) {
-                curReplaceText = sInstance->shineTextReplacements[99];
-            }
-            if (strcmp(GameDataFunction::tryGetCurrentMainStageName(accessor), "CityWorldHomeStage") == 0) {
-                curReplaceText = sInstance->shineTextReplacements[99];
-            }
-            if (strcmp(GameDataFunction::tryGetCurrentMainStageName(accessor), "SnowWorldHomeStage") == 0) {
-                curReplaceText = sInstance->shineTextReplacements[99];
-            }
-            if (strcmp(GameDataFunction::tryGetCurrentMainStageName(accessor), "SeaWorldHomeStage") == 0) {
-                curReplaceText = sInstance->shineTextReplacements[99];
-            }
-            if (strcmp(GameDataFunction::tryGetCurrentMainStageName(accessor), "LavaWorldHomeStage") == 0) {
-                curReplaceText = sInstance->shineTextReplacements[99];
-            }
-            if (strcmp(GameDataFunction::tryGetCurrentMainStageName(accessor), "BossRaidWorldHomeStage") == 0) {
-                curReplaceText = sInstance->shineTextReplacements[99];
-            }
-            if (strcmp(GameDataFunction::tryGetCurrentMainStageName(accessor), "PeachWorldHomeStage") == 0) {
-                curReplaceText = sInstance->shineTextReplacements[99];
-            }
-        }
-    } else {
-        curReplaceText = sInstance->shineTextReplacements[info->mHintIdx];
+        const hintArtInfo* hintArt = findHintArt(curShine);
+        result = hintArt ? stageShineInfo{hintArt->shineUid, hintArt->textIndex} : stageShineInfo{0, -1};
+    }
+
+    if (isCacheable) {
+        mStageShines[curShine->mShineIdx] = result;
+    }
+    return result;
+}
+
+/**
+ * @brief uid of the shine, hint art moons get the uid of the hint art they came from
+ *
+ * @param curShine
+ * @return the uid, 0 if it's a hint art moon without a known hint art
+ */
+int Client::getShineUid(Shine* curShine)
+{
+    if (!sInstance) {
+        Logger::log("Static Instance is Null!\n");
+        return 0;
+    }
+
+    return sInstance->findStageShineInfo(curShine).shineUid;
+}
+
+const char* Client::getShineReplacementText() 
+{
+    if (!sInstance) {
+        Logger::log("Static Instance is Null!\n");
+        return "";
+    }
+
+    stageShineInfo shine = sInstance->findStageShineInfo(sInstance->recentShine);
+
+    shineReplaceText curReplaceText = {-1, 255};
+    if (shine.textIndex >= 0) {
+        curReplaceText = sInstance->shineTextReplacements[shine.textIndex];
     }
 
     //setMessage(1, intToCstr(info->mHintIdx));
@@ -2957,113 +2651,131 @@ int Client::getShineColor(Shine* curShine)
         return 99;
     }
 
-    GameDataHolderAccessor accessor(sInstance->mCurStageScene);
+    int shineUid = sInstance->findStageShineInfo(curShine).shineUid;
+    if (shineUid == 0) {
+        return 99;
+    }
+    return static_cast<int>(sInstance->shineColors[shineUid]);
+}
 
-    GameDataFile::HintInfo* info =
-        &accessor.mData->mGameDataFile->mShineHintList[curShine->mShineIdx];
+/**
+ * @brief finds where an item's text lives in the shop text arena
+ *
+ * @param fileName message file the shop reads the item from, ItemCap, ItemCloth, ItemSticker, ItemGift or ItemMoon
+ * @param itemName key of the item without the _Explain suffix
+ * @return index of the item, -1 if it isn't one of ours
+ */
+int Client::findShopItemIndex(const char* fileName, const char* itemName) const {
+    int firstItem = 0;
+    int count = 0;
+    int listIndex = -1;
+
+    if (strcmp("ItemCap", fileName) == 0) {
+        count = shopCapTextReplacements.size();
+        listIndex = getIndexCostumeList(itemName) - 1;
+    } else if (strcmp("ItemCloth", fileName) == 0) {
+        firstItem = shopCapTextReplacements.size();
+        count = shopClothTextReplacements.size();
+        listIndex = getIndexCostumeList(itemName) - 1;
+    } else if (strcmp("ItemSticker", fileName) == 0) {
+        firstItem = shopCapTextReplacements.size() + shopClothTextReplacements.size();
+        count = shopStickerTextReplacements.size();
+        listIndex = getIndexStickerList(itemName);
+    } else if (strcmp("ItemGift", fileName) == 0) {
+        firstItem = shopCapTextReplacements.size() + shopClothTextReplacements.size() + shopStickerTextReplacements.size();
+        count = shopGiftTextReplacements.size();
+        listIndex = getIndexSouvenirList(itemName);
+    } else if (strcmp("ItemMoon", fileName) == 0) {
+        // Find out key for each kingdom as still is unknown
+        firstItem = SHOPITEMCOUNT - shopMoonTextReplacements.size();
+        count = shopMoonTextReplacements.size();
+        listIndex = getIndexMoonItemList(itemName);
+    }
 
-    
-    // Hint arts Uid is 0 on the moon object in the other world.
-    // Stage name in the shine info is still the kingdom the hint art comes from.
-    if (info->mUniqueID == 0) {
-        if (strcmp(curShine->curShineInfo->stageName.cstr(), "CapWorldHomeStage") == 0) {
-            return static_cast<int>(sInstance->shineColors[1086]);
-        }
-        if (strcmp(curShine->curShineInfo->stageName.cstr(), "SandWorldHomeStage") == 0) {
-            return static_cast<int>(sInstance->shineColors[1096]);
-        }
-        if (strcmp(curShine->curShineInfo->stageName.cstr(), "LakeWorldHomeStage") == 0) {
-            return static_cast<int>(sInstance->shineColors[1094]);
-        }
-        if (strcmp(curShine->curShineInfo->stageName.cstr(), "ForestWorldHomeStage") == 0) {
-            return static_cast<int>(sInstance->shineColors[1089]);
-        }
-        if (strcmp(curShine->curShineInfo->stageName.cstr(), "CityWorldHomeStage") == 0) {
-            return static_cast<int>(sInstance->shineColors[1088]);
-        }
-        if (strcmp(curShine->curShineInfo->stageName.cstr(), "SnowWorldHomeStage") == 0) {
-            return static_cast<int>(sInstance->shineColors[1087]);
-        }
-        if (strcmp(curShine->curShineInfo->stageName.cstr(), "SeaWorldHomeStage") == 0) {
-            return static_cast<int>(sInstance->shineColors[1095]);
-        }
-        if (strcmp(curShine->curShineInfo->stageName.cstr(), "LavaWorldHomeStage") == 0) {
-            return static_cast<int>(sInstance->shineColors[1090]);
-        }
-        if (strcmp(curShine->curShineInfo->stageName.cstr(), "SkyWorldHomeStage") == 0) {
-            return static_cast<int>(sInstance->shineColors[1091]);
-        }
-        if (strcmp(curShine->curShineInfo->stageName.cstr(), "MoonWorldHomeStage") == 0) {
-            return static_cast<int>(sInstance->shineColors[1165]);
-        }
-        if (strcmp(curShine->curShineInfo->stageName.cstr(), "PeachWorldHomeStage") == 0) {
-            return static_cast<int>(sInstance->shineColors[1152]);
+    // Not included items like Life Up Hearts
+    if (listIndex < 0 || listIndex >= count) {
+        return -1;
+    }
+    return firstItem + listIndex;
+}
+
+const shopReplaceText& Client::getShopItem(int shopItemIndex) const {
+    int index = shopItemIndex;
+    if (index < shopCapTextReplacements.size())
+        return shopCapTextReplacements[index];
+    index -= shopCapTextReplacements.size();
+    if (index < shopClothTextReplacements.size())
+        return shopClothTextReplacements[index];
+    index -= shopClothTextReplacements.size();
+    if (index < shopStickerTextReplacements.size())
+        return shopStickerTextReplacements[index];
+    index -= shopStickerTextReplacements.size();
+    if (index < shopGiftTextReplacements.size())
+        return shopGiftTextReplacements[index];
+    index -= shopGiftTextReplacements.size();
+    return shopMoonTextReplacements[index];
+}
+
+void Client::renderShopText(sead::WFixedSafeString<SHOPTEXTSIZE>& message, const shopReplaceText& item, bool isExplain) const {
+    message = message.cEmptyString;
+
+    if (isExplain)
+    {
+        message.append(u"Comes from the world of ");
+        message.append(apGameNames[item.gameIndex].cstr());
+        message.append(u".\nSeems to belong to ");
+        message.append(apSlotNames[item.slotIndex].cstr());
+        message.append(u".\n");
+        if (item.itemClassification == 0) {
+            message.append(u"It looks like junk, but may as well ask...");
+        } else if (item.itemClassification == 0b0010) {
+            message.append(u"It looks useful.");
+        } else if (item.itemClassification == 254) {
+            message.append(u"Error or Not in the Item Pool.");
         }
-        if (strcmp(curShine->curShineInfo->stageName.cstr(), "Special1WorldHomeStage") == 0) {
-            // Add conditions for other Dark Side hint arts
-            if (strcmp(GameDataFunction::tryGetCurrentMainStageName(accessor),
-                       "WaterfallWorldHomeStage") == 0) {
-                return static_cast<int>(sInstance->shineColors[1132]);
-            }
-            if (strcmp(GameDataFunction::tryGetCurrentMainStageName(accessor),
-                       "LakeWorldHomeStage") == 0) {
-                return static_cast<int>(sInstance->shineColors[1128]);
-            }
-            if (strcmp(GameDataFunction::tryGetCurrentMainStageName(accessor),
-                       "CloudWorldHomeStage") == 0) {
-                return static_cast<int>(sInstance->shineColors[1124]);
-            }
-            if (strcmp(GameDataFunction::tryGetCurrentMainStageName(accessor),
-                       "ClashWorldHomeStage") == 0) {
-                return static_cast<int>(sInstance->shineColors[1126]);
-            }
-            if (strcmp(GameDataFunction::tryGetCurrentMainStageName(accessor),
-                       "CityWorldHomeStage") == 0) {
-                return static_cast<int>(sInstance->shineColors[1130]);
-            }
-            if (strcmp(GameDataFunction::tryGetCurrentMainStageName(accessor),
-                       "SnowWorldHomeStage") == 0) {
-                return static_cast<int>(sInstance->shineColors[1129]);
-            }
-            if (strcmp(GameDataFunction::tryGetCurrentMainStageName(accessor),
-                       "SeaWorldHomeStage") == 0) {
-                return static_cast<int>(sInstance->shineColors[1127]);
-            }
-            if (strcmp(GameDataFunction::tryGetCurrentMainStageName(accessor),
-                       "LavaWorldHomeStage") == 0) {
-                return static_cast<int>(sInstance->shineColors[1123]);
-            }
-            if (strcmp(GameDataFunction::tryGetCurrentMainStageName(accessor),
-                       "BossRaidWorldHomeStage") == 0) {
-                return static_cast<int>(sInstance->shineColors[1125]);
-            }
-            if (strcmp(GameDataFunction::tryGetCurrentMainStageName(accessor),
-                       "PeachWorldHomeStage") == 0) {
-                return static_cast<int>(sInstance->shineColors[1131]);
-            }
-            
+        else {
+            message.append(u"It looks really important!");
         }
     } else {
-        /*sead::FixedSafeString<40> shineData;
-        shineData = "";
-        shineData.append("Uid: ");
-        shineData.append(intToCstr(info->mUniqueID));
-        shineData.append(" Color: ");
-        shineData.append(intToCstr(sInstance->shineColors[info->mUniqueID]));
+        message.append(apItemNames[item.apItemNameIndex].cstr());
+    }
+}
+
+/**
+ * @brief renders the name and explain text of every shop item into mShopText
+ */
+void Client::rebuildShopText() {
+    static_assert(sizeof(shopCapTextReplacements) + sizeof(shopClothTextReplacements) + sizeof(shopStickerTextReplacements) +
+                  sizeof(shopGiftTextReplacements) + sizeof(shopMoonTextReplacements) == SHOPITEMCOUNT * sizeof(shopReplaceText),
+                  "SHOPITEMCOUNT doesn't match the shop text replacements");
+
+    sead::WFixedSafeString<SHOPTEXTSIZE> message;
 
-        setMessage(1, shineData.cstr());
-        shineData = "";
-        shineData.append("Uid: ");
-        shineData.append(intToCstr(1145));
-        shineData.append(" Color: ");
-        shineData.append(intToCstr(sInstance->shineColors[1145]));
+    u32 offset = 0;
+    for (int i = 0; i < SHOPITEMCOUNT * 2; i++) {
+        renderShopText(message, getShopItem(i / 2), i % 2);
 
-        setMessage(2, shineData.cstr());*/
-        return static_cast<int>(sInstance->shineColors[info->mUniqueID]);
+        u32 length = message.calcLength() + 1;
+        if (offset + length > SHOPITEMCOUNT * SHOPITEMTEXTSIZE) {
+            // can't happen with names from apGameNames and co, but an empty string beats running off the end
+            Logger::log("Shop text %d doesn't fit!\n", i);
+            message = message.cEmptyString;
+            length = 1;
+        }
+
+        memcpy(mShopText + offset, message.cstr(), length * sizeof(char16));
+        mShopTextOffsets[i] = offset;
+        offset += length;
     }
-    return 99;
 }
 
+/**
+ * @brief shop name or explain text of an item, rendered when its data last changed
+ *
+ * @param fileName
+ * @param key
+ * @return the text, stays valid until the shop data changes again. Empty if it isn't one of our items
+ */
 const char16_t* Client::getShopReplacementText(const char* fileName, const char* key) 
 {
     if (!sInstance) {
@@ -3071,83 +2783,21 @@ const char16_t* Client::getShopReplacementText(const char* fileName, const char*
         return u"";
     }
 
-    sead::WFixedSafeString<200> message;
-    message = message.cEmptyString;
-    bool isExplain = false;
     sead::FixedSafeString<40> convert;
     convert = "";
     convert.append(key);
-    if (convert.calcLength() != convert.removeSuffix("_Explain")) {
-        isExplain = true;
-    }
-    shopReplaceText curItem = {255,255,255,255};
+    bool isExplain = convert.calcLength() != convert.removeSuffix("_Explain");
 
-    if (strcmp("ItemCap", fileName) == 0)
-    {
-        curItem = sInstance->shopCapTextReplacements[getIndexCostumeList(convert.cstr()) - 1];
-    }
-    else if (strcmp("ItemCloth", fileName) == 0) 
-    {
-        curItem = sInstance->shopClothTextReplacements[getIndexCostumeList(convert.cstr()) - 1];
-    }
-    else if (strcmp("ItemSticker", fileName) == 0) 
-    {
-        curItem = sInstance->shopStickerTextReplacements[getIndexStickerList(convert.cstr())];
-    }
-    else if (strcmp("ItemGift", fileName) == 0) 
-    {
-        curItem = sInstance->shopGiftTextReplacements[getIndexSouvenirList(convert.cstr())];
-    }
-    else if (strcmp("ItemMoon", fileName) == 0) 
-    {
-        // Find out key for each kingdom as still is unknown
-        curItem = sInstance->shopMoonTextReplacements[getIndexMoonItemList(convert.cstr())];
-    } else {
-        // Not included items like Life Up Hearts
+    int shopItemIndex = sInstance->findShopItemIndex(fileName, convert.cstr());
+    if (shopItemIndex < 0 || !sInstance->mShopText) {
         return u"";
     }
 
-    if (curItem.gameIndex == 254)
-    {
-        //setMessage(1, "No Item Data Received.");
+    if (sInstance->mIsShopTextDirty.exchange(false)) {
+        sInstance->rebuildShopText();
     }
 
-    if (isExplain)
-    {
-        message.append(u"Comes from the world of ");
-        //if (sInstance->apGameNames[curItem.gameIndex].isEmpty()) {
-            message.append(sInstance->apGameNames[curItem.gameIndex].cstr());
-        //} else {
-            //message.append(u"Missing Game");
-       // }
-
-        message.append(u".\nSeems to belong to ");
-        //if (sInstance->apSlotNames[curItem.slotIndex].isEmpty()) {
-            message.append(sInstance->apSlotNames[curItem.slotIndex].cstr());
-        //} else {
-            //message.append(u"Missing Slot Name");
-        //}
-        message.append(u".\n");
-        if (curItem.itemClassification == 0) {
-            message.append(u"It looks like junk, but may as well ask...");
-        } else if (curItem.itemClassification == 0b0010) {
-            message.append(u"It looks useful.");
-           
-        } else if (curItem.itemClassification == 254) {
-            message.append(u"Error or Not in the Item Pool.");
-        }
-        else {
-            message.append(u"It looks really important!");
-        }
-    } else {
-        //if (sInstance->apSlotNames[curItem.slotIndex].isEmpty()) {
-            message.append(sInstance->apItemNames[curItem.apItemNameIndex].cstr());
-        //} else {
-            //message.append(u"Missing Item Name");
-        //}
-    }
-
-    return message.cstr();
+    return sInstance->mShopText + sInstance->mShopTextOffsets[shopItemIndex * 2 + isExplain];
 }
 
 /**
@@ -3357,6 +3007,185 @@ void Client::updateSlotData(SlotData* packet) {
     sInstance->numApItems = 0;
 }
 
+/**
+ * @brief decodes a slot data bundle in a single pass, replacing the SLOTDATA, APINFO, SHOPREPLACE, SHINECOLOR and SHINEREPLACE packets
+ * 
+ * Once decoded a bundle is a u8 table count followed by, per table, a u8 SlotTable id, the u32 hash the connector
+ * gave the table, its u16 size and readSlotTable's layout for it. The hash is handed back in the next PlayerConnect,
+ * so after a reconnect the connector only resends the tables that changed in the meantime.
+ */
+void Client::updateSlotBundle(SlotBundle* packet) {
+    if (!sInstance) {
+        Logger::log("Static Instance is Null!\n");
+        return;
+    }
+
+    if (packet->version != SLOTBUNDLEVERSION) {
+        Logger::log("Slot data bundle version %d doesn't match ours (%d)!\n", packet->version, SLOTBUNDLEVERSION);
+        return;
+    }
+
+    u32 size = packet->mPacketSize - SLOTBUNDLEHEADERSIZE;
+    BundleReader reader(packet->data, size, packet->encoding == ENCODING_RLE);
+
+    u8 tableCount = 0;
+    reader.read(&tableCount);
+
+    for (int i = 0; i < tableCount; i++) {
+        u8 table = 0;
+        u32 hash = 0;
+        u16 tableSize = 0;
+
+        if (!reader.read(&table) || !reader.read(&hash) || !reader.read(&tableSize))
+            break;
+
+        u32 tableEnd = reader.getReadCount() + tableSize;
+
+        bool isRead = table < SLOTTABLECOUNT && sInstance->readSlotTable(reader, static_cast<SlotTable>(table));
+
+        if (reader.getReadCount() > tableEnd) {
+            Logger::log("Slot table %d overran its size!\n", table);
+            sInstance->mSlotTableHashes[table] = 0;
+            break;
+        }
+
+        reader.skip(tableEnd - reader.getReadCount());
+
+        if (table < SLOTTABLECOUNT)
+            sInstance->mSlotTableHashes[table] = isRead && !reader.isFailed() ? hash : 0;
+    }
+
+    sInstance->mIsShopTextDirty = true;
+
+    if (reader.isFailed() || reader.getReadCount() != packet->rawSize) {
+        Logger::log("Slot data bundle was cut short! Read: %d Expected: %d\n", reader.getReadCount(), packet->rawSize);
+    } else {
+        Logger::log("Slot data bundle applied (%d tables, %d bytes, %d decoded)\n", tableCount, size, packet->rawSize);
+    }
+}
+
+/**
+ * @brief reads one table of a slot data bundle straight into the arrays it replaces, all values little endian
+ * 
+ * TABLE_OPTIONS      u8 world count, s16 pay count per world index, u8 flags (1 regionals, 2 captures)
+ * TABLE_SHINECOLORS  u16 color count, s8 color per shine uid
+ * TABLE_SHOP         u8 shop table count, per table (cap, cloth, sticker, gift, moon) u8 entry count and 4 bytes per shopReplaceText
+ * TABLE_*NAMES       u8 name count and a BundleReader string per name
+ * TABLE_SHINETEXT    u8 world index, u8 entry count and 2 bytes per shineReplaceText, u8 name count and a BundleReader string per name
+ * 
+ * @return false if the table was cut short
+ */
+bool Client::readSlotTable(BundleReader& reader, SlotTable table) {
+
+    switch (table) {
+    case TABLE_OPTIONS: {
+        u8 worldCount = 0;
+        reader.read(&worldCount);
+        for (int i = 0; i < worldCount; i++) {
+            s16 payCount = -1;
+            if (reader.read(&payCount) && i < worldPayCounts.size())
+                worldPayCounts[i] = payCount;
+        }
+
+        u8 flags = 0;
+        reader.read(&flags);
+        regionals = flags & 1;
+        captures = flags & 2;
+        break;
+    }
+    case TABLE_SHINECOLORS: {
+        u16 colorCount = 0;
+        reader.read(&colorCount);
+        u32 storedColors = colorCount < shineColors.size() ? colorCount : shineColors.size();
+        reader.read(&shineColors[0], storedColors);
+        reader.skip(colorCount - storedColors);
+        break;
+    }
+    case TABLE_SHOP: {
+        static_assert(sizeof(shopReplaceText) == 4, "shopReplaceText is read straight from the bundle");
+        shopReplaceText* shopTables[] = {
+            &shopCapTextReplacements[0], &shopClothTextReplacements[0], &shopStickerTextReplacements[0],
+            &shopGiftTextReplacements[0], &shopMoonTextReplacements[0]};
+        const u32 shopTableSizes[] = {
+            (u32)shopCapTextReplacements.size(), (u32)shopClothTextReplacements.size(),
+            (u32)shopStickerTextReplacements.size(), (u32)shopGiftTextReplacements.size(),
+            (u32)shopMoonTextReplacements.size()};
+
+        u8 shopTableCount = 0;
+        reader.read(&shopTableCount);
+        for (int i = 0; i < shopTableCount; i++) {
+            u8 entryCount = 0;
+            reader.read(&entryCount);
+
+            u32 storedEntries = 0;
+            if (i < 5) {
+                storedEntries = entryCount < shopTableSizes[i] ? entryCount : shopTableSizes[i];
+                reader.read(shopTables[i], storedEntries * sizeof(shopReplaceText));
+            }
+            reader.skip((entryCount - storedEntries) * sizeof(shopReplaceText));
+        }
+        break;
+    }
+    case TABLE_GAMENAMES:
+    case TABLE_SLOTNAMES:
+    case TABLE_ITEMNAMES: {
+        sead::SafeArray<sead::WFixedSafeString<40>, 144>& names =
+            table == TABLE_GAMENAMES ? apGameNames : table == TABLE_SLOTNAMES ? apSlotNames : apItemNames;
+        int& nameCount = table == TABLE_GAMENAMES ? numApGames : table == TABLE_SLOTNAMES ? numApSlots : numApItems;
+
+        u8 count = 0;
+        reader.read(&count);
+        for (int i = 0; i < count; i++) {
+            char16_t name[41];
+            if (!reader.readString(name, 41))
+                break;
+
+            if (i < names.size()) {
+                names[i] = names[i].cEmptyString;
+                names[i].append(name);
+            }
+        }
+        nameCount = count;
+        break;
+    }
+    case TABLE_SHINETEXT: {
+        static_assert(sizeof(shineReplaceText) == 2, "shineReplaceText is read straight from the bundle");
+
+        u8 worldId = 0;
+        reader.read(&worldId);
+
+        u8 entryCount = 0;
+        reader.read(&entryCount);
+        u32 storedEntries = entryCount < shineTextReplacements.size() ? entryCount : shineTextReplacements.size();
+        reader.read(&shineTextReplacements[0], storedEntries * sizeof(shineReplaceText));
+        reader.skip((entryCount - storedEntries) * sizeof(shineReplaceText));
+
+        // entries this world doesn't have would otherwise keep the previous world's text
+        for (int i = storedEntries; i < shineTextReplacements.size(); i++) {
+            shineTextReplacements[i] = {0, 0};
+        }
+
+        u8 count = 0;
+        reader.read(&count);
+        for (int i = 0; i < count; i++) {
+            char name[41];
+            if (!reader.readString(name, 41))
+                break;
+
+            if (i < shineItemNames.size()) {
+                shineItemNames[i] = shineItemNames[i].cEmptyString;
+                shineItemNames[i].append(name);
+            }
+        }
+        break;
+    }
+    default:
+        break;
+    }
+
+    return !reader.isFailed();
+}
+
 void Client::updateWorlds(UnlockWorld* packet)
 {
     if (!sInstance) {
@@ -3499,6 +3328,11 @@ void Client::setSceneInfo(const al::ActorInitInfo& initInfo, const StageScene *s
     memcpy(sInstance->mSceneInfo, &initInfo.mActorSceneInfo, sizeof(al::ActorSceneInfo));
 
     sInstance->mCurStageScene = stageScene;
+
+    sInstance->resolveHintArts(GameDataHolderAccessor(stageScene));
+
+    // shine indices and the Dark Side hint art both depend on the stage, every entry resolves again on first use
+    memset(sInstance->mStageShines, 0xFF, sizeof(sInstance->mStageShines));
 }
 
 /**
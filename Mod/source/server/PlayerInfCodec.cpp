@@ -0,0 +1,283 @@
+#include "server/PlayerInfCodec.hpp"
+
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+constexpr int cQuatComponentBits = 10;
+constexpr float cQuatComponentMax = (1 << cQuatComponentBits) - 1;
+
+template <typename T>
+void writeField(u8* data, int* offset, const T& value) {
+    memcpy(data + *offset, &value, sizeof(T));
+    *offset += sizeof(T);
+}
+
+template <typename T>
+bool readField(const u8* data, int size, int* offset, T* value) {
+    if (*offset + (int)sizeof(T) > size)
+        return false;
+
+    memcpy(value, data + *offset, sizeof(T));
+    *offset += sizeof(T);
+    return true;
+}
+
+}  // namespace
+
+void PlayerInfState::set(const PlayerInf& info) {
+    pos = info.playerPos;
+    rot = PlayerInfCodec::packQuat(info.playerRot);
+
+    for (int i = 0; i < 6; i++) {
+        // also maps NaN to 0
+        float weight = info.animBlendWeights[i] > 0.f ? info.animBlendWeights[i] : 0.f;
+        blendWeights[i] = (u8)((weight < 1.f ? weight : 1.f) * 255.f + 0.5f);
+    }
+
+    actName = info.actName;
+    subActName = info.subActName;
+}
+
+void PlayerInfState::apply(PlayerInf* info) const {
+    info->playerPos = pos;
+
+    if (rot) {
+        PlayerInfCodec::unpackQuat(rot, &info->playerRot);
+    } else {
+        info->playerRot = sead::Quatf(0.f, 0.f, 0.f, 0.f);
+    }
+
+    for (int i = 0; i < 6; i++) {
+        info->animBlendWeights[i] = blendWeights[i] / 255.f;
+    }
+
+    info->actName = actName;
+    info->subActName = subActName;
+}
+
+/**
+ * @brief packs a rotation as the index of its largest component plus the other three at 10 bits each
+ *
+ * The largest component is rebuilt from the others on unpack, which leaves the three sent ones within +-1/sqrt(2).
+ */
+u32 PlayerInfCodec::packQuat(const sead::Quatf& quat) {
+    float components[4] = {quat.x, quat.y, quat.z, quat.w};
+
+    float lengthSq = 0.f;
+    int largest = 0;
+
+    for (int i = 0; i < 4; i++) {
+        lengthSq += components[i] * components[i];
+
+        if (fabsf(components[i]) > fabsf(components[largest]))
+            largest = i;
+    }
+
+    if (!(lengthSq > 0.000001f))
+        return 0;
+
+    // q and -q are the same rotation, so flip it to make the dropped component positive
+    float scale = (components[largest] < 0.f ? -1.f : 1.f) / sqrtf(lengthSq);
+
+    u32 packed = (u32)largest << (cQuatComponentBits * 3);
+    int shift = cQuatComponentBits * 2;
+
+    for (int i = 0; i < 4; i++) {
+        if (i == largest)
+            continue;
+
+        float normalized = components[i] * scale * (float)M_SQRT2 * 0.5f + 0.5f;
+        float quantized = normalized * cQuatComponentMax + 0.5f;
+        u32 value = quantized > 0.f ? (quantized < cQuatComponentMax ? (u32)quantized : (u32)cQuatComponentMax) : 0;
+
+        packed |= value << shift;
+        shift -= cQuatComponentBits;
+    }
+
+    // three components at -1/sqrt(2) can't come from a unit quaternion, so a valid rotation never packs to 0
+    return packed;
+}
+
+void PlayerInfCodec::unpackQuat(u32 packed, sead::Quatf* out) {
+    float components[4];
+
+    int largest = packed >> (cQuatComponentBits * 3);
+    int shift = cQuatComponentBits * 2;
+    float sumSq = 0.f;
+
+    for (int i = 0; i < 4; i++) {
+        if (i == largest)
+            continue;
+
+        u32 value = (packed >> shift) & ((1 << cQuatComponentBits) - 1);
+        components[i] = (value / cQuatComponentMax * 2.f - 1.f) / (float)M_SQRT2;
+        sumSq += components[i] * components[i];
+        shift -= cQuatComponentBits;
+    }
+
+    components[largest] = sumSq < 1.f ? sqrtf(1.f - sumSq) : 0.f;
+
+    out->x = components[0];
+    out->y = components[1];
+    out->z = components[2];
+    out->w = components[3];
+}
+
+bool PlayerInfCodec::encode(const PlayerInf& info, PlayerInfDelta* out) {
+    PlayerInfState state;
+    state.set(info);
+
+    out->mUserID = info.mUserID;
+
+    if (mIsKeyframeNeeded || ++mEncodesSinceKeyframe >= KEYFRAMEINTERVAL || !tryWriteDelta(state, out)) {
+        writeKeyframe(state, out);
+        return true;
+    }
+
+    int dataSize = out->mPacketSize - 2;
+
+    if (out->fieldMask == mLastFieldMask && dataSize == mLastDataSize && memcmp(out->data, mLastData, dataSize) == 0) {
+        return false;
+    }
+
+    mLastFieldMask = out->fieldMask;
+    mLastDataSize = dataSize;
+    memcpy(mLastData, out->data, dataSize);
+
+    return true;
+}
+
+/**
+ * @return false if the position moved too far from the keyframe for a fixed point offset
+ */
+bool PlayerInfCodec::tryWriteDelta(const PlayerInfState& state, PlayerInfDelta* out) {
+    s16 offsets[3];
+    const float* pos = &state.pos.x;
+    const float* keyframePos = &mKeyframe.pos.x;
+
+    for (int i = 0; i < 3; i++) {
+        float offset = (pos[i] - keyframePos[i]) * POSDELTASCALE;
+
+        if (!(offset > -32767.f && offset < 32767.f))
+            return false;
+
+        offsets[i] = (s16)lroundf(offset);
+    }
+
+    u8 fieldMask = 0;
+    int size = 0;
+
+    if (offsets[0] || offsets[1] || offsets[2]) {
+        fieldMask |= PlayerInfField::POSITION;
+        writeField(out->data, &size, offsets);
+    }
+
+    if (state.rot != mKeyframe.rot) {
+        fieldMask |= PlayerInfField::ROTATION;
+        writeField(out->data, &size, state.rot);
+    }
+
+    if (memcmp(state.blendWeights, mKeyframe.blendWeights, sizeof(state.blendWeights)) != 0) {
+        fieldMask |= PlayerInfField::BLENDWEIGHTS;
+        writeField(out->data, &size, state.blendWeights);
+    }
+
+    if (state.actName != mKeyframe.actName || state.subActName != mKeyframe.subActName) {
+        fieldMask |= PlayerInfField::ANIMS;
+        writeField(out->data, &size, state.actName);
+        writeField(out->data, &size, state.subActName);
+    }
+
+    out->mType = PacketType::PLAYERINFDELTA;
+    out->keyframeId = mKeyframeId;
+    out->fieldMask = fieldMask;
+    out->mPacketSize = 2 + size;
+
+    return true;
+}
+
+void PlayerInfCodec::writeKeyframe(const PlayerInfState& state, PlayerInfDelta* out) {
+    mKeyframe = state;
+    mKeyframeId++;
+    mEncodesSinceKeyframe = 0;
+    mIsKeyframeNeeded = false;
+
+    int size = 0;
+
+    writeField(out->data, &size, state.pos.x);
+    writeField(out->data, &size, state.pos.y);
+    writeField(out->data, &size, state.pos.z);
+    writeField(out->data, &size, state.rot);
+    writeField(out->data, &size, state.blendWeights);
+    writeField(out->data, &size, state.actName);
+    writeField(out->data, &size, state.subActName);
+
+    out->mType = PacketType::PLAYERINFKEY;
+    out->keyframeId = mKeyframeId;
+    out->fieldMask = PlayerInfField::POSITION | PlayerInfField::ROTATION | PlayerInfField::BLENDWEIGHTS | PlayerInfField::ANIMS;
+    out->mPacketSize = 2 + size;
+
+    // a delta with nothing in it is what the keyframe already says
+    mLastFieldMask = 0;
+    mLastDataSize = 0;
+}
+
+bool PlayerInfCodec::decode(const PlayerInfDelta* packet, PlayerInfKeyframe* keyframe, PlayerInf* out) {
+    bool isKeyframe = packet->mType == PacketType::PLAYERINFKEY;
+
+    if (!isKeyframe && !(keyframe->isValid && keyframe->id == packet->keyframeId)) {
+        return false;
+    }
+
+    int size = packet->mPacketSize - 2;
+
+    if (size < 0 || size > (int)PLAYERINFDELTADATASIZE) {
+        return false;
+    }
+
+    PlayerInfState state = isKeyframe ? PlayerInfState() : keyframe->state;
+    int offset = 0;
+
+    if (packet->fieldMask & PlayerInfField::POSITION) {
+        if (isKeyframe) {
+            float pos[3];
+            if (!readField(packet->data, size, &offset, &pos))
+                return false;
+
+            state.pos = sead::Vector3f(pos[0], pos[1], pos[2]);
+        } else {
+            s16 offsets[3];
+            if (!readField(packet->data, size, &offset, &offsets))
+                return false;
+
+            state.pos.x += offsets[0] / POSDELTASCALE;
+            state.pos.y += offsets[1] / POSDELTASCALE;
+            state.pos.z += offsets[2] / POSDELTASCALE;
+        }
+    }
+
+    if (packet->fieldMask & PlayerInfField::ROTATION && !readField(packet->data, size, &offset, &state.rot)) {
+        return false;
+    }
+
+    if (packet->fieldMask & PlayerInfField::BLENDWEIGHTS && !readField(packet->data, size, &offset, &state.blendWeights)) {
+        return false;
+    }
+
+    if (packet->fieldMask & PlayerInfField::ANIMS &&
+        !(readField(packet->data, size, &offset, &state.actName) && readField(packet->data, size, &offset, &state.subActName))) {
+        return false;
+    }
+
+    if (isKeyframe) {
+        keyframe->state = state;
+        keyframe->id = packet->keyframeId;
+        keyframe->isValid = true;
+    }
+
+    state.apply(out);
+
+    return true;
+}
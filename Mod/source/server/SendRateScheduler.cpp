@@ -0,0 +1,45 @@
+#include "server/SendRateScheduler.hpp"
+
+#include <cmath>
+
+#include "sead/time/seadTickTime.h"
+
+bool SendRateScheduler::isIntervalElapsed() const {
+    return !mHasSent || sead::TickSpan(sead::TickTime().toTicks() - mLastSendTick).toMicroSeconds() >= 1000000.f * mBackoff / mTargetHz;
+}
+
+bool SendRateScheduler::update(const sead::Vector3f& pos, bool isStateChanged, bool isBacklogged) {
+
+    u64 now = sead::TickTime().toTicks();
+    float elapsed = sead::TickSpan(now - mLastSendTick).toMicroSeconds() / 1000000.f;
+
+    if (mHasSent && elapsed < mBackoff / mTargetHz) {
+        return false;
+    }
+
+    float dx = pos.x - mLastPos.x;
+    float dy = pos.y - mLastPos.y;
+    float dz = pos.z - mLastPos.z;
+    float error = sqrtf(dx * dx + dy * dy + dz * dz);
+
+    bool isDue = !mHasSent || isStateChanged || error > mErrorBound || (error > 0.f && elapsed >= 1.f / IDLESENDHZ);
+
+    if (!isDue) {
+        return false;
+    }
+
+    if (isBacklogged) {
+        // sending now would only replace the update still in the queue, so wait longer instead
+        mBackoff = mBackoff * 2.f < MAXSENDBACKOFF ? mBackoff * 2.f : MAXSENDBACKOFF;
+        mLastSendTick = now;
+        return false;
+    }
+
+    mBackoff = mBackoff - 0.25f > 1.f ? mBackoff - 0.25f : 1.f;
+
+    mLastPos = pos;
+    mLastSendTick = now;
+    mHasSent = true;
+
+    return true;
+}
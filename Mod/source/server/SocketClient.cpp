@@ -11,67 +11,243 @@
 #include "packets/Packet.h"
 #include "packets/UdpPacket.h"
 #include "server/Client.hpp"
-#include "thread/seadMessageQueue.h"
+#include "time/seadTickTime.h"
 #include "types.h"
 
-SocketClient::SocketClient(const char* name, sead::Heap* heap, Client* client) : mHeap(heap), SocketBase(name) {
+SocketClient::SocketClient(const char* name, sead::Heap* heap, Client* client) : SocketBase(name), mHeap(heap) {
 
     this->client = client;
 #if EMU
     this->pollTime = 0;
 #else
-    this->pollTime = -1;
+    this->pollTime = 250; // wake up regularly so reconnect requests from other threads are picked up
 #endif
 
+    this->socket_log_socket = -1;
+
     mRecvThread = new al::AsyncFunctorThread("SocketRecvThread", al::FunctorV0M<SocketClient*, SocketThreadFunc>(this, &SocketClient::recvFunc), 0, 0x1000, {0});
     mSendThread = new al::AsyncFunctorThread("SocketSendThread", al::FunctorV0M<SocketClient*, SocketThreadFunc>(this, &SocketClient::sendFunc), 0, 0x1000, {0});
     
-    mRecvQueue.allocate(maxBufSize, mHeap);
-    mSendQueue.allocate(maxBufSize, mHeap);
+    nn::os::InitializeEvent(&mRecvEvent, false, true);
+    nn::os::InitializeEvent(&mSendEvent, false, true);
+    nn::os::InitializeEvent(&mStateEvent, false, true);
+    nn::os::InitializeEvent(&mConnectedEvent, false, false);
+    nn::os::InitializeMutex(&mSendPushLock, false, 0);
+
 	recvBuf = (char*)mHeap->alloc(MAXPACKSIZE+1);
+
+    // one slot per recv queue entry, plus one for the packet the read thread is currently processing
+    mRecvPoolSize = RECVQUEUESIZE + 1;
+    mRecvPool = (char*)mHeap->alloc(mRecvPoolSize * MAXPACKSIZE);
+    for (int i = 0; i < mRecvPoolSize; i++) {
+        mFreeRecvSlots.push(i);
+    }
+    mRecvSessionIds = (u8*)mHeap->alloc(mRecvPoolSize);
+    mMessagePool = (char*)mHeap->alloc(MESSAGESLOTCOUNT * MAXMESSAGESIZE);
+    for (int i = 0; i < MESSAGESLOTCOUNT; i++) {
+        mFreeMessageSlots.push(i);
+    }
+    mRecvStream = (char*)mHeap->alloc(RECVSTREAMSIZE);
+    mSendFrame = (char*)mHeap->alloc(MAXSENDFRAMESIZE);
 };
 
+/**
+ * @brief hands the server address to the connection state machine and waits until a connection has been made
+ * 
+ * The recv thread owns the connection from here on, retrying with backoff whenever it drops.
+ */
 nn::Result SocketClient::init(const char* ip, u16 port) {
 
     this->sock_ip = ip;
     this->port    = port;
-    
-    in_addr  hostAddress   = { 0 };
-    sockaddr serverAddress = { 0 };
-    sockaddr udpAddress    = { 0 };
 
     Logger::log("SocketClient::init: %s:%d sock %s\n", ip, port, getStateChar());
 
-    nn::nifm::Initialize();
+    // address may have changed, so resolve it again on the next attempt
+    mIsHostAddressCached = false;
+    mReconnectAttempts = 0;
+    mIsConnectRequested = true;
+
+    if (this->mRecvThread->isDone() && this->mSendThread->isDone()) {
+        startThreads();
+    }
+
+    nn::os::SignalEvent(&mStateEvent);
+
+    return waitForConnection() ? 0 : -1;
+}
+
+/**
+ * @brief parks the calling thread until the state machine reaches CONN_CONNECTED
+ */
+bool SocketClient::waitForConnection() {
+    while (!isSendAllowed()) {
+        nn::os::WaitEvent(&mConnectedEvent);
+
+        // a reconnect requested while the event was already set would keep it set until the recv thread notices,
+        // the loop checks again after clearing so a connection made in between isn't missed
+        if (mIsReconnectNeeded)
+            nn::os::ClearEvent(&mConnectedEvent);
+    }
+
+    return true;
+}
+
+const char* SocketClient::getConnStateChar() {
+    switch (mConnState) {
+    case CONN_DISCONNECTED:
+        return "Disconnected";
+    case CONN_RESOLVING:
+        return "Resolving";
+    case CONN_CONNECTING:
+        return "Connecting";
+    case CONN_HANDSHAKE:
+        return "Handshake";
+    case CONN_CONNECTED:
+        return "Connected";
+    default:
+        return "Unknown State";
+    }
+}
+
+void SocketClient::setConnState(ConnectionState state) {
+    mConnState = state;
+
+    if (state == CONN_CONNECTED) {
+        nn::os::SignalEvent(&mConnectedEvent);
+    } else {
+        nn::os::ClearEvent(&mConnectedEvent);
+    }
+}
+
+/**
+ * @return milliseconds to wait before the next connection attempt, doubling per failed attempt with jitter so clients that dropped together don't retry in lockstep
+ */
+s64 SocketClient::getBackoffDelay() {
+    int shift = mReconnectAttempts > 1 ? mReconnectAttempts - 1 : 0;
+    s64 delay = shift < 16 ? (RECONNECTBASEDELAY << shift) : RECONNECTMAXDELAY;
+
+    if (delay > RECONNECTMAXDELAY) {
+        delay = RECONNECTMAXDELAY;
+    }
+
+    s64 half = delay / 2;
+    return half + (sead::TickTime().toTicks() % (half + 1));
+}
+
+/**
+ * @brief advances the connection state machine by one step, only ever called from the recv thread
+ */
+void SocketClient::stepConnection() {
+    switch (mConnState) {
+    case CONN_DISCONNECTED:
+        if (!mIsConnectRequested) {
+            nn::os::WaitEvent(&mStateEvent);
+            return;
+        }
+
+        if (mReconnectAttempts > 0) {
+            s64 delay = getBackoffDelay();
+            Logger::log("Reconnecting in %lldms (Attempt %d)\n", delay, mReconnectAttempts);
+            nn::os::TimedWaitEvent(&mStateEvent, nn::TimeSpan::FromNanoSeconds(delay * 1000000));
+        }
+
+        setConnState(CONN_RESOLVING);
+        break;
+    case CONN_RESOLVING:
+        if (tryResolve()) {
+            setConnState(CONN_CONNECTING);
+        } else {
+            onConnectFailed();
+        }
+        break;
+    case CONN_CONNECTING:
+        if (tryConnect()) {
+            setConnState(CONN_HANDSHAKE);
+        } else {
+            onConnectFailed();
+        }
+        break;
+    case CONN_HANDSHAKE:
+        if (tryHandshake()) {
+            Logger::log("Connection Successful.\n");
+            mReconnectAttempts = 0;
+            setConnState(CONN_CONNECTED);
+        } else {
+            onConnectFailed();
+        }
+        break;
+    case CONN_CONNECTED:
+        break;
+    }
+}
+
+void SocketClient::onConnectFailed() {
+    mReconnectAttempts++;
+
+    // the server may have moved, so stop trusting the cached address after a few failures in a row
+    if (mReconnectAttempts % MAXCACHEDADDRFAILS == 0) {
+        mIsHostAddressCached = false;
+    }
+
+    closeSocket();
+    this->socket_log_state = SOCKET_LOG_UNAVAILABLE;
+    mIsReconnectNeeded = false;
+    setConnState(CONN_DISCONNECTED);
+}
+
+bool SocketClient::tryResolve() {
+
+    if (!mIsNifmInitialized) {
+        nn::nifm::Initialize();
+        mIsNifmInitialized = true;
+    }
+
     nn::nifm::SubmitNetworkRequest();
 
-    while (nn::nifm::IsNetworkRequestOnHold()) { }
+    while (nn::nifm::IsNetworkRequestOnHold()) {
+        nn::os::SleepThread(nn::TimeSpan::FromNanoSeconds(10000000));
+    }
 
     // emulators (ryujinx) make this return false always, so skip it during init
     #ifndef EMU
     if (!nn::nifm::IsNetworkAvailable()) {
         Logger::log("Network Unavailable.\n");
-        this->socket_log_state = SOCKET_LOG_UNAVAILABLE;
         this->socket_errno = nn::socket::GetLastErrno();
-        return -1;
+        return false;
     }
     #endif
 
-    if ((this->socket_log_socket = nn::socket::Socket(2, 1, 6)) < 0) {
-        Logger::log("Socket Unavailable.\n");
-        this->socket_errno = nn::socket::GetLastErrno();
-        this->socket_log_state = SOCKET_LOG_UNAVAILABLE;
-        return -1;
+    if (mIsHostAddressCached) {
+        return true;
     }
 
-    if (! this->stringToIPAddress(this->sock_ip, &hostAddress)) {
+    if (! this->stringToIPAddress(this->sock_ip, &mHostAddress)) {
         Logger::log("IP address is invalid or hostname not resolveable.\n");
         this->socket_errno = nn::socket::GetLastErrno();
-        this->socket_log_state = SOCKET_LOG_UNAVAILABLE;
-        return -1;
+        return false;
+    }
+
+    mIsHostAddressCached = true;
+
+    return true;
+}
+
+bool SocketClient::tryConnect() {
+
+    sockaddr serverAddress = { 0 };
+    sockaddr udpAddress    = { 0 };
+
+    if ((this->socket_log_socket = nn::socket::Socket(2, 1, 6)) < 0) {
+        Logger::log("Socket Unavailable.\n");
+        this->socket_errno = nn::socket::GetLastErrno();
+        return false;
     }
 
-    serverAddress.address = hostAddress;
+    // socket exists from here on, so let closeSocket clean it up if anything fails
+    this->socket_log_state = SOCKET_LOG_UNAVAILABLE;
+
+    serverAddress.address = mHostAddress;
     serverAddress.port = nn::socket::InetHtons(this->port);
     serverAddress.family = 2;
 
@@ -79,49 +255,74 @@ nn::Result SocketClient::init(const char* ip, u16 port) {
 
     nn::socket::SetSockOpt(this->socket_log_socket, 6, TCP_NODELAY, &sockOptValue, sizeof(sockOptValue));
 
-    nn::Result result;
-    
-    if((result = nn::socket::Connect(this->socket_log_socket, &serverAddress, sizeof(serverAddress))).isFailure()) {
+    if(nn::socket::Connect(this->socket_log_socket, &serverAddress, sizeof(serverAddress)) < 0) {
         Logger::log("Socket Connection Failed!\n");
         this->socket_errno = nn::socket::GetLastErrno();
-        this->socket_log_state = SOCKET_LOG_UNAVAILABLE;
-        return result;
+        return false;
     }
 
     if ((this->mUdpSocket = nn::socket::Socket(2, 2, 17)) < 0) {
         Logger::log("Udp Socket failed to create");
         this->socket_errno = nn::socket::GetLastErrno();
-        this->socket_log_state = SOCKET_LOG_UNAVAILABLE;
-        return -1;
+        return false;
     }
 
-    udpAddress.address = hostAddress;
+    udpAddress.address = mHostAddress;
     udpAddress.port = 0;
     udpAddress.family = 2;
     this->mUdpAddress = udpAddress;
     this->mHasRecvUdp = false;
-    this->mPacketQueueOpen = true;
+    this->mRecvStreamSize = 0;
 
-    this->socket_log_state = SOCKET_LOG_CONNECTED;
+    // session ids only live as long as the connection they were handed out on
+    mSessionId = NOSESSION;
+    for (auto& uid : mSessionUids)
+        uid = {};
+
+    mLastPingTick = 0;
+    mLastRecvTick = sead::TickTime().toTicks();
+    mHasRecvPong = false;
+    mSmoothedRtt = -1;
+    mRttJitter = 0;
+
+    nn::socket::Recv(this->socket_log_socket, nullptr, 0, 0);
 
     Logger::log("Socket fd: %d\n", socket_log_socket);
 
-    startThreads();  // start recv and send threads after succesful connection
+    return true;
+}
+
+/**
+ * @brief sends the packets the server expects before anything else, on the recv thread
+ *
+ * The send thread can still be inside trySendQueue from the last connection, but it only writes to the socket once
+ * isSendAllowed, so nothing it holds reaches the new one ahead of PlayerConnect.
+ */
+bool SocketClient::tryHandshake() {
+
+    this->mPacketQueueOpen = true;
+    this->socket_log_state = SOCKET_LOG_CONNECTED;
 
-    // send init packet to server once we connect (an issue with the server prevents this from working properly, waiting for a fix to implement)
-    
     PlayerConnect initPacket;
     initPacket.mUserID = Client::getClientId();
     strcpy(initPacket.clientName, Client::getUsername().cstr());
+    initPacket.conType = mIsFirstConnect ? ConnectionTypes::INIT : ConnectionTypes::RECONNECT;
 
-    if (mIsFirstConnect) {
-        initPacket.conType = ConnectionTypes::INIT;
-        mIsFirstConnect = false;
-    } else {
-        initPacket.conType = ConnectionTypes::RECONNECT;
+    for (int i = 0; i < SLOTTABLECOUNT; i++) {
+        initPacket.slotTableHashes[i] = Client::getSlotTableHash(static_cast<SlotTable>(i));
+    }
+
+    if (!send(&initPacket)) {
+        return false;
     }
 
-    send(&initPacket);
+    mIsFirstConnect = false;
+
+    // lets the connector send any checks collected while it couldn't hear us
+    ShineBitmap shineBitmap;
+    shineBitmap.mUserID = initPacket.mUserID;
+    Client::writeShineBitmap(&shineBitmap);
+    send(&shineBitmap);
 
     // on a reconnect, resend some maybe missing packets
     if (initPacket.conType == ConnectionTypes::RECONNECT) {
@@ -143,8 +344,33 @@ nn::Result SocketClient::init(const char* ip, u16 port) {
         send(&capInf);
     }
 
-    return result;
+    return !mIsReconnectNeeded;
+}
+
+/**
+ * @brief asks the recv thread to drop the current connection and start reconnecting, safe to call from any thread
+ */
+void SocketClient::requestReconnect() {
+    if (!mIsReconnectNeeded.exchange(true)) {
+        Logger::log("Reconnect Requested.\n");
+    }
+
+    // park the send thread until the recv thread has brought the connection back
+    nn::os::ClearEvent(&mConnectedEvent);
+}
+
+/**
+ * @brief tears down the current connection, only ever called from the recv thread
+ */
+void SocketClient::disconnect() {
+    Logger::log("Connection Lost. Attempting to Reconnect.\n");
 
+    setConnState(CONN_DISCONNECTED);
+    closeSocket();
+    resetAssembly(); // the rest of a half received message is gone with the old connection
+
+    mIsReconnectNeeded = false;
+    mReconnectAttempts = 1;
 }
 
 u16 SocketClient::getLocalUdpPort() {
@@ -187,21 +413,52 @@ const char* SocketClient::getUdpStateChar() {
 
     return "Utilizing UDP";
 }
-bool SocketClient::send(Packet *packet) {
+bool SocketClient::isUdpPacket(Packet* packet) {
+    if (this->mUdpAddress.port == 0)
+        return false;
 
-    if (this->socket_log_state != SOCKET_LOG_CONNECTED || packet == nullptr)
+    if (packet->mType == HOLEPUNCH)
+        return true;
+
+    switch (packet->mType) {
+    case PLAYERINF:
+    case PLAYERINFKEY:
+    case PLAYERINFDELTA:
+    case HACKCAPINF:
+        return this->mHasRecvUdp;
+    default:
         return false;
+    }
+}
+
+bool SocketClient::sendBuffer(s32 fd, const char* buffer, int size) {
+
+    int sent = 0;
+
+    while (sent < size) {
+        int result = nn::socket::Send(fd, buffer + sent, size - sent, 0);
+
+        if (result <= 0) {
+            this->socket_errno = nn::socket::GetLastErrno();
+            Logger::log("Send Failed! Result: %d Sent: %d/%d\n", result, sent, size);
+            return false;
+        }
+
+        sent += result;
+    }
 
-    char* buffer = reinterpret_cast<char*>(packet);
+    return true;
+}
+
+bool SocketClient::send(Packet *packet) {
 
-    int valread = 0;
+    if (this->socket_log_state != SOCKET_LOG_CONNECTED || packet == nullptr)
+        return false;
 
     int fd = -1;
-    if ((packet->mType != PLAYERINF && packet->mType != HACKCAPINF && packet->mType != HOLEPUNCH)
-        || (!this->mHasRecvUdp && packet->mType != HOLEPUNCH)
-        || this->mUdpAddress.port == 0) {
+    if (!isUdpPacket(packet)) {
 
-        if (packet->mType != PLAYERINF && packet->mType != HACKCAPINF) {
+        if (isLoggedPacket(packet->mType)) {
             Logger::log("Sending packet: %s\n", packetNames[packet->mType]);
         }
 
@@ -211,23 +468,129 @@ bool SocketClient::send(Packet *packet) {
         fd = this->mUdpSocket;
     }
 
+    u8 sessionId = mSessionId.load(std::memory_order_relaxed);
+
+    char* buf = reinterpret_cast<char*>(packet);
+    int len = packet->mPacketSize + sizeof(Packet);
+
+    // datagrams never exceed MAXPACKSIZE, so the compact one always fits
+    char compact[MAXPACKSIZE];
 
-    if ((valread = nn::socket::Send(fd, buffer, packet->mPacketSize + sizeof(Packet), 0) > 0)) {
+    if (fd == this->mUdpSocket && sessionId != NOSESSION) {
+        CompactPacket* header = reinterpret_cast<CompactPacket*>(compact);
+        header->mType = packet->mType;
+        header->mPacketSize = packet->mPacketSize;
+        header->mSessionId = sessionId;
+        memcpy(compact + sizeof(CompactPacket), reinterpret_cast<char*>(packet) + sizeof(Packet), packet->mPacketSize);
+
+        buf = compact;
+        len = packet->mPacketSize + sizeof(CompactPacket);
+    }
+
+    if (sendBuffer(fd, buf, len)) {
         return true;
-    } else {
-        Logger::log("Failed to Fully Send Packet! Result: %d Type: %s Packet Size: %d\n", valread, packetNames[packet->mType], packet->mPacketSize);
-        this->socket_errno = nn::socket::GetLastErrno();
-        return this->tryReconnect();
     }
+
+    Logger::log("Failed to Fully Send Packet! Type: %s Packet Size: %d\n", packetNames[packet->mType], packet->mPacketSize);
+    requestReconnect();
+    return false;
+}
+
+/**
+ * @brief copies a packet onto the end of the pending TCP frame, flushing the frame first if the packet won't fit
+ */
+bool SocketClient::appendToSendFrame(Packet* packet) {
+
+    int size = packet->mPacketSize + sizeof(Packet);
+
+    if (size > MAXPACKSIZE) {
+        return appendFragments(packet);
+    }
+
+    if (mSendFrameSize + size > MAXSENDFRAMESIZE && !flushSendFrame()) {
+        return false;
+    }
+
+    if (isLoggedPacket(packet->mType)) {
+        Logger::log("Sending packet: %s\n", packetNames[packet->mType]);
+    }
+
+    memcpy(mSendFrame + mSendFrameSize, packet, size);
+    mSendFrameSize += size;
+
+    return true;
+}
+
+/**
+ * @brief splits a packet too large for MAXPACKSIZE into FRAGMENTs on the pending TCP frame
+ */
+bool SocketClient::appendFragments(Packet* packet) {
+
+    u32 size = packet->mPacketSize + sizeof(Packet);
+
+    if (size > MAXMESSAGESIZE) {
+        // nothing on the other end could reassemble this, so drop it instead of the connection
+        Logger::log("Packet too large to send! Type: %s Packet Size: %d\n", packetNames[packet->mType], packet->mPacketSize);
+        return true;
+    }
+
+    if (isLoggedPacket(packet->mType)) {
+        Logger::log("Sending packet: %s (%d fragments)\n", packetNames[packet->mType], (size + FRAGMENTDATASIZE - 1) / FRAGMENTDATASIZE);
+    }
+
+    FragmentPacket fragment;
+    fragment.mUserID = packet->mUserID;
+    fragment.messageId = mNextMessageId++;
+    fragment.totalLength = size;
+
+    const char* data = reinterpret_cast<const char*>(packet);
+
+    for (u32 offset = 0; offset < size; offset += FRAGMENTDATASIZE) {
+        u32 sliceSize = size - offset < FRAGMENTDATASIZE ? size - offset : FRAGMENTDATASIZE;
+
+        memcpy(fragment.data, data + offset, sliceSize);
+        fragment.mPacketSize = FRAGMENTHEADERSIZE + sliceSize;
+
+        if (!appendToSendFrame(&fragment))
+            return false;
+
+        fragment.fragmentIndex++;
+    }
+
     return true;
 }
 
+/**
+ * @brief writes every packet accumulated in the send frame to the TCP socket with a single Send
+ *
+ * A frame that can't be sent is kept and goes out again first on the next connection, so packets in it that did make
+ * it out before the connection dropped can arrive twice.
+ */
+bool SocketClient::flushSendFrame() {
+
+    if (mSendFrameSize == 0)
+        return true;
+
+    // socket_log_state is already connected during the handshake, whose sends have to go out first
+    if (!isSendAllowed())
+        return false;
+
+    if (sendBuffer(this->socket_log_socket, mSendFrame, mSendFrameSize)) {
+        mSendFrameSize = 0;
+        return true;
+    } else {
+        Logger::log("Failed to Fully Send Frame! Frame Size: %d\n", mSendFrameSize);
+        requestReconnect();
+        return false;
+    }
+}
+
 bool SocketClient::recv() {
 
     if (this->socket_log_state != SOCKET_LOG_CONNECTED) {
         Logger::log("Unable To Receive! Socket Not Connected.\n");
         this->socket_errno = nn::socket::GetLastErrno();
-        return this->tryReconnect();
+        return false;
     }
     
     const int fd_count = 2;
@@ -251,7 +614,13 @@ bool SocketClient::recv() {
     } else if (result < 0) {
         Logger::log("Error occurred when polling for packets\n");
         this->socket_errno = nn::socket::GetLastErrno();
-        return this->tryReconnect();
+        return false;
+    }
+
+    // POLLERR or POLLHUP on the tcp socket means the connection is gone even if nothing is left to read
+    if (pfds[0].revents & (0x8 | 0x10) && !(pfds[0].revents & 1)) {
+        Logger::log("Tcp socket was closed by the server\n");
+        return false;
     }
 
     s32 index = -1;
@@ -274,93 +643,72 @@ bool SocketClient::recv() {
 
 }
 
+/**
+ * @brief reads everything currently available on the tcp socket and splits out every complete packet, carrying a trailing partial packet over to the next read
+ */
 bool SocketClient::recvTcp() {
     int headerSize = sizeof(Packet);
-    int valread = 0;
     s32 fd = this->socket_log_socket;
 
-    // read only the size of a header
-    while(valread < headerSize) {
-        int result = 0;
-        result = nn::socket::Recv(fd, recvBuf + valread,
-                                        headerSize - valread, this->sock_flags);
+    int result = nn::socket::Recv(fd, mRecvStream + mRecvStreamSize,
+                                  RECVSTREAMSIZE - mRecvStreamSize, this->sock_flags);
 
-        this->socket_errno = nn::socket::GetLastErrno();
+    this->socket_errno = nn::socket::GetLastErrno();
 
-        if(result > 0) {
-            valread += result;
-        } else {
-            if(this->socket_errno==11){
-                return true;
-            } else {
-                Logger::log("Header Read Failed! Value: %d Total Read: %d\n", result, valread);
-                return this->tryReconnect();
-            }
+    if (result <= 0) {
+        if (result < 0 && this->socket_errno == 11) {
+            return true;
         }
-    }
-
-    if(valread <= 0) { // if we error'd, close the socket
-        Logger::log("valread was zero! Disconnecting.\n");
-        this->socket_errno = nn::socket::GetLastErrno();
-        return this->tryReconnect();
-    }
-
-    Packet* header = reinterpret_cast<Packet*>(recvBuf);
-    int fullSize = header->mPacketSize + sizeof(Packet);
-
-    if (!(fullSize <= MAXPACKSIZE && fullSize > 0 && valread == sizeof(Packet))) {
-        Logger::log("Failed to acquire valid data! Packet Type: %d Full Packet Size %d valread size: %d\n", header->mType, fullSize, valread);
-        return true;
-    }
 
-    if (header->mType != PLAYERINF && header->mType != HACKCAPINF) {
-        Logger::log("Received packet (from %02X%02X):", header->mUserID.data[0],
-                    header->mUserID.data[1]);
-        Logger::disableName();
-        Logger::log(" Size: %d", header->mPacketSize);
-        Logger::log(" Type: %d", header->mType);
-        if(packetNames[header->mType])
-            Logger::log(" Type String: %s\n", packetNames[header->mType]);
-        Logger::enableName();
+        Logger::log("Tcp Read Failed! Value: %d Buffered: %d\n", result, mRecvStreamSize);
+        mRecvStreamSize = 0;
+        return false;
     }
 
-    char* packetBuf = (char*)mHeap->alloc(fullSize);
-
-    if (!packetBuf) {
-        return true;
-    }
+    mRecvStreamSize += result;
+    mLastRecvTick = sead::TickTime().toTicks();
 
+    int offset = 0;
 
-    memcpy(packetBuf, recvBuf, sizeof(Packet));
+    while (mRecvStreamSize - offset >= headerSize) {
 
-    while (valread < fullSize) {
+        Packet* header = reinterpret_cast<Packet*>(mRecvStream + offset);
+        int fullSize = header->mPacketSize + headerSize;
 
-        int result = nn::socket::Recv(fd, packetBuf + valread,
-                                      fullSize - valread, this->sock_flags);
+        if (!(fullSize <= MAXPACKSIZE && header->mPacketSize >= 0)) {
+            // there is no way to find the next header once the stream is out of sync, so drop everything buffered
+            Logger::log("Failed to acquire valid data! Packet Type: %d Full Packet Size %d Buffered: %d\n", header->mType, fullSize, mRecvStreamSize - offset);
+            offset = mRecvStreamSize;
+            break;
+        }
 
-        this->socket_errno = nn::socket::GetLastErrno();
+        if (mRecvStreamSize - offset < fullSize) {
+            break; // rest of the packet hasn't arrived yet
+        }
 
-        if (result > 0) {
-            valread += result;
+        if (!(header->mType > PacketType::UNKNOWN && header->mType < PacketType::End)) {
+            Logger::log("Failed to acquire valid packet type! Packet Type: %d Full Packet Size %d\n", header->mType, fullSize);
         } else {
-            mHeap->free(packetBuf);
-            Logger::log("Packet Read Failed! Value: %d\nPacket Size: %d\nPacket Type: %s\n", result, header->mPacketSize, packetNames[header->mType]);
-            return this->tryReconnect();
+            if (isLoggedPacket(header->mType)) {
+                Logger::log("Received packet (from %02X%02X):", header->mUserID.data[0],
+                            header->mUserID.data[1]);
+                Logger::disableName();
+                Logger::log(" Size: %d", header->mPacketSize);
+                Logger::log(" Type: %d", header->mType);
+                if(packetNames[header->mType])
+                    Logger::log(" Type String: %s\n", packetNames[header->mType]);
+                Logger::enableName();
+            }
+
+            pushRecvPacket(mRecvStream + offset, fullSize);
         }
-    }
 
-    if (!(header->mType > PacketType::UNKNOWN && header->mType < PacketType::End)) {
-        Logger::log("Failed to acquire valid packet type! Packet Type: %d Full Packet Size %d valread size: %d\n", header->mType, fullSize, valread);
-        mHeap->free(packetBuf);
-        return true;
+        offset += fullSize;
     }
 
-    Packet *packet = reinterpret_cast<Packet*>(packetBuf);
-
-    if (!mRecvQueue.isFull() && mPacketQueueOpen) {
-        mRecvQueue.push((s64)packet, sead::MessageQueue::BlockType::NonBlocking);
-    } else {
-        mHeap->free(packetBuf);
+    if (offset > 0) {
+        mRecvStreamSize -= offset;
+        memmove(mRecvStream, mRecvStream + offset, mRecvStreamSize);
     }
 
     return true;
@@ -374,7 +722,11 @@ bool SocketClient::recvUdp() {
 
     if (valread == 0) {
         Logger::log("Udp connection valread was zero. Disconnecting.\n");
-        return this->tryReconnect();
+        return false;
+    }
+
+    if (mSessionId != NOSESSION) {
+        return recvCompact(valread);
     }
 
     if (valread < headerSize){
@@ -395,24 +747,203 @@ bool SocketClient::recvUdp() {
     }
 
     this->mHasRecvUdp = true;
+    mLastRecvTick = sead::TickTime().toTicks();
 
-    char* packetBuf = (char*)mHeap->alloc(fullSize);
-    if (!packetBuf) {
-        return true;
-    }
+    pushRecvPacket(recvBuf, fullSize);
 
-    memcpy(packetBuf, recvBuf, fullSize);
+    return true;
+}
 
+/**
+ * @brief expands a datagram with a CompactPacket header back into a full Packet, filling in the sender's Uid from its session id
+ */
+bool SocketClient::recvCompact(int valread) {
 
-    Packet *packet = reinterpret_cast<Packet*>(packetBuf);
+    if (valread < (int)sizeof(CompactPacket)) {
+        return true;
+    }
 
-    if(!mRecvQueue.isFull()) {
-        mRecvQueue.push((s64)packet, sead::MessageQueue::BlockType::NonBlocking);
-    } else {
-        mHeap->free(packetBuf);
+    const CompactPacket* header = reinterpret_cast<const CompactPacket*>(recvBuf);
+    int bodySize = header->mPacketSize;
+    if (bodySize < 0 || valread < bodySize + (int)sizeof(CompactPacket) || bodySize + (int)sizeof(Packet) > MAXPACKSIZE) {
+        return true;
     }
 
-    return true;
+    if (!(header->mType > PacketType::UNKNOWN && header->mType < PacketType::End)) {
+        Logger::log("Failed to acquire valid packet type! Packet Type: %d Compact Packet Size %d valread size: %d\n", header->mType, bodySize, valread);
+        return true;
+    }
+
+    // HOLEPUNCH comes from the server itself, anything else from a player it has to have announced first
+    if (header->mSessionId != NOSESSION && mSessionUids[header->mSessionId].isEmpty()) {
+        return true;
+    }
+
+    this->mHasRecvUdp = true;
+    mLastRecvTick = sead::TickTime().toTicks();
+
+    char expanded[MAXPACKSIZE];
+    Packet* packet = reinterpret_cast<Packet*>(expanded);
+    packet->mUserID = mSessionUids[header->mSessionId];
+    packet->mType = header->mType;
+    packet->mPacketSize = header->mPacketSize;
+    memcpy(expanded + sizeof(Packet), recvBuf + sizeof(CompactPacket), bodySize);
+
+    pushRecvPacket(expanded, bodySize + sizeof(Packet), header->mSessionId);
+
+    return true;
+}
+
+/**
+ * @brief picks our own session id out of CLIENTINIT and the ones of other players out of PLAYERCON, recv thread only
+ */
+void SocketClient::updateSessions(const Packet* packet) {
+
+    if (packet->mType == PacketType::CLIENTINIT) {
+
+        mSessionId = reinterpret_cast<const InitPacket*>(packet)->getSessionId();
+
+        if (mSessionId != NOSESSION) {
+            Logger::log("Assigned session id %d\n", mSessionId.load());
+        }
+    } else if (packet->mType == PacketType::PLAYERCON) {
+
+        u8 sessionId = reinterpret_cast<const PlayerConnect*>(packet)->getSessionId();
+
+        if (sessionId != NOSESSION) {
+            mSessionUids[sessionId] = packet->mUserID;
+        }
+    }
+}
+
+/**
+ * @brief copies a fully received packet into a free pool slot and hands it to the read thread
+ * 
+ * @param sessionId the sender's session id if the packet came in on a compact header
+ * @return false if the recv queue is full or closed and the packet was dropped
+ */
+bool SocketClient::pushRecvPacket(const char* data, int size, u8 sessionId) {
+
+    // pongs are consumed here so queueing delays on the read thread don't skew the rtt
+    if (reinterpret_cast<const Packet*>(data)->mType == PacketType::PONG) {
+        onPong(reinterpret_cast<const PingPacket*>(data));
+        return true;
+    }
+
+    if (reinterpret_cast<const Packet*>(data)->mType == PacketType::FRAGMENT) {
+        return pushFragment(reinterpret_cast<const FragmentPacket*>(data));
+    }
+
+    updateSessions(reinterpret_cast<const Packet*>(data));
+
+    if (!mPacketQueueOpen) {
+        return false;
+    }
+
+    if (mRecvQueue.isFull()) {
+        mRecvQueue.addDrop();
+        return false;
+    }
+
+    // the pool holds one more slot than the recv queue can, so a slot is always free while the queue has room
+    u16 slot = 0;
+    mFreeRecvSlots.pop(&slot);
+
+    memcpy(mRecvPool + slot * MAXPACKSIZE, data, size);
+    mRecvSessionIds[slot] = sessionId;
+
+    mRecvQueue.push(slot);
+    nn::os::SignalEvent(&mRecvEvent);
+
+    return true;
+}
+
+/**
+ * @brief copies a FRAGMENT into the message it belongs to, handing the message to the read thread once all of it has arrived
+ * 
+ * Fragments of a message are sent back to back over tcp, so one with a new messageId abandons whatever was being reassembled.
+ * 
+ * @return false if the fragment was invalid or the message had to be dropped
+ */
+bool SocketClient::pushFragment(const FragmentPacket* fragment) {
+
+    u32 sliceSize = fragment->mPacketSize - FRAGMENTHEADERSIZE;
+    u32 offset = fragment->fragmentIndex * FRAGMENTDATASIZE;
+
+    if (fragment->mPacketSize < FRAGMENTHEADERSIZE || fragment->totalLength < sizeof(Packet) ||
+        fragment->totalLength > MAXMESSAGESIZE || offset + sliceSize > fragment->totalLength) {
+        Logger::log("Invalid fragment! Index: %d Size: %d Total Length: %d\n", fragment->fragmentIndex, fragment->mPacketSize, fragment->totalLength);
+        return false;
+    }
+
+    if (mIsAssembling && (mAssemblyId != fragment->messageId || mAssemblyLength != fragment->totalLength)) {
+        Logger::log("Abandoning incomplete message %d (%d/%d bytes)\n", mAssemblyId, mAssemblyRecvSize, mAssemblyLength);
+        resetAssembly();
+    }
+
+    if (!mIsAssembling) {
+        u16 slot = 0;
+
+        if (mAssemblySlot < 0) {
+            // every message slot is still waiting on the read thread
+            if (!mFreeMessageSlots.pop(&slot)) {
+                mRecvQueue.addDrop();
+                return false;
+            }
+
+            mAssemblySlot = slot;
+        }
+
+        mIsAssembling = true;
+        mAssemblyId = fragment->messageId;
+        mAssemblyLength = fragment->totalLength;
+        mAssemblyRecvSize = 0;
+    }
+
+    char* message = mMessagePool + mAssemblySlot * MAXMESSAGESIZE;
+
+    memcpy(message + offset, fragment->data, sliceSize);
+    mAssemblyRecvSize += sliceSize;
+
+    if (mAssemblyRecvSize < mAssemblyLength) {
+        return true;
+    }
+
+    mIsAssembling = false;
+
+    const Packet* header = reinterpret_cast<const Packet*>(message);
+
+    if (header->mPacketSize + sizeof(Packet) != mAssemblyLength ||
+        !(header->mType > PacketType::UNKNOWN && header->mType < PacketType::End) || header->mType == PacketType::FRAGMENT) {
+        Logger::log("Failed to reassemble valid packet! Packet Type: %d Full Packet Size %d\n", header->mType, mAssemblyLength);
+        return false;
+    }
+
+    if (isLoggedPacket(header->mType)) {
+        Logger::log("Reassembled packet: %s Size: %d\n", packetNames[header->mType], header->mPacketSize);
+    }
+
+    if (!mPacketQueueOpen || mRecvQueue.isFull()) {
+        if (mPacketQueueOpen)
+            mRecvQueue.addDrop();
+
+        return false;
+    }
+
+    mRecvQueue.push(mAssemblySlot | MESSAGESLOTFLAG);
+    mAssemblySlot = -1;
+    nn::os::SignalEvent(&mRecvEvent);
+
+    return true;
+}
+
+/**
+ * @brief abandons a partially reassembled message, only ever called from the recv thread
+ * 
+ * The slot stays with the recv thread for the next message, as only the read thread may push to mFreeMessageSlots.
+ */
+void SocketClient::resetAssembly() {
+    mIsAssembling = false;
 }
 
 // prints packet to debug logger
@@ -431,34 +962,29 @@ void SocketClient::printPacket(Packet *packet) {
     }
 }
 
-bool SocketClient::tryReconnect() {
-
-    Logger::log("Attempting to Reconnect.\n");
-
-    if (closeSocket()) { // unfortunately we cannot use the same fd from the previous connection, so close the socket entirely and attempt a new connection.
-        if (init(sock_ip, port).isSuccess()) { // call init again
-            Logger::log("Reconnect Successful.\n");
-            return true;
-        }
-    }
-
-    return false;
-}
-
 bool SocketClient::closeSocket() {
 
     Logger::log("Closing Socket.\n");
 
     mHasRecvUdp = false;
     mUdpAddress.port = 0;
-    mPacketQueueOpen = false;
 
-    bool result = false;
+    if (mUdpSocket >= 0) {
+        nn::socket::Close(mUdpSocket);
+        mUdpSocket = -1;
+    }
+
+    bool result = true;
 
-    if (!(result = SocketBase::closeSocket())) {
-        Logger::log("Failed to close socket!\n");
+    if (this->socket_log_socket >= 0) {
+        if (!(result = SocketBase::closeSocket())) {
+            Logger::log("Failed to close socket!\n");
+        }
+        this->socket_log_socket = -1;
     }
 
+    this->socket_log_state = SOCKET_LOG_DISCONNECTED;
+
     return result;
 }
 
@@ -505,6 +1031,7 @@ bool SocketClient::startThreads() {
 }
 
 void SocketClient::endThreads() {
+    wakeQueues();
     mRecvThread->mDelegateThread->destroy();
     mSendThread->mDelegateThread->destroy();
 }
@@ -518,68 +1045,395 @@ void SocketClient::sendFunc() {
 
     Logger::log("Starting Send Thread.\n");
 
-    while (trySendQueue() || socket_log_state != SOCKET_LOG_DISCONNECTED) {}
+    while (true) {
+        waitForConnection();
+
+        if (!trySendQueue() && mSendWake.exchange(false)) {
+            break;
+        }
+    }
 
-    Logger::log("Sending packet failed!\n");
     Logger::log("Ending Send Thread.\n");
 }
 
+/**
+ * @brief main loop of the recv thread, which also drives the connection state machine whenever the socket isn't connected
+ */
 void SocketClient::recvFunc() {
 
-    nn::socket::Recv(this->socket_log_socket, nullptr, 0, 0);
-
     Logger::log("Starting Recv Thread.\n");
 
-    while (recv() || socket_log_state != SOCKET_LOG_DISCONNECTED) {}
+    while (true) {
+        if (mConnState != CONN_CONNECTED) {
+            stepConnection();
+            continue;
+        }
 
-    // Free up all blocked threads
-    mSendQueue.push(0, sead::MessageQueue::BlockType::NonBlocking);
-    mRecvQueue.push(0, sead::MessageQueue::BlockType::NonBlocking);
+        if (!recv() || mIsReconnectNeeded) {
+            disconnect();
+            continue;
+        }
 
-    Logger::log("Receiving Packet Failed!\n");
-    Logger::log("Ending Recv Thread.\n");
+        updateHeartbeat();
+    }
 }
 
-bool SocketClient::queuePacket(Packet* packet) {
-    if (socket_log_state == SOCKET_LOG_CONNECTED && mPacketQueueOpen) {
-        mSendQueue.push((s64)packet,
-                        sead::MessageQueue::BlockType::NonBlocking);  // as this is non-blocking, it
-                                                                      // will always return true.
-        return true;
-    } else {
-        mHeap->free(packet);
+/**
+ * @brief sends a PING every PINGINTERVAL and drops the connection if a server that has answered pings before goes quiet
+ */
+void SocketClient::updateHeartbeat() {
+
+    u64 now = sead::TickTime().toTicks();
+
+    // servers that don't know about pings never answer them, so only time out once we know this one does
+    if (mHasRecvPong && sead::TickSpan(now - mLastRecvTick).toMilliSeconds() > DEADPEERTIMEOUT) {
+        Logger::log("No data received for %dms, assuming the server is gone.\n", DEADPEERTIMEOUT);
+        requestReconnect();
+        return;
+    }
+
+    if (sead::TickSpan(now - mLastPingTick).toMilliSeconds() < PINGINTERVAL) {
+        return;
+    }
+
+    mLastPingTick = now;
+
+    PingPacket* packet = new (mHeap) PingPacket();
+    packet->mUserID = Client::getClientId();
+    packet->timestamp = now;
+    packet->sequence = mPingSequence++;
+
+    queuePacket(packet);
+}
+
+/**
+ * @brief folds a round trip sample into the smoothed rtt and jitter the same way TCP does (RFC 6298)
+ */
+void SocketClient::onPong(const PingPacket* pong) {
+
+    mHasRecvPong = true;
+
+    s32 sample = sead::TickSpan(sead::TickTime().toTicks() - pong->timestamp).toMicroSeconds();
+    s32 smoothedRtt = mSmoothedRtt;
+
+    if (smoothedRtt < 0) {
+        mSmoothedRtt = sample;
+        mRttJitter = sample / 2;
+        return;
+    }
+
+    s32 diff = smoothedRtt > sample ? smoothedRtt - sample : sample - smoothedRtt;
+
+    mRttJitter = (3 * mRttJitter + diff) / 4;
+    mSmoothedRtt = (7 * smoothedRtt + sample) / 8;
+}
+
+/**
+ * @brief makes the next blocking wait on either queue return without a packet
+ */
+void SocketClient::wakeQueues() {
+    mSendWake = true;
+    nn::os::SignalEvent(&mSendEvent);
+
+    mRecvWake = true;
+    nn::os::SignalEvent(&mRecvEvent);
+}
+
+/**
+ * @return false for packets sent too often to be worth logging
+ */
+bool SocketClient::isLoggedPacket(PacketType type) {
+    switch (type) {
+    case PacketType::PLAYERINF:
+    case PacketType::PLAYERINFKEY:
+    case PacketType::PLAYERINFDELTA:
+    case PacketType::HACKCAPINF:
+    case PacketType::PING:
+    case PacketType::PONG:
+    case PacketType::FRAGMENT: // logged once as the packet it carries
         return false;
+    default:
+        return true;
+    }
+}
+
+/**
+ * @return index into mLatestPackets for packet types where only the newest queued packet matters, -1 otherwise
+ */
+s32 SocketClient::getLatestSlotIndex(PacketType type) {
+    switch (type) {
+    case PacketType::PLAYERINF:
+    case PacketType::PLAYERINFDELTA: // keyframes are left out so a delta never replaces the keyframe it builds on
+        return 0;
+    case PacketType::HACKCAPINF:
+        return 1;
+    case PacketType::CAPTUREINF:
+        return 2;
+    default:
+        return -1;
+    }
+}
+
+SendLane SocketClient::getSendLane(PacketType type) {
+    switch (type) {
+    case PacketType::CHECK:
+    case PacketType::DEATHLINK:
+    case PacketType::CHANGESTAGE:
+    case PacketType::COSTUMEINF:
+    case PacketType::SHINECHECKS:
+    case PacketType::PING: // kept out of the bulk lanes so the rtt reflects what a check sees
+    case PacketType::PONG:
+        return SendLane::CRITICAL;
+    default:
+        return getLatestSlotIndex(type) >= 0 ? SendLane::REALTIME : SendLane::NORMAL;
+    }
+}
+
+const char* SocketClient::getSendLaneName(SendLane lane) {
+    switch (lane) {
+    case SendLane::CRITICAL:
+        return "Critical";
+    case SendLane::NORMAL:
+        return "Normal";
+    case SendLane::REALTIME:
+        return "Realtime";
+    default:
+        return "Unknown";
     }
 }
 
+u32 SocketClient::getSendCount(SendLane lane) {
+    if (lane == SendLane::REALTIME) {
+        u32 count = 0;
+        for (int i = 0; i < LATESTSLOTCOUNT; i++) {
+            if (mLatestPackets[i].load(std::memory_order_relaxed))
+                count++;
+        }
+        return count;
+    }
+
+    return mSendQueues[lane].getCount();
+}
+
+/**
+ * @return true if the last realtime packet of this type hasn't been picked up by the send thread yet
+ */
+bool SocketClient::isRealtimePending(PacketType type) {
+    s32 index = getLatestSlotIndex(type);
+    return index >= 0 && mLatestPackets[index].load(std::memory_order_relaxed) != nullptr;
+}
+
+u32 SocketClient::getSendMaxCount(SendLane lane) {
+    return lane == SendLane::REALTIME ? LATESTSLOTCOUNT : mSendQueues[lane].getMaxCount();
+}
+
+u32 SocketClient::getSendDropCount(SendLane lane) {
+    return lane == SendLane::REALTIME ? 0 : mSendQueues[lane].getDropCount();
+}
+
+/**
+ * @brief queues a packet to be sent by the send thread, packets queued while reconnecting are held until the connection is back
+ */
+bool SocketClient::queuePacket(Packet* packet) {
+    if (mIsConnectRequested && mPacketQueueOpen) {
+
+        SendLane lane = getSendLane(packet->mType);
+
+        if (lane == SendLane::REALTIME) {
+            // replace whatever hasn't been sent yet, as it's already out of date
+            Packet* stalePacket = mLatestPackets[getLatestSlotIndex(packet->mType)].exchange(packet);
+
+            if (stalePacket) {
+                mHeap->free(stalePacket);
+                mCoalesceCount.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            nn::os::SignalEvent(&mSendEvent);
+            return true;
+        }
+
+        nn::os::LockMutex(&mSendPushLock);
+        bool isQueued = mSendQueues[lane].push(packet);
+        nn::os::UnlockMutex(&mSendPushLock);
+
+        if (isQueued) {
+            nn::os::SignalEvent(&mSendEvent);
+            return true;
+        }
+    }
+
+    mHeap->free(packet);
+    return false;
+}
+
+/**
+ * @brief pops the next packet to send, always draining the critical lane first and the realtime lane last
+ */
+Packet* SocketClient::popSendPacket(SendLane* laneOut) {
+    Packet* packet = nullptr;
+
+    for (int lane = SendLane::CRITICAL; lane < SendLane::REALTIME; lane++) {
+        if (mSendQueues[lane].pop(&packet)) {
+            *laneOut = static_cast<SendLane>(lane);
+            return packet;
+        }
+    }
+
+    for (int i = 0; i < LATESTSLOTCOUNT; i++) {
+        if ((packet = mLatestPackets[i].exchange(nullptr))) {
+            *laneOut = SendLane::REALTIME;
+            return packet;
+        }
+    }
+
+    return nullptr;
+}
+
+/**
+ * @brief drains the send queue into a single frame, so that packets queued together (e.g. everything sent on a moon grab) go out in one Send call
+ * 
+ * @return false if the send thread was woken up without a packet or sending failed
+ */
 bool SocketClient::trySendQueue() {
 
-    Packet* curPacket = (Packet*)mSendQueue.pop(sead::MessageQueue::BlockType::Blocking);
+    // whatever was kept back when the last connection dropped goes out before anything new
+    if (!flushSendFrame())
+        return false;
+
+    Packet* curPacket = mHeldPacket;
+    SendLane curLane = mHeldLane;
+    mHeldPacket = nullptr;
 
-    bool successful = send(curPacket);
+    while (!curPacket && !(curPacket = popSendPacket(&curLane))) {
+        if (mSendWake)
+            return false;
+
+        nn::os::WaitEvent(&mSendEvent);
+    }
 
-    mHeap->free(curPacket);
+    sead::TickTime batchStart;
+    int batchCount = 0;
+    bool isCritical = false;
 
-    return successful;
+    while (curPacket) {
+
+        // datagrams keep their own boundaries, so udp packets are never coalesced
+        bool isUdp = isUdpPacket(curPacket);
+        bool successful = isUdp ? isSendAllowed() && send(curPacket) : appendToSendFrame(curPacket);
+
+        if (!successful && !isUdp) {
+            // the connection dropped before this one made it into the frame, it goes first on the next one
+            mHeldPacket = curPacket;
+            mHeldLane = curLane;
+            return false;
+        }
+
+        // udp packets are only ever the latest state, a lost one is replaced by the next
+        if (successful)
+            mSentCounts[curLane].fetch_add(1, std::memory_order_relaxed);
+
+        isCritical |= curLane == SendLane::CRITICAL;
+
+        mHeap->free(curPacket);
+
+        if (++batchCount >= mMaxBatchCount)
+            break;
+
+        curPacket = popSendPacket(&curLane);
+
+        // the frame goes out as soon as the queue runs dry, unless a deadline is set and nothing in it is critical,
+        // in which case the game thread gets until the deadline to queue related packets
+        while (!curPacket && !isCritical && !mSendWake) {
+            s64 remainingUs = mFlushDeadlineUs - batchStart.diffToNow().toMicroSeconds();
+            if (remainingUs <= 0 || !nn::os::TimedWaitEvent(&mSendEvent, nn::TimeSpan::FromNanoSeconds(remainingUs * 1000)))
+                break;
+            curPacket = popSendPacket(&curLane);
+        }
+    }
+
+    return flushSendFrame();
 }
 
-Packet* SocketClient::tryGetPacket(sead::MessageQueue::BlockType blockType) {
-    return socket_log_state == SOCKET_LOG_CONNECTED ? (Packet*)mRecvQueue.pop(blockType) : nullptr;
+/**
+ * @brief pops the next received packet, parking the read thread while nothing has arrived (including while reconnecting)
+ */
+Packet* SocketClient::tryGetPacket(bool isBlocking) {
+
+    u16 slot = 0;
+
+    while (true) {
+
+        if (mRecvQueue.pop(&slot)) {
+            if (slot & MESSAGESLOTFLAG)
+                return reinterpret_cast<Packet*>(mMessagePool + (slot & ~MESSAGESLOTFLAG) * MAXMESSAGESIZE);
+
+            return reinterpret_cast<Packet*>(mRecvPool + slot * MAXPACKSIZE);
+        }
+
+        if (!isBlocking || mRecvWake.exchange(false)) {
+            return nullptr;
+        }
+
+        nn::os::WaitEvent(&mRecvEvent);
+    }
+}
+
+u8 SocketClient::getPacketSessionId(const Packet* packet) {
+
+    const char* data = reinterpret_cast<const char*>(packet);
+
+    if (data < mRecvPool || data >= mRecvPool + mRecvPoolSize * MAXPACKSIZE) {
+        return NOSESSION;
+    }
+
+    return mRecvSessionIds[(data - mRecvPool) / MAXPACKSIZE];
+}
+
+/**
+ * @brief returns a packet acquired through tryGetPacket back to the receive pool
+ */
+void SocketClient::releasePacket(Packet* packet) {
+    if (!packet)
+        return;
+
+    char* data = reinterpret_cast<char*>(packet);
+
+    if (data >= mMessagePool && data < mMessagePool + MESSAGESLOTCOUNT * MAXMESSAGESIZE) {
+        releaseRecvSlot(((data - mMessagePool) / MAXMESSAGESIZE) | MESSAGESLOTFLAG);
+    } else {
+        releaseRecvSlot((data - mRecvPool) / MAXPACKSIZE);
+    }
+}
+
+/**
+ * @brief returns a recv queue entry to whichever pool it came from
+ */
+void SocketClient::releaseRecvSlot(u16 slot) {
+    if (slot & MESSAGESLOTFLAG) {
+        mFreeMessageSlots.push(slot & ~MESSAGESLOTFLAG);
+    } else {
+        mFreeRecvSlots.push(slot);
+    }
 }
 
+/**
+ * @brief discards every queued packet, only safe to call while the socket threads aren't running
+ */
 void SocketClient::clearMessageQueues() {
     bool prevQueueOpenness = this->mPacketQueueOpen;
     this->mPacketQueueOpen = false;
 
-    while (mSendQueue.getCount() > 0) {
-        Packet* curPacket = (Packet*)mSendQueue.pop(sead::MessageQueue::BlockType::Blocking);
+    Packet* curPacket = nullptr;
+    SendLane curLane = SendLane::NORMAL;
+    while ((curPacket = popSendPacket(&curLane))) {
         mHeap->free(curPacket);
     }
 
-    while (mRecvQueue.getCount() > 0) {
-        Packet* curPacket = (Packet*)mRecvQueue.pop(sead::MessageQueue::BlockType::Blocking);
-        mHeap->free(curPacket);
+    u16 slot = 0;
+    while (mRecvQueue.pop(&slot)) {
+        releaseRecvSlot(slot);
     }
+    resetAssembly();
 
     this->mPacketQueueOpen = prevQueueOpenness;
 }
@@ -0,0 +1,205 @@
+# Benchmark.py
+# Measures how fast handle_proxy's framing takes apart bursts of packets like the ones the mod sends, over a local socket,
+# and how long a check the game sends takes to reach send_msgs.
+#
+# usage (from World/smo): python3 -m Connector.Benchmark [packet count] [burst size] [check count]
+#
+# Every burst is written once in one go and once in uneven slices, so packets straddle reads the way they do over a
+# real link. The old read(header) then read(body) framing is run as a baseline, it loses its place in the stream as
+# soon as a read comes back short, and so is the same thing with readexactly, which is correct but pays two reads
+# and their copies per packet.
+#
+# Checks are sent one at a time at random intervals and timed from the game's write to the send_msgs call carrying
+# them, through MessagePump and through the 0.1s polling loop it replaced.
+
+import asyncio
+import random
+import sys
+import time
+
+from Connector.MessagePump import MessagePump
+from Connector.Packets import ItemType, Packet, PacketHeader, PacketReader, PacketType, ShineBitmapPacket
+
+GUID : bytes = bytes(range(16))
+# Largest slice of a burst written at once, roughly one tcp segment
+MAX_SLICE : int = 1400
+# Longest gap between two checks, seconds
+MAX_CHECK_GAP : float = 0.02
+
+
+def build_burst(burst_size : int) -> bytes:
+    # The mix the game sends after collecting a few things in a row
+    burst : bytearray = bytearray()
+    for index in range(burst_size):
+        match index % 4:
+            case 0 | 1:
+                packet = Packet(guid=GUID, packet_type=PacketType.Check,
+                                packet_data=[index, -1, 0, "obj%d" % index, "CapWorldHomeStage", 1])
+            case 2:
+                packet = Packet(guid=GUID, packet_type=PacketType.Ping, packet_data=[time.monotonic_ns(), index])
+            case _:
+                packet = Packet(guid=GUID, packet_type=PacketType.ShineBitmap,
+                                packet_data=[ShineBitmapPacket(data=bytes(ShineBitmapPacket.RAW_SIZE))])
+        burst += packet.serialize()
+    return bytes(burst)
+
+
+async def read_legacy(reader : asyncio.StreamReader, count : int) -> int:
+    received : int = 0
+    while received < count:
+        packet = Packet(guid=GUID, header_bytes=bytearray(await reader.read(PacketHeader.SIZE)))
+        packet.deserialize(bytearray(await reader.read(packet.header.packet_size)))
+        received += 1
+    return received
+
+
+async def read_exact(reader : asyncio.StreamReader, count : int) -> int:
+    received : int = 0
+    while received < count:
+        packet = Packet(guid=GUID, header_bytes=await reader.readexactly(PacketHeader.SIZE))
+        packet.deserialize(await reader.readexactly(packet.header.packet_size))
+        received += 1
+    return received
+
+
+async def read_framed(reader : asyncio.StreamReader, count : int) -> int:
+    packet_reader : PacketReader = PacketReader(reader)
+    received : int = 0
+    while received < count:
+        received += len(await packet_reader.read_batch())
+    return received
+
+
+async def run(name : str, read_func, burst : bytes, burst_size : int, count : int, max_slice : int | None) -> None:
+    done : asyncio.Future = asyncio.get_running_loop().create_future()
+
+    async def serve(reader : asyncio.StreamReader, writer : asyncio.StreamWriter) -> None:
+        start : float = time.perf_counter()
+        try:
+            received : int = await read_func(reader, count)
+            done.set_result((received, time.perf_counter() - start, None))
+        except Exception as e:
+            done.set_result((0, time.perf_counter() - start, e))
+        writer.close()
+
+    server : asyncio.Server = await asyncio.start_server(serve, "127.0.0.1", 0)
+    port : int = server.sockets[0].getsockname()[1]
+    reader, writer = await asyncio.open_connection("127.0.0.1", port)
+
+    slicer : random.Random = random.Random(1027)
+    try:
+        for _ in range(count // burst_size):
+            offset : int = 0
+            while offset < len(burst):
+                size : int = slicer.randint(1, max_slice) if max_slice else len(burst)
+                writer.write(burst[offset:offset + size])
+                offset += size
+                await writer.drain()
+            if done.done():
+                break
+    except ConnectionError:
+        # The reader gave up and closed the connection, the error it hit is reported below
+        pass
+
+    try:
+        received, elapsed, error = await asyncio.wait_for(done, 5.0)
+    except asyncio.TimeoutError:
+        received, elapsed, error = 0, 0.0, TimeoutError("still waiting on packets that were already sent")
+    writer.close()
+    server.close()
+
+    if error:
+        print(f"{name:14} desynchronized: {type(error).__name__}: {error}")
+    else:
+        print(f"{name:14} {received} packets in {elapsed * 1000:8.1f}ms  {received / elapsed:10.0f} packets/sec")
+
+
+class PollingPump:
+    # The comm_loop MessagePump replaced
+    POLL_INTERVAL : float = 0.1
+    msgs : list
+
+    def __init__(self):
+        self.msgs = []
+
+    def put(self, msg) -> None:
+        self.msgs.append(msg)
+
+    async def run(self, send, is_ready) -> None:
+        while True:
+            if len(self.msgs) > 0 and is_ready():
+                await send(self.msgs)
+                self.msgs = []
+            await asyncio.sleep(self.POLL_INTERVAL)
+
+
+async def run_checks(name : str, pump, count : int) -> None:
+    sent_times : dict[int, float] = {}
+    latencies : list[float] = []
+    send_count : int = 0
+    done : asyncio.Event = asyncio.Event()
+
+    async def send_msgs(msgs : list) -> None:
+        nonlocal send_count
+        now : float = time.perf_counter()
+        send_count += 1
+        for msg in msgs:
+            for location in msg["locations"]:
+                latencies.append(now - sent_times[location])
+        if len(latencies) == count:
+            done.set()
+
+    async def serve(reader : asyncio.StreamReader, writer : asyncio.StreamWriter) -> None:
+        # What handle_proxy does with a check
+        packet_reader : PacketReader = PacketReader(reader)
+        try:
+            while True:
+                for packet in await packet_reader.read_batch():
+                    pump.put({"cmd": "LocationChecks", "locations": [packet.packet.location_id]})
+        except (asyncio.IncompleteReadError, asyncio.CancelledError):
+            # The game side hung up once every check was in
+            pass
+
+    server : asyncio.Server = await asyncio.start_server(serve, "127.0.0.1", 0)
+    port : int = server.sockets[0].getsockname()[1]
+    reader, writer = await asyncio.open_connection("127.0.0.1", port)
+    pump_task : asyncio.Task = asyncio.create_task(pump.run(send_msgs, lambda: True))
+
+    spacing : random.Random = random.Random(1027)
+    for location in range(count):
+        sent_times[location] = time.perf_counter()
+        writer.write(Packet(guid=GUID, packet_type=PacketType.Check,
+                            packet_data=[location, ItemType.Moon, 0, "", "", 1]).serialize())
+        await writer.drain()
+        await asyncio.sleep(spacing.uniform(0, MAX_CHECK_GAP))
+    await asyncio.wait_for(done.wait(), 5.0)
+
+    pump_task.cancel()
+    writer.close()
+    server.close()
+
+    latencies.sort()
+    print(f"{name:14} {count} checks in {send_count:4} sends  p50 {latencies[count // 2] * 1000:7.2f}ms"
+          f"  p99 {latencies[count * 99 // 100] * 1000:7.2f}ms  max {latencies[-1] * 1000:7.2f}ms")
+
+
+async def main() -> None:
+    count : int = int(sys.argv[1]) if len(sys.argv) > 1 else 100000
+    burst_size : int = int(sys.argv[2]) if len(sys.argv) > 2 else 64
+    check_count : int = int(sys.argv[3]) if len(sys.argv) > 3 else 200
+    count -= count % burst_size
+    burst : bytes = build_burst(burst_size)
+    print(f"{count} packets in bursts of {burst_size} ({len(burst)} bytes)")
+
+    for max_slice, written in ((None, "whole"), (MAX_SLICE, "sliced")):
+        await run("framed " + written, read_framed, burst, burst_size, count, max_slice)
+        await run("exact " + written, read_exact, burst, burst_size, count, max_slice)
+        await run("legacy " + written, read_legacy, burst, burst_size, count, max_slice)
+
+    print(f"{check_count} checks up to {MAX_CHECK_GAP * 1000:.0f}ms apart, game to send_msgs")
+    await run_checks("pump", MessagePump(), check_count)
+    await run_checks("polling", PollingPump(), check_count)
+
+
+if __name__ == "__main__":
+    asyncio.run(main())
@@ -1,6 +1,8 @@
 import asyncio
 import functools
+import time
 import typing
+from collections import deque
 from copy import deepcopy
 
 import Utils
@@ -8,8 +10,11 @@ from NetUtils import encode, NetworkPlayer, NetworkItem, JSONtoTextParser, JSONM
 from MultiServer import Endpoint
 from CommonClient import get_base_parser, gui_enabled, logger, CommonContext, ClientCommandProcessor
 from typing import List, Any
-from .Packets import PacketHeader, PacketType, Packet, ItemType
+from .Packets import PacketHeader, PacketType, Packet, ItemType, FragmentAssembler, PacketReader
+from .SlotBundle import build_slot_tables, build_shine_text_table, build_slot_bundles, table_hash, TABLE_COUNT, \
+    TABLE_SHINE_TEXT, build_shine_bitmap, read_shine_bitmap
 
+from .MessagePump import MessagePump
 from .Data import inverse_shop_items, shop_items, get_item_type, worlds, world_alias, valid_warps, inverse_worlds, \
     multi_moon_locations, world_prefixes
 from .Player import SMOPlayer
@@ -40,7 +45,7 @@ class SMOCommandProcessor(ClientCommandProcessor):
         if isinstance(self.ctx, SMOContext):
             logger.info(f"SMO Status: Syncing")
             self.ctx.player_data.item_index = 0
-            self.ctx.server_msgs.append({"cmd" : "Sync"})
+            self.ctx.server_msgs.put({"cmd" : "Sync"})
             # Add the sending locations part here if necessary.
 
     def _cmd_warp(self, kingdom : str, scenario : int = -1):
@@ -57,14 +62,14 @@ class SMOCommandProcessor(ClientCommandProcessor):
                 logger.info(f"{kingdom} is not a valid warp.\nValid warps: {warps}")
             else:
                 logger.info(f"Sending Mario to {valid_warps[kingdom]}")
-                self.ctx.player_data.add_message(f"Sending Mario to {valid_warps[kingdom]}")
-                self.ctx.proxy_msgs.append(Packet(guid=self.ctx.proxy_guid, packet_type=PacketType.ChangeStage,
-                                                 packet_data=[kingdom, scenario]))
+                self.ctx.add_chat_message(f"Sending Mario to {valid_warps[kingdom]}")
+                self.ctx.queue_proxy_msg(Packet(guid=self.ctx.proxy_guid, packet_type=PacketType.ChangeStage,
+                                               packet_data=[kingdom, scenario]))
 
     # def _cmd_unlock(self, kingdom : int, scenario : int = -1):
     #     if isinstance(self.ctx, SMOContext):
     #         logger.info(f"Unlocking Kingdom {kingdom}")
-    #         self.ctx.player_data.add_message(f"Kingdom Unlocked")
+    #         self.ctx.add_chat_message(f"Kingdom Unlocked")
     #         self.ctx.proxy_msgs.append(Packet(guid=self.ctx.proxy_guid, packet_type=PacketType.Progress,
     #                                       packet_data=[kingdom, scenario]))
 
@@ -88,19 +93,37 @@ class SMOContext(CommonContext):
         self.game_connected : bool = False
         self.awaiting_info : bool = False
         self.full_inventory: List[Any] = []
-        self.server_msgs: List[Any] = []
+        self.server_msgs : MessagePump = MessagePump()
         self.server_comm_task = None
-        self.proxy_msgs : List[Packet] = []
+        # Packets for the game, written by proxy_writer_loop as soon as it connects
+        self.proxy_msgs : deque[Packet] = deque()
+        # Sent ahead of everything else, held checks included
+        self.urgent_proxy_msgs : deque[Packet] = deque()
+        # Checks that arrived before the game reported which kingdom it is in, released once it does
+        self.held_proxy_msgs : deque[Packet] = deque()
+        self.proxy_msgs_event : asyncio.Event = asyncio.Event()
         self.proxy_guid : bytearray = bytearray()
         self.player_data : SMOPlayer = SMOPlayer()
         self.player = None
         self.slot_data : dict = {}
+        # Encoded once per Connected, only the tables the game doesn't hold yet are sent
+        self.slot_tables : dict[int, bytes] = {}
+        # Hash of every table the game holds, as reported in its Connect packet and updated as tables are sent
+        self.game_table_hashes : list[int] = [0] * TABLE_COUNT
         #self.checked_locations : set
-        self.ping_task = None
         self.awaiting_connection : bool = False
-        self.disconnect_timer : int = 120
+        self.proxy_writer : asyncio.StreamWriter | None = None
+        self.fragment_assembler : FragmentAssembler = FragmentAssembler()
+        self.last_packet_time : float = 0.0
+        self.received_pong : bool = False
+        self.ping_sequence : int = 0
+        # Milliseconds, rtt is negative until the first Pong arrives
+        self.smoothed_rtt : float = -1.0
+        self.rtt_jitter : float = 0.0
         self.logged_in : bool = False
         self.multi_moon_anim : bool = False
+        # Set whenever there is something new for proxy_chat to show
+        self.chat_event : asyncio.Event = asyncio.Event()
         self.death_link_enabled : bool = False
 
     async def server_auth(self, password_requested: bool = False):
@@ -114,8 +137,23 @@ class SMOContext(CommonContext):
         if not self.game_connected:
             return "Not connected to Super Mario Odyssey"
 
+        if self.smoothed_rtt >= 0:
+            return f"Connected to Super Mario Odyssey (Ping: {self.smoothed_rtt:.2f}ms Jitter: {self.rtt_jitter:.2f}ms)"
+
         return "Connected to Super Mario Odyssey"
 
+    def update_rtt(self, sample : float):
+        """
+        Folds a round trip sample (in milliseconds) into the smoothed rtt and jitter the same way TCP does (RFC 6298)
+        """
+        self.received_pong = True
+        if self.smoothed_rtt < 0:
+            self.smoothed_rtt = sample
+            self.rtt_jitter = sample / 2
+            return
+        self.rtt_jitter = 0.75 * self.rtt_jitter + 0.25 * abs(self.smoothed_rtt - sample)
+        self.smoothed_rtt = 0.875 * self.smoothed_rtt + 0.125 * sample
+
     async def disconnect(self, allow_autoreconnect: bool = False):
         await super().disconnect(allow_autoreconnect)
 
@@ -130,7 +168,7 @@ class SMOContext(CommonContext):
     def on_print_json(self, args: dict):
         text = self.gamejsontotext(deepcopy(args["data"]))
         if "type" in args and args["type"] in message_types:
-            self.player_data.add_message(text)
+            self.add_chat_message(text)
 
         if self.ui:
             self.ui.print_json(args["data"])
@@ -138,167 +176,101 @@ class SMOContext(CommonContext):
             text = self.jsontotextparser(args["data"])
             logger.info(text)
 
+    def can_send_server_msgs(self) -> bool:
+        if not self.is_connected():
+            self.logged_in = False
+        return self.logged_in
+
+    def add_chat_message(self, text : str):
+        self.player_data.add_message(text)
+        self.chat_event.set()
+
+    def start_multi_moon_anim(self):
+        """
+        Holds back items and chat while the game plays the multi moon animation, then syncs whatever was held back
+        """
+        if self.multi_moon_anim:
+            return
+        self.multi_moon_anim = True
+        asyncio.get_running_loop().call_later(MULTI_MOON_ANIM_TIME, self.end_multi_moon_anim)
+
+    def end_multi_moon_anim(self):
+        self.multi_moon_anim = False
+        self.server_msgs.put({"cmd": "Sync"})
+        self.chat_event.set()
+
+    def queue_proxy_msg(self, packet : Packet, urgent : bool = False):
+        """
+        Queues a packet for the game and wakes the writer
+        :param urgent: send it ahead of everything already queued
+        """
+        if urgent:
+            self.urgent_proxy_msgs.append(packet)
+        else:
+            self.proxy_msgs.append(packet)
+        self.proxy_msgs_event.set()
+
+    def take_proxy_msgs(self) -> list[Packet]:
+        """
+        :return: every queued packet that can be sent right now, urgent ones first, then held checks as they were
+                 queued before the rest
+        """
+        packets : list[Packet] = list(self.urgent_proxy_msgs)
+        self.urgent_proxy_msgs.clear()
+        if self.player_data.current_home_stage != "":
+            packets.extend(self.held_proxy_msgs)
+            self.held_proxy_msgs.clear()
+        while self.proxy_msgs:
+            packet : Packet = self.proxy_msgs.popleft()
+            # The game can't place items before it knows where it is
+            if packet.header.packet_type == PacketType.Check and self.player_data.current_home_stage == "":
+                self.held_proxy_msgs.append(packet)
+            else:
+                packets.append(packet)
+        return packets
+
     def update_items(self):
         # just to be safe - we might still have an inventory from a different room
         if not self.is_connected():
             return
 
-        self.server_msgs.append({"cmd": "ReceivedItems", "index": 0, "items": self.full_inventory})
+        self.server_msgs.put({"cmd": "ReceivedItems", "index": 0, "items": self.full_inventory})
 
     def forward_slot_data(self):
         """
         Forwards Slot Data from Archipelago Lobby connection to SMO
         :return:
         """
-        #print(self.slot_data)
-        self.proxy_msgs.append(Packet(guid=self.proxy_guid, packet_type=PacketType.SlotData,
-              packet_data=[self.slot_data["counts"]["cascade"],
-                           self.slot_data["counts"]["sand"],
-                           self.slot_data["counts"]["wooded"], self.slot_data["counts"]["lake"],
-                           self.slot_data["counts"]["lost"], self.slot_data["counts"]["metro"],
-                           self.slot_data["counts"]["seaside"],
-                           self.slot_data["counts"]["snow"],
-                           self.slot_data["counts"]["luncheon"],
-                           self.slot_data["counts"]["ruined"],
-                           self.slot_data["counts"]["bowser"], self.slot_data["counts"]["dark"],
-                           self.slot_data["counts"]["darker"],
-                           self.slot_data["regionals"], self.slot_data["capture_sanity"]]))
-
-
-
-        # Games
-        for i in range(0, len(self.slot_data["shop_games"]), 3):
-            if i + 3 < len(self.slot_data["shop_games"]):
-        #        print(self.slot_data["shop_games"][i:i + 3])
-                self.proxy_msgs.append(Packet(guid=self.proxy_guid, packet_type=PacketType.ApInfo,
-                                              packet_data=[0, i, i+1, i+2, self.slot_data["shop_games"][i:i + 3]]))
-            else:
-        #        print(self.slot_data["shop_games"][i:i + 3])
-                self.proxy_msgs.append(Packet(guid=self.proxy_guid, packet_type=PacketType.ApInfo,
-                                              packet_data=[0, i, i+1, i+2, self.slot_data["shop_games"][
-                                                              i:len(self.slot_data["shop_games"])]]))
-        # Players
-        for i in range(0, len(self.slot_data["shop_players"]), 3):
-            if i + 3 < len(self.slot_data["shop_players"]):
-                #print(self.slot_data["shop_players"][i:i + 3])
-                self.proxy_msgs.append(Packet(guid=self.proxy_guid, packet_type=PacketType.ApInfo,
-                                              packet_data=[1, i, i+1, i+2, self.slot_data["shop_players"][i:i + 3]]))
-            else:
-                #print(self.slot_data["shop_players"][i:i + 3])
-                self.proxy_msgs.append(Packet(guid=self.proxy_guid, packet_type=PacketType.ApInfo,
-                                              packet_data=[1, i, i+1, i+2, self.slot_data["shop_players"][
-                                                              i:len(self.slot_data["shop_players"])]]))
-        # Items
-        for i in range(0, len(self.slot_data["shop_ap_items"]), 3):
-            if i + 3 < len(self.slot_data["shop_ap_items"]):
-                #print(self.slot_data["shop_ap_items"][i:i + 3])
-                self.proxy_msgs.append(Packet(guid=self.proxy_guid, packet_type=PacketType.ApInfo,
-                                              packet_data=[2, i, i+1, i+2, self.slot_data["shop_ap_items"][i:i + 3]]))
-            else:
-                #print(self.slot_data["shop_ap_items"][i:i + 3])
-                self.proxy_msgs.append(Packet(guid=self.proxy_guid, packet_type=PacketType.ApInfo,
-                                              packet_data=[2, i, i+1, i+2, self.slot_data["shop_ap_items"][
-                                                              i:len(self.slot_data["shop_ap_items"])]]))
-
-        items = []
-        for i in range(2501, 2539):
-            if str(i) in self.slot_data["shop_replace_data"]["caps"]:
-                items.append(self.slot_data["shop_replace_data"]["caps"][str(i)])
-            else:
-                items.append([254,254,254,254])
-        for i in range(2577, 2582):
-            if str(i) in self.slot_data["shop_replace_data"]["caps"]:
-                items.append(self.slot_data["shop_replace_data"]["caps"][str(i)])
-            else:
-                items.append([254,254,254,254])
-
-        self.proxy_msgs.append(Packet(guid=self.proxy_guid, packet_type=PacketType.ShopReplace, packet_data=[0, items]))
-        #print(len(items), items)
-
-        items = []
-        for i in range(2539, 2582):
-            if str(i) in self.slot_data["shop_replace_data"]["clothes"]:
-                items.append(self.slot_data["shop_replace_data"]["clothes"][str(i)])
-            else:
-                items.append([254,254,254,254])
-        self.proxy_msgs.append(Packet(guid=self.proxy_guid, packet_type=PacketType.ShopReplace, packet_data=[1, items]))
-        #print(len(items), items)
-
-        items = []
-        for i in range(2582, 2599):
-            if str(i) in self.slot_data["shop_replace_data"]["stickers"]:
-                items.append(self.slot_data["shop_replace_data"]["stickers"][str(i)])
-            else:
-                items.append([254,254,254,254])
-        self.proxy_msgs.append(Packet(guid=self.proxy_guid, packet_type=PacketType.ShopReplace, packet_data=[2, items]))
-
-        items = []
-        for i in range(2599, 2625):
-            if str(i) in self.slot_data["shop_replace_data"]["souvenirs"]:
-                items.append(self.slot_data["shop_replace_data"]["souvenirs"][str(i)])
-            else:
-                items.append([254,254,254,254])
-        self.proxy_msgs.append(Packet(guid=self.proxy_guid, packet_type=PacketType.ShopReplace, packet_data=[3, items]))
-
-        items = []
-        for i in range(0, 2499):
-            if str(i) in self.slot_data["shop_replace_data"]["moons"]:
-                items.append(self.slot_data["shop_replace_data"]["moons"][str(i)])
-        self.proxy_msgs.append(Packet(guid=self.proxy_guid, packet_type=PacketType.ShopReplace, packet_data=[4, items]))
-
-        # Colors
-        print(self.slot_data["shine_colors"])
-        data = [[]]
-        for shine_uid in range(0, 1168):
-            if len(data[-1]) == 51:
-                data.append([])
-            if shine_uid > 1167:
-                break
-            if str(shine_uid) in self.slot_data["shine_colors"]:
-                data[-1].append([shine_uid, self.slot_data["shine_colors"][str(shine_uid)]])
-        print(data)
-        for i in data:
-            self.proxy_msgs.append(Packet(guid=self.proxy_guid, packet_type=PacketType.ShineColor,
-                                          packet_data=[i]))
-            #print(self.proxy_msgs[-1].packet.info)
-
-        # Checked locations
-        data = [[]]
-        for loc in self.checked_locations:
-            if len(data[-1]) == 100:
-                data.append([])
-            if loc < 1167:
-                data[-1].append(loc)
-        for i in data:
-            self.proxy_msgs.append(Packet(guid=self.proxy_guid, packet_type=PacketType.ShineChecks,
-                                              packet_data=[i]))
+        changed_tables : dict[int, bytes] = {table: body for table, body in self.slot_tables.items()
+                                             if table_hash(body) != self.game_table_hashes[table]}
+        self.forward_slot_tables(changed_tables)
+        self.forward_checked_locations()
+
+    def forward_slot_tables(self, tables : dict[int, bytes]):
+        for bundle in build_slot_bundles(tables):
+            self.queue_proxy_msg(Packet(guid=self.proxy_guid, packet_type=PacketType.SlotBundle,
+                                        packet_data=[bundle]))
+        for table, body in tables.items():
+            self.game_table_hashes[table] = table_hash(body)
+
+    def forward_checked_locations(self):
+        # Every checked shine as one bitmap the game merges into its own
+        checks = [loc for loc in self.checked_locations if loc < 1167]
+        if checks:
+            self.queue_proxy_msg(Packet(guid=self.proxy_guid, packet_type=PacketType.ShineBitmap,
+                                        packet_data=[build_shine_bitmap(checks)]))
 
     def forward_shine_data(self):
         world_id = world_prefixes.index(self.player_data.current_home_stage)
-        self.proxy_msgs.append(Packet(guid=self.proxy_guid, packet_type=PacketType.ShineReplace,
-                                         packet_data=[self.slot_data["shine_replace_data"][str(world_id)]]))
-        # Items
-        #print(self.slot_data["shine_replace_data"][str(world_id)])
-        for i in range(0, len(self.slot_data["shine_items"][str(world_id)]), 3):
-            if i + 3 < len(self.slot_data["shine_items"][str(world_id)]):
-                #print(self.slot_data["shine_items"][str(world_id)][i:i + 3])
-                self.proxy_msgs.append(Packet(guid=self.proxy_guid, packet_type=PacketType.ApInfo,
-                                             packet_data=[3, i, i + 1, i + 2,
-                                                          self.slot_data["shine_items"][str(world_id)][
-                                                          i:i + 3]]))
-            else:
-                #print(self.slot_data["shine_items"][str(world_id)][i:i + 3])
-                self.proxy_msgs.append(Packet(guid=self.proxy_guid, packet_type=PacketType.ApInfo,
-                                             packet_data=[3, i, i + 1, i + 2,
-                                                          self.slot_data["shine_items"][str(world_id)][
-                                                          i:len(
-                                                              self.slot_data["shine_items"][str(world_id)])]]))
+        shine_text : bytes = build_shine_text_table(self.slot_data, world_id)
+        if table_hash(shine_text) != self.game_table_hashes[TABLE_SHINE_TEXT]:
+            self.forward_slot_tables({TABLE_SHINE_TEXT: shine_text})
 
     def on_deathlink(self, data: typing.Dict[str, typing.Any]) -> None:
         if self.death_link_enabled:
             super().on_deathlink(data)
             death_link_packet : Packet = Packet(guid=self.proxy_guid, packet_type=PacketType.DeathLink)
-            self.proxy_msgs.append(death_link_packet)
+            self.queue_proxy_msg(death_link_packet)
             self.last_death_link = data["time"]
 
     # Handle sending packets to SMO here
@@ -319,23 +291,26 @@ class SMOContext(CommonContext):
                     # Only put our player info in there as we actually need it
                     json["players"] = [me]
                     self.slot_data = json["slot_data"]
+                    self.slot_tables = build_slot_tables(self.slot_data)
                     #self.checked_locations = json["checked_locations"]
                 self.player = me
-                self.player_data.add_message(f"Connected to Archipelago as {me.name} playing Super Mario Odyssey")
+                self.add_chat_message(f"Connected to Archipelago as {me.name} playing Super Mario Odyssey")
                 # Send slot data to SMO
                 self.forward_slot_data()
                 self.player_data.goal = self.slot_data["goal"]
                 self.death_link_enabled = self.slot_data["death_link"]
                 self.logged_in = True
+                # Flush whatever was queued before logging in
+                self.server_msgs.wake()
 
                 if self.death_link_enabled:
-                    self.server_msgs.append({"cmd" : "ConnectUpdate", "tags" : ["AP", "DeathLink"]})
-                self.server_msgs.append({"cmd" : "Get", "keys" : [f"{self.player.name}_scenarios"]})
+                    self.server_msgs.put({"cmd" : "ConnectUpdate", "tags" : ["AP", "DeathLink"]})
+                self.server_msgs.put({"cmd" : "Get", "keys" : [f"{self.player.name}_scenarios"]})
                 # if DEBUG:
                 #     print(json)
                 self.connected_msg = encode([json])
                 if self.awaiting_info:
-                    self.server_msgs.append(self.room_info)
+                    self.server_msgs.put(self.room_info)
                     self.update_items()
                     self.awaiting_info = False
 
@@ -345,7 +320,7 @@ class SMOContext(CommonContext):
                 if "players" in json.keys():
                     json["players"] = []
 
-                self.server_msgs.append(json)
+                self.server_msgs.put(json)
 
             case "ReceivedItems":
                 # Handle Sending various collect packets to SMO here
@@ -362,7 +337,7 @@ class SMOContext(CommonContext):
 
                 if args["index"] != self.player_data.item_index:
                     print("Next index mismatch, syncing.")
-                    self.server_msgs.append({"cmd" : "Sync"})
+                    self.server_msgs.put({"cmd" : "Sync"})
                 else:
                     self.player_data.item_index += 1
 
@@ -429,11 +404,11 @@ class SMOContext(CommonContext):
                             if packet.packet.location_id < 0:
                                 logger.info("Invalid Location ID in packet.")
                             else:
-                                self.proxy_msgs.append(packet)
+                                self.queue_proxy_msg(packet)
                         else:
-                            self.proxy_msgs.append(packet)
+                            self.queue_proxy_msg(packet)
 
-                self.server_msgs.append(args)
+                self.server_msgs.put(args)
 
             case "RoomInfo":
                 self.seed_name = args["seed_name"]
@@ -450,16 +425,16 @@ class SMOContext(CommonContext):
                 #         #                             packet_data=[inverse_worlds[world], self.player_data.world_scenarios[world]]))
                 #         #pass
                 #
-                #     self.server_msgs.append({"cmd": "Set", "key": f"{self.player.name}_scenarios",
+                #     self.server_msgs.put({"cmd": "Set", "key": f"{self.player.name}_scenarios",
                 #                              "operations": [
                 #                                  {"operation": "replace", "value": self.player_data.world_scenarios}]})
                 # else:
-                #     self.server_msgs.append({"cmd" : "Set", "key" : f"{self.player.name}_scenarios",
+                #     self.server_msgs.put({"cmd" : "Set", "key" : f"{self.player.name}_scenarios",
                 #                             "operations" : [{ "operation" : "replace", "value" : self.player_data.world_scenarios}]})
 
             case _:
                 if cmd != "PrintJSON":
-                    self.server_msgs.append(args)
+                    self.server_msgs.put(args)
 
     def run_gui(self):
         from kvui import GameManager
@@ -473,13 +448,29 @@ class SMOContext(CommonContext):
         self.ui = SMOManager(self)
         self.ui_task = asyncio.create_task(self.ui.async_run(), name="UI")
 
-async def ping_loop(ctx : SMOContext):
-    while not ctx.exit_event.is_set():
-        if ctx.endpoint:
-            if ctx.disconnect_timer == 0:
+PING_INTERVAL : float = 1.0
+# Seconds without any packet before a game that answers pings is considered gone
+DEAD_PEER_TIMEOUT : float = 5.0
+# Seconds every chat line stays at the bottom of the game's chat before the next one scrolls it up
+CHAT_SCROLL_INTERVAL : float = 5.0
+# Seconds the game spends on the multi moon animation, it drops items received during it
+MULTI_MOON_ANIM_TIME : float = 27.0
+
+async def ping_loop(ctx : SMOContext, writer : asyncio.StreamWriter):
+    # Runs for as long as handle_proxy holds a connection to the game
+    while True:
+        if ctx.game_connected:
+            # Older mods never answer pings, so only time out once we know this one does
+            if ctx.received_pong and time.monotonic() - ctx.last_packet_time > DEAD_PEER_TIMEOUT:
+                logger.info("SMO stopped responding")
                 ctx.game_connected = False
-            ctx.disconnect_timer = 1
-        await asyncio.sleep(1.0)
+                writer.close()
+                return
+            ping : Packet = Packet(guid=ctx.proxy_guid, packet_type=PacketType.Ping,
+                                   packet_data=[time.monotonic_ns(), ctx.ping_sequence])
+            ctx.ping_sequence += 1
+            writer.write(ping.serialize())
+        await asyncio.sleep(PING_INTERVAL)
 
 
 
@@ -487,158 +478,162 @@ async def proxy_chat(ctx : SMOContext):
     try:
         clear_msgs : bool = False
         while not ctx.exit_event.is_set():
-            if (len(ctx.player_data.messages) > 0 or clear_msgs) and ctx.game_connected:
+            if (len(ctx.player_data.messages) > 0 or clear_msgs) and ctx.game_connected and not ctx.multi_moon_anim:
                 msg_packet : Packet = Packet(guid=ctx.proxy_guid, packet_type=PacketType.ArchipelagoChat,
                                              packet_data=[ctx.player_data.next_messages()])
-                ctx.proxy_msgs.append(msg_packet)
+                ctx.queue_proxy_msg(msg_packet)
                 if len(ctx.player_data.messages) == 0 and not clear_msgs:
                     clear_msgs = True
                 else:
                     clear_msgs = False
-            if ctx.multi_moon_anim:
-                await asyncio.sleep(27.0)
-                ctx.multi_moon_anim = False
-                ctx.server_msgs.append({"cmd": "Sync"})
-
-
-            else:
-                await asyncio.sleep(5.0)
+                # Give the line just shown time to be read before the next one scrolls it away, a cleared chat
+                # has nothing to read so whatever comes next is shown right away
+                if clear_msgs or len(ctx.player_data.messages) > 0:
+                    await asyncio.sleep(CHAT_SCROLL_INTERVAL)
+                    continue
+            await ctx.chat_event.wait()
+            ctx.chat_event.clear()
     except Exception as e:
         logger.exception(e)
 
 
 async def handle_proxy(reader : asyncio.StreamReader, writer : asyncio.StreamWriter, ctx : SMOContext) -> None:
-    data : bytearray
+    packet_reader : PacketReader = PacketReader(reader)
     packet : Packet
     ctx.endpoint = Endpoint(writer.transport.get_extra_info("socket"))
+    ctx.proxy_writer = writer
     ctx.awaiting_connection = True
+    ctx.fragment_assembler.reset()
+    write_task : asyncio.Task = asyncio.create_task(proxy_writer_loop(ctx, writer), name="ProxyWriter")
+    ping_task : asyncio.Task = asyncio.create_task(ping_loop(ctx, writer), name="PingLoop")
     try:
         while True:
-            data : bytearray = bytearray(await reader.read(PacketHeader.SIZE))
-            packet = Packet(guid=ctx.proxy_guid, header_bytes=data)
-            if len(ctx.proxy_guid) == 0:
-                if len(packet.header.guid) != 0:
-                    ctx.proxy_guid = packet.header.guid
-                    if len(ctx.proxy_msgs) > 0:
-                        for queued_packet in ctx.proxy_msgs:
-                            if queued_packet.header.guid == "None":
-                                queued_packet.header.guid = ctx.proxy_guid
-
-            packet_size : int = packet.header.packet_size.value
-            data = bytearray(await reader.read(packet_size))
-            packet.deserialize(data)
-
-            if packet.header.packet_type != PacketType.Unknown:
-                ctx.disconnect_timer = 30
-                # Prevent appending server message before connected to server.
-            match packet.header.packet_type:
-                case PacketType.Connect:
-                    if ctx.proxy_guid != packet.header.guid:
+            # Everything the game sent since the last read is handled as one batch
+            for packet in await packet_reader.read_batch():
+                if len(ctx.proxy_guid) == 0:
+                    if len(packet.header.guid) != 0:
                         ctx.proxy_guid = packet.header.guid
-                    init_packet = Packet(guid=ctx.proxy_guid, packet_type=PacketType.Init)
-                    # Insert init packet at 0 in queue so other packets added before aren't dropped.
-                    ctx.proxy_msgs.insert(0, init_packet)
-                    # Only log initial connection
-                    logger.info("SMO Connected")
-                    if ctx.awaiting_connection:
-                        ctx.awaiting_connection = False
-                        ctx.game_connected = True
-                    needs_slot_data : bool = True
-                    for queued_packet in ctx.proxy_msgs:
-                        if queued_packet.header.packet_type == PacketType.SlotData:
-                            needs_slot_data = False
-                            break
-                    if len(ctx.slot_data) > 0 and needs_slot_data:
-                        ctx.forward_slot_data()
-                        if ctx.player_data.current_home_stage in world_prefixes:
-                            ctx.forward_shine_data()
-                    ctx.server_msgs.append({"cmd": "Sync"})
-
-                case PacketType.Disconnect:
-                    ctx.game_connected = False
-                    break
-
-                case PacketType.ChangeStage:
-                    stage : str = packet.packet.stage
-                    if stage[0:stage.index("World")] != ctx.player_data.current_home_stage:
-                        ctx.player_data.current_home_stage = stage[0:stage.index("World")]
-                        print(f"Player Changed Home Stage to {ctx.player_data.current_home_stage}")
-
-                        if ctx.is_connected() and ctx.player_data.current_home_stage in world_prefixes:
-                            ctx.forward_shine_data()
-
-                case PacketType.Check:
-                    print(packet.packet.location_id, packet.packet.item_type)
-                    location_id = packet.packet.location_id
-                    item_type : int = packet.packet.item_type.value
-                    match item_type:
-                        case -1:
-                            shine_id: int = packet.packet.location_id
-                            print(f"Got {shine_id}")
-                            if shine_id in multi_moon_locations:
-                                ctx.multi_moon_anim = True
-                            ctx.server_msgs.append({"cmd": "LocationChecks", "locations" : [shine_id]})
-                            if ctx.player_data.check_goal(shine_id):
-                                ctx.server_msgs.append({"cmd" : "StatusUpdate", "status" : ClientStatus.CLIENT_GOAL})
-                                print("Goal achieved")
-                        case 0:
-                            print(f"Got Clothes {location_id}")
-                            location_id = packet.packet.location_id + 2538
-                            ctx.server_msgs.append({"cmd": "LocationChecks", "locations": [location_id]})
-                        case 1:
-                            print(f"Got Cap {location_id}")
-                            location_id = (packet.packet.location_id + 2500) if packet.packet.location_id < 39 else (2538 + packet.packet.location_id)
-                            print(f"Got adjusted Cap {location_id}")
-                            ctx.server_msgs.append({"cmd": "LocationChecks", "locations": [location_id]})
-                        case 2:
-                            print(f"Got Souvenir {location_id}")
-                            location_id = packet.packet.location_id + 2599
-                            ctx.server_msgs.append({"cmd": "LocationChecks", "locations": [location_id]})
-                        case 3:
-                            print(f"Got Sticker {location_id}")
-                            location_id = packet.packet.location_id + 2582
-                            ctx.server_msgs.append({"cmd": "LocationChecks", "locations": [location_id]})
-                        case 5:
-                            print(f"Got Capture {location_id}")
-                            location_id = packet.packet.location_id + 3701
-                            ctx.server_msgs.append({"cmd": "LocationChecks", "locations": [location_id]})
-                        # Add Regional Coin
-
-                case PacketType.DeathLink:
-                    if ctx.death_link_enabled:
-                        await ctx.send_death()
-
-            if len(ctx.proxy_msgs) > 0 and ctx.game_connected:
-                # num_bytes = 0
-                # packets = 0
-                # for i in ctx.proxy_msgs:
-                #     num_bytes += 20
-                #     num_bytes += i.packet.SIZE
-                #     if num_bytes < 4096:
-                #         packets += 1
-
-
-                #print(num_bytes)
-                #print(packets)
-                packet_send_offset : int = 0
-                for i in range(len(ctx.proxy_msgs)):
-                    if ctx.proxy_msgs[0].header.packet_type == PacketType.Check and ctx.player_data.current_home_stage == "":
-                        packet_send_offset += 1
-                        #print("Skipping packet cannot be sent now")
+                        if len(ctx.proxy_msgs) > 0:
+                            for queued_packet in ctx.proxy_msgs:
+                                if queued_packet.header.guid == "None":
+                                    queued_packet.header.guid = ctx.proxy_guid
+
+                if packet.header.packet_type == PacketType.Fragment:
+                    message : bytearray | None = ctx.fragment_assembler.add(packet.packet)
+                    if message is None:
                         continue
-                    response : Packet = ctx.proxy_msgs.pop(packet_send_offset)
-                    b = response.serialize()
-                    # if response.header.packet_type == PacketType.ShineColor:
-                    #     print("This one", b[20:])
-                    writer.write(b)
-                    await writer.drain()
-                    if response.header.packet_type == PacketType.Connect:
-                        await asyncio.sleep(5.0)
+                    view : memoryview = memoryview(message)
+                    packet = Packet(guid=ctx.proxy_guid, header_bytes=view[:PacketHeader.SIZE])
+                    packet.deserialize(view[PacketHeader.SIZE:])
+
+                if packet.header.packet_type != PacketType.Unknown:
+                    ctx.last_packet_time = time.monotonic()
+                    # Prevent appending server message before connected to server.
+                match packet.header.packet_type:
+                    case PacketType.Connect:
+                        if ctx.proxy_guid != packet.header.guid:
+                            ctx.proxy_guid = packet.header.guid
+                        # Whatever the game reports holding replaces what we assumed it got before the connection dropped
+                        ctx.game_table_hashes = packet.packet.table_hashes[:TABLE_COUNT]
+                        ctx.game_table_hashes += [0] * (TABLE_COUNT - len(ctx.game_table_hashes))
+                        init_packet = Packet(guid=ctx.proxy_guid, packet_type=PacketType.Init)
+                        # Ahead of everything queued before so none of it is dropped by the game before it's initialized
+                        ctx.queue_proxy_msg(init_packet, urgent=True)
+                        ctx.received_pong = False
+                        ctx.smoothed_rtt = -1.0
+                        # Only log initial connection
+                        logger.info("SMO Connected")
+                        if ctx.awaiting_connection:
+                            ctx.awaiting_connection = False
+                            ctx.game_connected = True
+                            # Chat that piled up while the game was away
+                            ctx.chat_event.set()
+                        # Bundles still queued are dropped, the tables in them are compared against the game's hashes again below
+                        ctx.proxy_msgs = deque(queued_packet for queued_packet in ctx.proxy_msgs
+                                               if queued_packet.header.packet_type != PacketType.SlotBundle)
+                        if len(ctx.slot_data) > 0:
+                            ctx.forward_slot_data()
+                            if ctx.player_data.current_home_stage in world_prefixes:
+                                ctx.forward_shine_data()
+                        ctx.server_msgs.put({"cmd": "Sync"})
+
+                    case PacketType.Disconnect:
+                        # Ends the batch, the check at the bottom ends the connection
+                        ctx.game_connected = False
+                        break
+
+                    case PacketType.ChangeStage:
+                        stage : str = packet.packet.stage
+                        if stage[0:stage.index("World")] != ctx.player_data.current_home_stage:
+                            ctx.player_data.current_home_stage = stage[0:stage.index("World")]
+                            print(f"Player Changed Home Stage to {ctx.player_data.current_home_stage}")
+                            # Lets the writer release held checks
+                            ctx.proxy_msgs_event.set()
+
+                            if ctx.is_connected() and ctx.player_data.current_home_stage in world_prefixes:
+                                ctx.forward_shine_data()
+
+                    case PacketType.Check:
+                        print(packet.packet.location_id, packet.packet.item_type)
+                        location_id = packet.packet.location_id
+                        item_type : int = packet.packet.item_type.value
+                        match item_type:
+                            case -1:
+                                shine_id: int = packet.packet.location_id
+                                print(f"Got {shine_id}")
+                                if shine_id in multi_moon_locations:
+                                    ctx.start_multi_moon_anim()
+                                ctx.server_msgs.put({"cmd": "LocationChecks", "locations" : [shine_id]})
+                                if ctx.player_data.check_goal(shine_id):
+                                    ctx.server_msgs.put({"cmd" : "StatusUpdate", "status" : ClientStatus.CLIENT_GOAL})
+                                    print("Goal achieved")
+                            case 0:
+                                print(f"Got Clothes {location_id}")
+                                location_id = packet.packet.location_id + 2538
+                                ctx.server_msgs.put({"cmd": "LocationChecks", "locations": [location_id]})
+                            case 1:
+                                print(f"Got Cap {location_id}")
+                                location_id = (packet.packet.location_id + 2500) if packet.packet.location_id < 39 else (2538 + packet.packet.location_id)
+                                print(f"Got adjusted Cap {location_id}")
+                                ctx.server_msgs.put({"cmd": "LocationChecks", "locations": [location_id]})
+                            case 2:
+                                print(f"Got Souvenir {location_id}")
+                                location_id = packet.packet.location_id + 2599
+                                ctx.server_msgs.put({"cmd": "LocationChecks", "locations": [location_id]})
+                            case 3:
+                                print(f"Got Sticker {location_id}")
+                                location_id = packet.packet.location_id + 2582
+                                ctx.server_msgs.put({"cmd": "LocationChecks", "locations": [location_id]})
+                            case 5:
+                                print(f"Got Capture {location_id}")
+                                location_id = packet.packet.location_id + 3701
+                                ctx.server_msgs.put({"cmd": "LocationChecks", "locations": [location_id]})
+                            # Add Regional Coin
+
+                    case PacketType.ShineBitmap:
+                        # Shines collected while we couldn't hear the game, only those the server hasn't seen are sent.
+                        # Uid 0 isn't a location, older game versions set it for every hint art moon
+                        missing : list[int] = sorted(loc for loc in read_shine_bitmap(packet.packet)
+                                                     if 0 < loc < 1167 and loc not in ctx.checked_locations)
+                        if missing:
+                            print(f"Game holds {len(missing)} unsent shines")
+                            ctx.server_msgs.put({"cmd": "LocationChecks", "locations": missing})
+                            if any(ctx.player_data.check_goal(shine_id) for shine_id in missing):
+                                ctx.server_msgs.put({"cmd" : "StatusUpdate", "status" : ClientStatus.CLIENT_GOAL})
+                                print("Goal achieved")
 
+                    case PacketType.DeathLink:
+                        if ctx.death_link_enabled:
+                            await ctx.send_death()
 
-                    # for message in ctx.proxy_msgs:
-                    #     print(message.header.packet_type)
-                #await asyncio.sleep(0.25)
+                    case PacketType.Ping:
+                        # Answered right away instead of queued so the game measures the link, not the queue
+                        pong : Packet = Packet(guid=ctx.proxy_guid, packet_type=PacketType.Pong,
+                                               packet_data=[packet.packet.timestamp, packet.packet.sequence])
+                        writer.write(pong.serialize())
+
+                    case PacketType.Pong:
+                        ctx.update_rtt((time.monotonic_ns() - packet.packet.timestamp) / 1000000)
 
             if not ctx.game_connected and not ctx.awaiting_connection:
                 break
@@ -649,16 +644,27 @@ async def handle_proxy(reader : asyncio.StreamReader, writer : asyncio.StreamWri
         ctx.player_data.current_home_stage = ""
         ctx.awaiting_connection = True
         writer.close()
-
-
-async def comm_loop(ctx : SMOContext):
-    while not ctx.exit_event.is_set():
-        if not ctx.is_connected():
-            ctx.logged_in = False
-        if len(ctx.server_msgs) > 0 and ctx.logged_in:
-            await ctx.send_msgs(ctx.server_msgs)
-            ctx.server_msgs.clear()
-        await asyncio.sleep(0.1)
+    finally:
+        write_task.cancel()
+        ping_task.cancel()
+
+
+async def proxy_writer_loop(ctx : SMOContext, writer : asyncio.StreamWriter) -> None:
+    # Everything queued while the previous batch was draining goes out in one write
+    while True:
+        await ctx.proxy_msgs_event.wait()
+        ctx.proxy_msgs_event.clear()
+        if not ctx.game_connected:
+            continue
+        packets : list[Packet] = ctx.take_proxy_msgs()
+        if packets:
+            try:
+                writer.writelines([packet.serialize() for packet in packets])
+                await writer.drain()
+            except ConnectionError:
+                # Kept for the next connection, handle_proxy notices the dropped one on its side
+                ctx.proxy_msgs.extendleft(reversed(packets))
+                return
 
 
 def launch(*launch_args: str):
@@ -671,8 +677,8 @@ def launch(*launch_args: str):
 
         ctx.proxy = asyncio.start_server(functools.partial(handle_proxy, ctx=ctx), "0.0.0.0", 1027)
         ctx.proxy_chat = asyncio.create_task(proxy_chat(ctx) , name="ChatLoop")
-        ctx.ping_task = asyncio.create_task(ping_loop(ctx), name="PingLoop")
-        ctx.server_comm_task = asyncio.create_task(comm_loop(ctx), name="CommLoop")
+        ctx.server_comm_task = asyncio.create_task(ctx.server_msgs.run(ctx.send_msgs, ctx.can_send_server_msgs),
+                                                   name="ServerPump")
 
         if gui_enabled:
             ctx.run_gui()
@@ -680,20 +686,7 @@ def launch(*launch_args: str):
 
         await ctx.proxy
         await ctx.proxy_chat
-        await ctx.ping_task
         await ctx.server_comm_task
-        # Make ping task wait 1-second intervals
-        # Add counter member to ctx
-        # if packet of any kind is read from stream,
-        # reset counter to 5
-        # if counter is 0 when ping task runs,
-        # send ping packet to SMO reset counter, set awaiting_ping member of ctx true
-        # when ping packet received, set awaiting_ping to false
-        # if counter reaches 0 and awaiting_ping is true,
-        # set game_connected to false.
-        # test without ping packet to see if enough packets
-        # saturate the stream to keep connection open with Mario idle
-        # if not then implement the above.
 
         await ctx.exit_event.wait()
 
@@ -0,0 +1,41 @@
+import asyncio
+from typing import Any, Awaitable, Callable
+
+
+class MessagePump:
+    # Messages for the Archipelago server. The pump sends as soon as something is put, and everything put while a send
+    # was in flight goes out together in the next send_msgs call.
+    msgs : list[Any]
+    event : asyncio.Event
+
+    def __init__(self):
+        self.msgs = []
+        self.event = asyncio.Event()
+
+    def __len__(self) -> int:
+        return len(self.msgs)
+
+    def put(self, msg : Any) -> None:
+        self.msgs.append(msg)
+        self.event.set()
+
+    def wake(self) -> None:
+        """
+        Retries whatever is queued, for when is_ready may have changed
+        """
+        self.event.set()
+
+    async def run(self, send : Callable[[list[Any]], Awaitable[None]], is_ready : Callable[[], bool]) -> None:
+        """
+        Sends queued messages until cancelled
+        :param send: sends a list of messages, CommonContext.send_msgs
+        :param is_ready: whether messages can be sent right now, they stay queued until the next wake if not
+        """
+        while True:
+            await self.event.wait()
+            self.event.clear()
+            if not self.msgs or not is_ready():
+                continue
+            msgs : list[Any] = self.msgs
+            self.msgs = []
+            await send(msgs)
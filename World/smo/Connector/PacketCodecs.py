@@ -0,0 +1,72 @@
+# Generated by Mod/scripts/genPackets.py from Mod/scripts/packets.schema, edit that and run make packets instead.
+# Every codec packs straight into a preallocated buffer (pack_into) and unpacks from a memoryview (unpack_from).
+import struct
+
+HEADER_SIZE : int = 20
+
+# Packet, 20 bytes
+# guid@0  packet_type@16  packet_size@18
+HEADER : struct.Struct = struct.Struct("<16shh")
+
+# PlayerConnect, 67 bytes after the header
+# connection_type@0  max_players@4  client_name@6  table_hashes@38  session_id@66
+CONNECT : struct.Struct = struct.Struct("<iH32s7IB")
+
+# InitPacket, 3 bytes after the header
+# max_players@0  session_id@2
+INIT : struct.Struct = struct.Struct("<HB")
+
+# Check, 80 bytes after the header
+# location_id@0  item_type@4  index@8  obj_id@12  stage@28  amount@76
+CHECK : struct.Struct = struct.Struct("<iii16s48si")
+
+# ChangeStagePacket, 66 bytes after the header
+# stage@0  stage_id@48  scenario@64  sub_scenario_type@65
+CHANGE_STAGE : struct.Struct = struct.Struct("<48s16sbB")
+
+# ArchipelagoChatMessage, 225 bytes after the header
+# message1@0  message2@75  message3@150
+CHAT_MESSAGE : struct.Struct = struct.Struct("<75s75s75s")
+
+# SlotData, 28 bytes after the header
+# cascade@0  sand@2  wooded@4  lake@6  lost@8  metro@10  seaside@12  snow@14  luncheon@16  ruined@18  bowser@20  dark@22  darker@24  regionals@26  captures@27
+SLOT_DATA : struct.Struct = struct.Struct("<HHHHHHHHHHHHH??")
+
+# ApInfo, 128 bytes after the header
+# info_type@0  index1@2  index2@4  index3@6  info1@8  info2@48  info3@88
+AP_INFO : struct.Struct = struct.Struct("<hhhh40s40s40s")
+
+# ShopReplacePacket, 177 bytes after the header
+# info_type@0  entries@1
+SHOP_REPLACE : struct.Struct = struct.Struct("<B176B")
+
+# Deathlink, PlayerDC, 0 bytes after the header
+EMPTY : struct.Struct = struct.Struct("<")
+
+# PingPacket, 12 bytes after the header
+# timestamp@0  sequence@8
+PING : struct.Struct = struct.Struct("<QI")
+
+# ShineChecks, ShineColor, ShineReplacePacket, 2 bytes after the header
+# count@0, then entries
+ARRAY_HEADER : struct.Struct = struct.Struct("<H")
+
+# ShineColorEntry, 3 bytes
+# shine_uid@0  color@2
+SHINE_COLOR_ENTRY : struct.Struct = struct.Struct("<hb")
+
+# ShineReplaceEntry, 2 bytes
+# item_type@0  item_name_index@1
+SHINE_REPLACE_ENTRY : struct.Struct = struct.Struct("<bB")
+
+# SlotBundle, 4 bytes after the header
+# version@0  encoding@1  raw_size@2, then data
+SLOT_BUNDLE : struct.Struct = struct.Struct("<BBH")
+
+# ShineBitmap, 2 bytes after the header
+# encoding@0  word_count@1, then data
+SHINE_BITMAP : struct.Struct = struct.Struct("<BB")
+
+# FragmentPacket, 8 bytes after the header
+# message_id@0  fragment_index@2  total_length@4, then data
+FRAGMENT : struct.Struct = struct.Struct("<HHI")
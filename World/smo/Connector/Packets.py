@@ -1,8 +1,18 @@
+import asyncio
+import struct
+import sys
+from array import array
 from enum import Enum
-from ctypes import c_short as short, c_ushort as ushort, c_byte as sbyte, c_ubyte as byte, c_byte, c_ubyte
+from ctypes import c_short as short
 from math import trunc
 from typing import Any
 
+from .PacketCodecs import HEADER, CONNECT, INIT, CHECK, CHANGE_STAGE, CHAT_MESSAGE, SLOT_DATA, AP_INFO, SHOP_REPLACE, \
+    PING, ARRAY_HEADER, SHINE_COLOR_ENTRY, SHINE_REPLACE_ENTRY, SLOT_BUNDLE, SHINE_BITMAP, FRAGMENT, EMPTY
+
+# Session id 0 is never assigned, see CompactPacket in Mod/include/packets/Packet.h
+NO_SESSION : int = 0
+
 class PacketType(Enum):
     Unknown : short = 0
     Init : short = 1
@@ -25,8 +35,15 @@ class PacketType(Enum):
     ShopReplace : short = 19
     ShineReplace : short = 20
     ShineColor : short = 21
-    #UDPInit : short = 26
-    #HolePunch : short = 27
+    #UDPInit : short = 22
+    #HolePunch : short = 23
+    Ping : short = 24
+    Pong : short = 25
+    PlayerInfoKeyframe : short = 26
+    PlayerInfoDelta : short = 27
+    Fragment : short = 28
+    SlotBundle : short = 29
+    ShineBitmap : short = 30
 
 class ConnectionType(Enum):
     Connect = 0
@@ -43,9 +60,31 @@ class ItemType(Enum):
     Capture = 5
 
 
+def encode_string(text : str, size : int) -> bytes:
+    # Cut to size without leaving half a character behind, the codec zero pads whatever is left
+    raw : bytes = text.encode()
+    if len(raw) > size:
+        raw = raw[:size].decode(errors="ignore").encode()
+    return raw
+
+def decode_string(raw : bytes) -> str:
+    return raw.split(b"\0", 1)[0].decode(errors="replace")
+
+class PacketBody:
+    # Bodies pack straight into the buffer Packet.serialize allocated for the whole packet
+    SIZE : int = 0
+
+    def pack_into(self, buffer : bytearray, offset : int) -> None:
+        pass
+
+    def serialize(self) -> bytearray:
+        data : bytearray = bytearray(self.SIZE)
+        self.pack_into(data, 0)
+        return data
+
 #region Check Packets
 
-class CheckPacket:
+class CheckPacket(PacketBody):
     OBJ_ID_SIZE = 0x10
     STAGE_NAME_SIZE = 0x30
     location_id : int
@@ -59,7 +98,7 @@ class CheckPacket:
     stage : str
     # Coins
     amount : int
-    SIZE : short = 16 + 0x10 + 0x30
+    SIZE : short = CHECK.size
 
     def __init__(self, packet_bytes : bytearray = None, location_id : int = None, item_type : int = None, index : int = None, obj_id : str = None, stage : str = None, amount : int = None):
         if packet_bytes:
@@ -72,78 +111,71 @@ class CheckPacket:
             self.stage = stage
             self.amount = amount
 
-    def serialize(self) -> bytearray:
-        data : bytearray = bytearray()
-        data += self.location_id.to_bytes(4, "little", signed=True)
-        data += self.item_type.value.to_bytes(4, "little", signed=True)
-        data += self.index.to_bytes(4, "little", signed=True)
-        data += self.obj_id.encode()
-        while len(data) < 12 + self.OBJ_ID_SIZE:
-            data += b"\x00"
-        data += self.stage.encode()
-        while len(data) < 12 + self.OBJ_ID_SIZE + self.STAGE_NAME_SIZE:
-            data += b"\x00"
-        data += self.amount.to_bytes(4, "little", signed=True)
-        if len(data) != self.SIZE:
-            raise f"CheckPacket failed to serialize. bytearray is incorrect size {self.SIZE}."
-        return data
+    def pack_into(self, buffer : bytearray, offset : int) -> None:
+        CHECK.pack_into(buffer, offset, self.location_id, self.item_type.value, self.index,
+                        encode_string(self.obj_id, self.OBJ_ID_SIZE), encode_string(self.stage, self.STAGE_NAME_SIZE),
+                        self.amount)
 
-    def deserialize(self, data : bytes | bytearray) -> None:
-        if data is bytes:
-            data = bytearray(data)
-        offset = 0
-        self.location_id  = int.from_bytes(data[offset:offset + 4], "little")
-        offset += 4
-        self.item_type  = ItemType(int.from_bytes(data[offset:offset + 4], "little",signed=True))
-        offset += 4
-        self.index  = int.from_bytes(data[offset:offset + 4], "little",signed=True)
-        offset += 4
-        self.obj_id = data[offset:offset + self.OBJ_ID_SIZE].decode()
-        offset += self.OBJ_ID_SIZE
-        self.stage = data[offset:offset + self.STAGE_NAME_SIZE].decode()
-        offset += self.STAGE_NAME_SIZE
-        self.amount  = int.from_bytes(data[offset:offset + 4], "little")
-        offset += 4
-
-
-class ShineChecksPacket:
-    checks : list[int]
-    SIZE : short = 200
+    def deserialize(self, data : bytes | bytearray | memoryview) -> None:
+        self.location_id, item_type, self.index, obj_id, stage, self.amount = CHECK.unpack_from(data)
+        self.item_type = ItemType(item_type)
+        self.obj_id = decode_string(obj_id)
+        self.stage = decode_string(stage)
 
-    def __init__(self, packet_bytes : bytearray = None, checks : list[int] = None):
+
+class ArrayPacket(PacketBody):
+    # A u16 count followed by that many packed entries, so only the entries actually held go on the wire.
+    ENTRY : struct.Struct
+    entries : list[tuple]
+
+    def __init__(self, packet_bytes : bytearray = None, entries : list[tuple] = None):
         if packet_bytes:
             self.deserialize(packet_bytes)
         else:
-            self.checks = checks
-
-    def serialize(self) -> bytearray:
-        data : bytearray = bytearray()
-        for i in range(100):
-            if i < len(self.checks):
-                data += self.checks[i].to_bytes(length=2, byteorder="little", signed=True)
-
-            else:
-                filler = 0
-                data += filler.to_bytes(length=2, byteorder="little", signed=True)
+            self.entries = entries
+        self.SIZE = ARRAY_HEADER.size + len(self.entries) * self.ENTRY.size
+
+    def pack_into(self, buffer : bytearray, offset : int) -> None:
+        ARRAY_HEADER.pack_into(buffer, offset, len(self.entries))
+        offset += ARRAY_HEADER.size
+        for entry in self.entries:
+            self.ENTRY.pack_into(buffer, offset, *entry)
+            offset += self.ENTRY.size
+
+    def deserialize(self, data : bytes | bytearray | memoryview) -> None:
+        count : int = ARRAY_HEADER.unpack_from(data)[0]
+        # Same clamp as the game, a count larger than the data only reads the entries present
+        count = min(count, (len(data) - ARRAY_HEADER.size) // self.ENTRY.size)
+        view = memoryview(data)[ARRAY_HEADER.size:ARRAY_HEADER.size + count * self.ENTRY.size]
+        self.entries = list(self.ENTRY.iter_unpack(view))
+
+class ShineChecksPacket(ArrayPacket):
+    ENTRY : struct.Struct = struct.Struct("<h")
 
+    def __init__(self, packet_bytes : bytearray = None, checks : list[int] = None):
+        super().__init__(packet_bytes=packet_bytes, entries=None if checks is None else [(uid,) for uid in checks])
 
-        if len(data) != self.SIZE:
-            raise f"ShineChecksPacket failed to serialize. bytearray is incorrect size {self.SIZE}."
-        return data
+    @property
+    def checks(self) -> list[int]:
+        return [uid for uid, in self.entries]
 
-    def deserialize(self, data : bytes | bytearray) -> None:
-        if data is bytes:
-            data = bytearray(data)
-        # Shouldn't be necessary
+    def pack_into(self, buffer : bytearray, offset : int) -> None:
+        # One flat array of uids, copied in a single slice rather than packed per entry
+        uids = array("h", self.checks)
+        if sys.byteorder != "little":
+            uids.byteswap()
+        ARRAY_HEADER.pack_into(buffer, offset, len(uids))
+        offset += ARRAY_HEADER.size
+        buffer[offset:offset + len(uids) * uids.itemsize] = uids.tobytes()
 
 #endregion
 
 #region Server Packets
 
-class ChatMessagePacket:
+class ChatMessagePacket(PacketBody):
     MESSAGE_SIZE : int = 0x4B
     messages : list[str]
-    SIZE : short = 0x4B * 3
+    SIZE : short = CHAT_MESSAGE.size
 
     def __init__(self, packet_bytes : bytearray = None, messages : list[str] = None):
         if packet_bytes:
@@ -151,155 +183,72 @@ class ChatMessagePacket:
         else:
             self.messages = messages
 
-    def serialize(self) -> bytearray:
-        data : bytearray = bytearray()
-        size : int = 0
-        for index in range(len(self.messages)):
-            for char in self.messages[index]:
-                if size < self.MESSAGE_SIZE:
-                    data += char.encode()
-                else:
-                    raise "Message too long exception"
-
-            while len(data) < self.MESSAGE_SIZE * (index + 1):
-                data += b"\x00"
-        if len(data) != self.SIZE:
-            raise f"ChatMessagePacket failed to serialize. bytearray is incorrect size {self.SIZE}."
-        return data
-
-
-    def deserialize(self, data : bytes | bytearray) -> None:
-        if data is bytes:
-            data = bytearray(data)
-
-        offset = 0
-        self.messages.append(data[offset:offset + self.MESSAGE_SIZE].decode("utf8"))
-        offset += self.MESSAGE_SIZE
-        self.messages.append(data[offset:offset + self.MESSAGE_SIZE].decode("utf8"))
-        offset += self.MESSAGE_SIZE
-        self.messages.append(data[offset:offset + self.MESSAGE_SIZE].decode("utf8"))
-
-
-class SlotDataPacket:
-    cascade : ushort
-    sand : ushort
-    wooded : ushort
-    lake : ushort
-    lost : ushort
-    metro : ushort
-    seaside : ushort
-    snow : ushort
-    luncheon : ushort
-    ruined : ushort
-    bowser : ushort
-    dark : ushort
-    darker : ushort
+    def pack_into(self, buffer : bytearray, offset : int) -> None:
+        messages : list[bytes] = [encode_string(message, self.MESSAGE_SIZE) for message in self.messages[:3]]
+        messages += [b""] * (3 - len(messages))
+        CHAT_MESSAGE.pack_into(buffer, offset, *messages)
+
+    def deserialize(self, data : bytes | bytearray | memoryview) -> None:
+        self.messages = [decode_string(message) for message in CHAT_MESSAGE.unpack_from(data)]
+
+
+class SlotDataPacket(PacketBody):
+    cascade : int
+    sand : int
+    wooded : int
+    lake : int
+    lost : int
+    metro : int
+    seaside : int
+    snow : int
+    luncheon : int
+    ruined : int
+    bowser : int
+    dark : int
+    darker : int
     regionals : bool
     captures : bool
-    SIZE : short = 28
+    SIZE : short = SLOT_DATA.size
 
     def __init__(self, packet_bytes : bytearray = None, cascade : int = None, sand : int = None, wooded : int = None, lake : int = None, lost : int = None, metro : int = None, seaside : int = None, snow : int = None, luncheon : int = None, ruined : int = None, bowser : int = None, dark : int = None, darker : int = None,  regionals : bool = None, captures : bool = None):
         if packet_bytes:
             self.deserialize(packet_bytes)
         else:
-            self.cascade = short(cascade)
-            self.sand = short(sand)
-            self.wooded = short(wooded)
-            self.lake = short(lake)
-            self.lost = short(lost)
-            self.metro = short(metro)
-            self.seaside = short(seaside)
-            self.snow = short(snow)
-            self.luncheon = short(luncheon)
-            self.ruined = short(ruined)
-            self.bowser = short(bowser)
-            self.dark = short(dark)
-            self.darker = short(darker)
+            self.cascade = cascade
+            self.sand = sand
+            self.wooded = wooded
+            self.lake = lake
+            self.lost = lost
+            self.metro = metro
+            self.seaside = seaside
+            self.snow = snow
+            self.luncheon = luncheon
+            self.ruined = ruined
+            self.bowser = bowser
+            self.dark = dark
+            self.darker = darker
             self.regionals = regionals
             self.captures = captures
 
-    def serialize(self) -> bytearray:
-        data : bytearray = bytearray()
-        int_value : int = self.cascade.value
-        data += int_value.to_bytes(2, "little")
-        int_value = self.sand.value
-        data += int_value.to_bytes(2, "little")
-        int_value = self.wooded.value
-        data += int_value.to_bytes(2, "little")
-        int_value = self.lake.value
-        data += int_value.to_bytes(2, "little")
-        int_value = self.lost.value
-        data += int_value.to_bytes(2, "little")
-        int_value = self.metro.value
-        data += int_value.to_bytes(2, "little")
-        int_value = self.seaside.value
-        data += int_value.to_bytes(2, "little")
-        int_value = self.snow.value
-        data += int_value.to_bytes(2, "little")
-        int_value = self.luncheon.value
-        data += int_value.to_bytes(2, "little")
-        int_value = self.ruined.value
-        data += int_value.to_bytes(2, "little")
-        int_value = self.bowser.value
-        data += int_value.to_bytes(2, "little")
-        int_value = self.dark.value
-        data += int_value.to_bytes(2, "little")
-        int_value = self.darker.value
-        data += int_value.to_bytes(2, "little")
-        data += self.regionals.to_bytes(1, "little")
-        data += self.captures.to_bytes(1, "little")
-        if len(data) != self.SIZE:
-            raise f"CountsPacket failed to serialize. bytearray is incorrect size {self.SIZE}."
-        return data
-
-    def deserialize(self, data : bytes | bytearray) -> None:
-        if data is bytes:
-            data = bytearray(data)
-        offset = 0
-        self.cascade = ushort(int.from_bytes(data[offset:2], "little"))
-        offset += 2
-        self.sand = ushort(int.from_bytes(data[offset:offset + 2], "little"))
-        offset += 2
-        self.wooded = ushort(int.from_bytes(data[offset:offset + 2], "little"))
-        offset += 2
-        self.lake = ushort(int.from_bytes(data[offset:offset + 2], "little"))
-        offset += 2
-        self.lost = ushort(int.from_bytes(data[offset:offset + 2], "little"))
-        offset += 2
-        self.metro = ushort(int.from_bytes(data[offset:offset + 2], "little"))
-        offset += 2
-        self.seaside = ushort(int.from_bytes(data[offset:offset + 2], "little"))
-        offset += 2
-        self.snow = ushort(int.from_bytes(data[offset:offset + 2], "little"))
-        offset += 2
-        self.luncheon = ushort(int.from_bytes(data[offset:offset + 2], "little"))
-        offset += 2
-        self.ruined = ushort(int.from_bytes(data[offset:offset + 2], "little"))
-        offset += 2
-        self.bowser = ushort(int.from_bytes(data[offset:offset + 2], "little"))
-        offset += 2
-        self.dark = ushort(int.from_bytes(data[offset:offset + 2], "little"))
-        offset += 2
-        self.darker = ushort(int.from_bytes(data[offset:offset + 2], "little"))
-        offset += 2
-        self.regionals = bool.from_bytes(data[offset:offset + 1], "little")
-        offset += 1
-        self.captures = bool.from_bytes(data[offset:offset + 1], "little")
-
-
-
+    def pack_into(self, buffer : bytearray, offset : int) -> None:
+        SLOT_DATA.pack_into(buffer, offset, self.cascade, self.sand, self.wooded, self.lake, self.lost, self.metro,
+                            self.seaside, self.snow, self.luncheon, self.ruined, self.bowser, self.dark, self.darker,
+                            self.regionals, self.captures)
 
+    def deserialize(self, data : bytes | bytearray | memoryview) -> None:
+        (self.cascade, self.sand, self.wooded, self.lake, self.lost, self.metro, self.seaside, self.snow, self.luncheon,
+         self.ruined, self.bowser, self.dark, self.darker, self.regionals, self.captures) = SLOT_DATA.unpack_from(data)
 
 #endregion
 
-class ChangeStagePacket:
+class ChangeStagePacket(PacketBody):
     ID_SIZE : int  = 0x10
     STAGE_SIZE : int = 0x30
     stage : str
     stage_id : str
-    scenario : sbyte
-    sub_scenario_type : byte
-    SIZE : short = 0x42
+    scenario : int
+    sub_scenario_type : int
+    SIZE : short = CHANGE_STAGE.size
 
     def __init__(self, packet_bytes = None , stage : str = "", stage_id : str = "", scenario : int = -1, sub_scenario_type : int = 0):
         if packet_bytes:
@@ -307,38 +256,19 @@ class ChangeStagePacket:
         else:
             self.stage = stage
             self.stage_id = stage_id
-            self.scenario = c_byte(int(scenario))
-            self.sub_scenario_type = c_ubyte(sub_scenario_type)
+            self.scenario = int(scenario)
+            self.sub_scenario_type = sub_scenario_type
 
-    def serialize(self) -> bytearray:
-        data : bytearray = bytearray()
-        data += self.stage.encode()
-        while len(data) < self.STAGE_SIZE:
-            data += b"\x00"
-        data += self.stage_id.encode()
-        while len(data) < self.STAGE_SIZE + self.ID_SIZE:
-            data += b"\x00"
-        int_value : int = self.scenario.value
-        data += int_value.to_bytes(1, "little", signed=True)
-        int_value2 : int = self.sub_scenario_type.value
-        data += int_value2.to_bytes(1, "little", signed=False)
-        if len(data) != self.SIZE:
-            raise f"ChangeStagePacket failed to serialize. bytearray is incorrect size {self.SIZE}."
-        return data
+    def pack_into(self, buffer : bytearray, offset : int) -> None:
+        CHANGE_STAGE.pack_into(buffer, offset, encode_string(self.stage, self.STAGE_SIZE),
+                               encode_string(self.stage_id, self.ID_SIZE), self.scenario, self.sub_scenario_type)
 
-    def deserialize(self, data : bytes | bytearray) -> None:
-        if data is bytes:
-            data = bytearray(data)
-        offset : int = 0
-        self.stage = data[offset:self.STAGE_SIZE].decode()
-        offset += self.STAGE_SIZE
-        self.stage_id = data[offset:offset + self.ID_SIZE].decode()
-        offset += self.ID_SIZE
-        self.scenario = sbyte(int.from_bytes(data[offset:offset + 1], "little"))
-        offset += 1
-        self.sub_scenario_type = byte(int.from_bytes(data[offset:offset + 1], "little"))
-
-class ApInfoPacket:
+    def deserialize(self, data : bytes | bytearray | memoryview) -> None:
+        stage, stage_id, self.scenario, self.sub_scenario_type = CHANGE_STAGE.unpack_from(data)
+        self.stage = decode_string(stage)
+        self.stage_id = decode_string(stage_id)
+
+class ApInfoPacket(PacketBody):
     INFO_SIZE : int = 40
     info_type : int = -1
     index1 : int = -1
@@ -346,7 +276,7 @@ class ApInfoPacket:
     index3 : int = -1
     info : list[str] = []
 
-    SIZE : short = 128
+    SIZE : short = AP_INFO.size
 
     def __init__(self, info_type: int, index1 : int, index2 : int, index3 : int, info : list[str]):
         self.info_type = info_type
@@ -355,226 +285,282 @@ class ApInfoPacket:
         self.index3 = index3
         self.info = info
 
-    def serialize(self) -> bytearray:
-        data : bytearray = bytearray()
-        data += self.info_type.to_bytes(2,"little")
-        data += self.index1.to_bytes(2,"little")
-        data += self.index2.to_bytes(2,"little")
-        data += self.index3.to_bytes(2,"little")
-        # print(self.info_type)
-        # print(self.index1)
-        # print(self.index2)
-        # print(self.index3)
-        # print(self.info)
-
-        for i in range(3):
-            if i < len(self.info):
-                if len(self.info[i]) > 40:
-                    data += self.info[i][:40].encode()
-                else:
-                    data += self.info[i].encode()
-
-            while len(data) < 8 + self.INFO_SIZE * (i + 1):
-                data += b"\x00"
-
-        if len(data) != self.SIZE:
-            raise f"ApInfoPacket failed to serialize. bytearray is incorrect size {self.SIZE}."
-        return data
+    def pack_into(self, buffer : bytearray, offset : int) -> None:
+        info : list[bytes] = [encode_string(text, self.INFO_SIZE) for text in self.info[:3]]
+        info += [b""] * (3 - len(info))
+        AP_INFO.pack_into(buffer, offset, self.info_type, self.index1, self.index2, self.index3, *info)
 
-    def deserialize(self, data : bytes | bytearray) -> None:
-        if data is bytes:
-            data = bytearray(data)
-        offset : int = 0
-        self.info_type = int.from_bytes(data[offset:2], "little")
-        offset += 2
-        self.index1 = int.from_bytes(data[offset:2], "little")
-        offset += 2
-        self.index2 = int.from_bytes(data[offset:2], "little")
-        offset += 2
-        self.index3 = int.from_bytes(data[offset:2], "little")
-        offset += 2
-        self.info.append(data[offset:offset + self.INFO_SIZE].decode("utf-16"))
-        offset += self.INFO_SIZE
-        self.info.append(data[offset:offset + self.INFO_SIZE].decode("utf-16"))
-        offset += self.INFO_SIZE
-        self.info.append(data[offset:offset + self.INFO_SIZE].decode("utf-16"))
-
-class ShopReplace:
+    def deserialize(self, data : bytes | bytearray | memoryview) -> None:
+        self.info_type, self.index1, self.index2, self.index3, *info = AP_INFO.unpack_from(data)
+        self.info = [decode_string(text) for text in info]
+
+class ShopReplace(PacketBody):
+    ENTRY_COUNT : int = 44
     info_type : int = 255
     info : list[list[int]] = []
 
-    SIZE : short = 177
+    SIZE : short = SHOP_REPLACE.size
 
     def __init__(self, info_type: int, info : list[list[int]]):
         self.info_type = info_type
         self.info = info
 
-    def serialize(self) -> bytearray:
-        data : bytearray = bytearray()
-        data += self.info_type.to_bytes(1,"little", signed=False)
-
-        for i in range(44):
-            if i < len(self.info):
-                for value in self.info[i]:
-                    data += value.to_bytes(1,"little", signed=False)
-
-            else:
-                filler = 255
-                data += filler.to_bytes(1,"little", signed=False)
-                data += filler.to_bytes(1,"little", signed=False)
-                data += filler.to_bytes(1,"little", signed=False)
-                data += filler.to_bytes(1,"little", signed=False)
-
-        if len(data) != self.SIZE:
-            raise f"ShopReplace failed to serialize. bytearray is incorrect size {self.SIZE}."
-        return data
-
-    def deserialize(self, data : bytes | bytearray) -> None:
-        if data is bytes:
-            data = bytearray(data)
-        offset : int = 0
-        self.info_type = data[offset]
-        offset += 1
-        for i in range(11):
-            self.info.append([data[offset], data[offset+1], data[offset+2], data[offset+3]])
-            offset += 4
-
-class ShineReplace:
-    info : dict[str | list[int]] = []
-
-    SIZE : short = 200
-
-    def __init__(self, info : dict[str | list[int]]):
-        self.info = info
-
-    def serialize(self) -> bytearray:
-        data : bytearray = bytearray()
+    def pack_into(self, buffer : bytearray, offset : int) -> None:
+        values : list[int] = [value for entry in self.info[:self.ENTRY_COUNT] for value in entry]
+        values += [255] * (self.ENTRY_COUNT * 4 - len(values))
+        SHOP_REPLACE.pack_into(buffer, offset, self.info_type, *values)
 
-        for i in range(100):
-            if i < len(self.info):
-                data += self.info[str(i)][0].to_bytes(1,"little", signed=True)
-                data += self.info[str(i)][1].to_bytes(1,"little", signed=False)
+    def deserialize(self, data : bytes | bytearray | memoryview) -> None:
+        self.info_type, *values = SHOP_REPLACE.unpack_from(data)
+        self.info = [values[i:i + 4] for i in range(0, len(values), 4)]
 
-            else:
-                filler = 127
-                data += filler.to_bytes(1,"little", signed=True)
-                filler = 255
-                data += filler.to_bytes(1,"little", signed=False)
+class ShineReplace(ArrayPacket):
+    # Entry i replaces the text of shine i in the current kingdom
+    ENTRY : struct.Struct = SHINE_REPLACE_ENTRY
 
-        if len(data) != self.SIZE:
-            raise f"ShineReplace failed to serialize. bytearray is incorrect size {self.SIZE}."
-        return data
+    def __init__(self, packet_bytes : bytearray = None, info : dict[str | list[int]] = None):
+        super().__init__(packet_bytes=packet_bytes,
+            entries=None if info is None else [tuple(info[str(i)]) for i in range(len(info))])
 
-    def deserialize(self, data : bytes | bytearray) -> None:
-        if data is bytes:
-            data = bytearray(data)
-        offset : int = 0
-        for i in range(100):
-            self.info[str(i)] = [data[offset], data[offset+1]]
-            offset += 2
+    @property
+    def info(self) -> dict[str | list[int]]:
+        return {str(i) : list(entry) for i, entry in enumerate(self.entries)}
 
-class ShineColor:
-    info : list[list[int]] = []
+class ShineColor(ArrayPacket):
+    ENTRY : struct.Struct = SHINE_COLOR_ENTRY
 
-    SIZE : short = 51*3
+    def __init__(self, packet_bytes : bytearray = None, info : list[list[int]] = None):
+        super().__init__(packet_bytes=packet_bytes, entries=None if info is None else [tuple(entry) for entry in info])
 
-    def __init__(self, info : list[list[int]]):
-        self.info = info
+    @property
+    def info(self) -> list[list[int]]:
+        return [list(entry) for entry in self.entries]
 
-    def serialize(self) -> bytearray:
-        data : bytearray = bytearray()
+class DeathLinkPacket(PacketBody):
+    SIZE : short = EMPTY.size
 
-        for i in range(51):
-            if i < len(self.info):
-                data += self.info[i][0].to_bytes(2,"little")
-                data += self.info[i][1].to_bytes(1,"little", signed=True)
+    def deserialize(self, data : bytes | bytearray | memoryview) -> None:
+        pass
 
-            else:
-                filler = 0
-                data += filler.to_bytes(2,"little")
-                data += filler.to_bytes(1,"little", signed=True)
+#region Connection Packets
 
-        if len(data) != self.SIZE:
-            print(len(data))
-            raise f"ShineColor failed to serialize. bytearray is incorrect size {self.SIZE}."
-        return data
+class PingPacket(PacketBody):
+    # Used for both Ping and Pong, a Pong echoes the Ping it answers untouched.
+    SIZE : short = PING.size
+    # Sender's clock, only ever compared by the side that sent the Ping
+    timestamp : int
+    sequence : int
 
-    def deserialize(self, data : bytes | bytearray) -> None:
-        if data is bytes:
-            data = bytearray(data)
-        offset : int = 0
-        self.info = []
-        print(int.from_bytes(data[offset:offset+2], "little"))
-        print(int.from_bytes(data[offset:offset+2], "little", signed=True))
-        for i in range(83):
-            self.info.append([int.from_bytes(data[offset:offset+2],"little", signed=True), data[offset+3]])
-            offset += 3
-
-class DeathLinkPacket:
-    SIZE : short = 0x0
+    def __init__(self, packet_bytes : bytearray = None, timestamp : int = 0, sequence : int = 0):
+        if packet_bytes:
+            self.deserialize(packet_bytes)
+        else:
+            self.timestamp = timestamp
+            self.sequence = sequence
 
-    def serialize(self) -> bytearray:
-        data : bytearray = bytearray()
-        return data
+    def pack_into(self, buffer : bytearray, offset : int) -> None:
+        PING.pack_into(buffer, offset, self.timestamp, self.sequence)
 
-    def deserialize(self, data : bytes | bytearray) -> None:
-        if data is bytes:
-            data = bytearray(data)
+    def deserialize(self, data : bytes | bytearray | memoryview) -> None:
+        self.timestamp, self.sequence = PING.unpack_from(data)
 
-#region Connection Packets
-
-class ConnectPacket:
-    SIZE : short = 4
+class ConnectPacket(PacketBody):
+    SIZE : short = CONNECT.size
+    CLIENT_NAME_SIZE : int = 0x20
+    TABLE_HASH_COUNT : int = 7
     connection_type : ConnectionType
+    max_players : int
+    client_name : str
+    # Hash of every slot table the game already holds, indexed by SlotBundle table id, 0 if it never got one
+    table_hashes : list[int]
+    # Session id of the player being announced, the game only reads it on the ones a server sends it
+    session_id : int
 
     def __init__(self, packet_bytes : bytearray = None , connection_type : ConnectionType = ConnectionType.Connect):
         if packet_bytes:
             self.deserialize(packet_bytes)
         else:
             self.connection_type = connection_type
-
-    def serialize(self) -> bytearray:
-        data : bytearray = bytearray()
-        value = self.connection_type.value
-        data += value.to_bytes(4,"little")
-        return data
-
-    def deserialize(self, data : bytes | bytearray) -> None:
-        if data is bytes:
-            data = bytearray(data)
-
-        self.connection_type = ConnectionType(int.from_bytes(data[0:4],"little"))
-
-class DisconnectPacket:
+            self.max_players = 0xFFFF
+            self.client_name = ""
+            self.table_hashes = []
+            self.session_id = NO_SESSION
+
+    def pack_into(self, buffer : bytearray, offset : int) -> None:
+        hashes : list[int] = (self.table_hashes + [0] * self.TABLE_HASH_COUNT)[:self.TABLE_HASH_COUNT]
+        CONNECT.pack_into(buffer, offset, self.connection_type.value, self.max_players,
+                          encode_string(self.client_name, self.CLIENT_NAME_SIZE), *hashes, self.session_id)
+
+    def deserialize(self, data : bytes | bytearray | memoryview) -> None:
+        if len(data) < CONNECT.size:
+            # Versions of the game from before slot table hashes, everything they hold counts as stale
+            data = bytes(data).ljust(CONNECT.size, b"\0")
+        connection_type, self.max_players, client_name, *self.table_hashes, self.session_id = CONNECT.unpack_from(data)
+        self.connection_type = ConnectionType(connection_type)
+        self.client_name = decode_string(client_name)
+
+class DisconnectPacket(PacketBody):
     # Empty Packet just to signal disconnect
-    SIZE : short = 0
-
-class InitPacket:
-    max_players : ushort = ushort(4)
-    SIZE : short = 2
-
-    def serialize(self) -> bytearray:
-        data : bytearray = bytearray()
-        as_integer : int = self.max_players.value
-        data += as_integer.to_bytes(2, "little")
-        if len(data) != self.SIZE:
-            raise f"InitPacket failed to serialize. bytearray is incorrect size {self.SIZE}."
+    SIZE : short = EMPTY.size
+
+class InitPacket(PacketBody):
+    max_players : int = 4
+    # The connector has no udp socket, so it never hands out a session id and the game keeps the full header
+    session_id : int = NO_SESSION
+    SIZE : short = INIT.size
+
+    def pack_into(self, buffer : bytearray, offset : int) -> None:
+        INIT.pack_into(buffer, offset, self.max_players, self.session_id)
+
+    def deserialize(self, data : bytes | bytearray | memoryview) -> None:
+        self.max_players, self.session_id = INIT.unpack_from(data)
+
+class SlotBundlePacket(PacketBody):
+    # Every slot data table sent on connect in one packet, too large to go out without fragments.
+    ENCODING_RAW : int = 0
+    ENCODING_RLE : int = 1
+    HEADER_SIZE : int = SLOT_BUNDLE.size
+    version : int
+    encoding : int
+    # Size of data once decoded
+    raw_size : int
+    data : bytes
+
+    def __init__(self, version : int, encoding : int, raw_size : int, data : bytes):
+        self.version = version
+        self.encoding = encoding
+        self.raw_size = raw_size
+        self.data = data
+        self.SIZE = self.HEADER_SIZE + len(self.data)
+
+    def pack_into(self, buffer : bytearray, offset : int) -> None:
+        SLOT_BUNDLE.pack_into(buffer, offset, self.version, self.encoding, self.raw_size)
+        buffer[offset + self.HEADER_SIZE:offset + self.SIZE] = self.data
+
+class ShineBitmapPacket(PacketBody):
+    # Every collected shine as one bitmap, bit uid % 32 of little endian word uid / 32, which is simply bit uid
+    # of the whole bitmap read as one little endian integer. SlotBundle.py builds and reads them.
+    WORD_COUNT : int = 37
+    RAW_SIZE : int = WORD_COUNT * 4
+    HEADER_SIZE : int = SHINE_BITMAP.size
+    encoding : int
+    word_count : int
+    data : bytes
+
+    def __init__(self, packet_bytes : bytearray = None, encoding : int = 0, data : bytes = b""):
+        if packet_bytes:
+            self.deserialize(packet_bytes)
+        else:
+            self.encoding = encoding
+            self.word_count = self.WORD_COUNT
+            self.data = data
+        self.SIZE = self.HEADER_SIZE + len(self.data)
+
+    def pack_into(self, buffer : bytearray, offset : int) -> None:
+        SHINE_BITMAP.pack_into(buffer, offset, self.encoding, self.word_count)
+        buffer[offset + self.HEADER_SIZE:offset + self.SIZE] = self.data
+
+    def deserialize(self, data : bytes | bytearray | memoryview) -> None:
+        self.encoding, self.word_count = SHINE_BITMAP.unpack_from(data)
+        self.data = bytes(data[self.HEADER_SIZE:])
+
+class FragmentPacket(PacketBody):
+    # One slice of a packet too large for MAX_PACKET_SIZE, every slice with the same message_id is stitched
+    # back into the original packet (header included) once total_length bytes have arrived.
+    MAX_PACKET_SIZE : int = 0x100
+    # Largest packet that can be sent as fragments, header included
+    MAX_MESSAGE_SIZE : int = 0x4000
+    HEADER_SIZE : int = FRAGMENT.size
+    DATA_SIZE : int = MAX_PACKET_SIZE - HEADER.size - HEADER_SIZE
+    next_message_id : int = 0
+    message_id : int
+    fragment_index : int
+    total_length : int
+    data : bytes
+
+    def __init__(self, packet_bytes : bytearray = None, message_id : int = 0, fragment_index : int = 0, total_length : int = 0, data : bytes = b""):
+        if packet_bytes:
+            self.deserialize(packet_bytes)
+        else:
+            self.message_id = message_id
+            self.fragment_index = fragment_index
+            self.total_length = total_length
+            self.data = data
+        self.SIZE = self.HEADER_SIZE + len(self.data)
+
+    def pack_into(self, buffer : bytearray, offset : int) -> None:
+        FRAGMENT.pack_into(buffer, offset, self.message_id, self.fragment_index, self.total_length)
+        buffer[offset + self.HEADER_SIZE:offset + self.SIZE] = self.data
+
+    def deserialize(self, data : bytes | bytearray | memoryview) -> None:
+        self.message_id, self.fragment_index, self.total_length = FRAGMENT.unpack_from(data)
+        self.data = bytes(data[self.HEADER_SIZE:])
+
+    @classmethod
+    def split(cls, guid : bytearray, message : bytes | bytearray) -> bytearray:
+        """
+        Splits a serialized packet into back to back Fragment packets
+        :return: the fragments, ready to be written in one go
+        """
+        if len(message) > cls.MAX_MESSAGE_SIZE:
+            raise ValueError(f"Packet of {len(message)} bytes is too large to fragment.")
+        message_id : int = cls.next_message_id
+        cls.next_message_id = (cls.next_message_id + 1) & 0xFFFF
+        fragment_count : int = -(-len(message) // cls.DATA_SIZE)
+        data : bytearray = bytearray(fragment_count * (HEADER.size + cls.HEADER_SIZE) + len(message))
+        view : memoryview = memoryview(message)
+        offset : int = 0
+        for index in range(fragment_count):
+            chunk : memoryview = view[index * cls.DATA_SIZE:(index + 1) * cls.DATA_SIZE]
+            HEADER.pack_into(data, offset, guid, PacketType.Fragment.value, cls.HEADER_SIZE + len(chunk))
+            offset += HEADER.size
+            FRAGMENT.pack_into(data, offset, message_id, index, len(message))
+            offset += cls.HEADER_SIZE
+            data[offset:offset + len(chunk)] = chunk
+            offset += len(chunk)
         return data
 
-
-    def deserialize(self, data : bytes | bytearray) -> None:
-        if data is bytes:
-            data = bytearray(data)
-        self.max_players = ushort(int.from_bytes(data[0:self.SIZE], "little"))
+class FragmentAssembler:
+    # Fragments of a message arrive back to back, so one with a new message_id abandons whatever was being reassembled.
+    message_id : int = -1
+    message : bytearray
+    received : int = 0
+
+    def __init__(self):
+        self.message = bytearray()
+
+    def reset(self) -> None:
+        self.message_id = -1
+        self.received = 0
+
+    def add(self, fragment : FragmentPacket) -> bytearray | None:
+        """
+        Copies a fragment into the message it belongs to
+        :return: the complete packet once every fragment of it has arrived, otherwise None
+        """
+        offset : int = fragment.fragment_index * FragmentPacket.DATA_SIZE
+        if fragment.total_length < PacketHeader.SIZE or fragment.total_length > FragmentPacket.MAX_MESSAGE_SIZE \
+                or offset + len(fragment.data) > fragment.total_length:
+            return None
+        if fragment.message_id != self.message_id or len(self.message) != fragment.total_length:
+            self.message_id = fragment.message_id
+            self.message = bytearray(fragment.total_length)
+            self.received = 0
+        self.message[offset:offset + len(fragment.data)] = fragment.data
+        self.received += len(fragment.data)
+        if self.received < fragment.total_length:
+            return None
+        self.reset()
+        return self.message
 
 #endregion
 
 class PacketHeader:
     GUID_SIZE : int = 16
-    guid : bytearray
+    guid : bytes
     packet_type : PacketType
-    packet_size : short
-    SIZE : short = 16 + 4
+    packet_size : int
+    SIZE : short = HEADER.size
 
     def __init__(self, header_bytes : bytearray = None, guid : bytearray = None,  packet_type : PacketType = PacketType.Init):
         if header_bytes:
@@ -583,29 +569,17 @@ class PacketHeader:
             self.guid = guid
             self.packet_type = packet_type
 
+    def pack_into(self, buffer : bytearray, offset : int) -> None:
+        HEADER.pack_into(buffer, offset, bytes(self.guid), self.packet_type.value, self.packet_size)
+
     def serialize(self) -> bytearray:
-        data: bytearray = bytearray()
-        data += self.guid
-
-        while len(data) < self.GUID_SIZE:
-            data += b"\x00"
-        int_value: int = self.packet_type.value
-        data += int_value.to_bytes(2, "little")
-        int_value2 : int = self.packet_size
-        data += int_value2.to_bytes(2, "little")
-        if len(data) != self.SIZE:
-            raise f"PacketHeader failed to serialize. bytearray is incorrect size {self.SIZE}."
+        data : bytearray = bytearray(self.SIZE)
+        self.pack_into(data, 0)
         return data
 
-    def deserialize(self, data : bytes | bytearray) -> None:
-        if data is bytes:
-            data = bytearray(data)
-        offset = 0
-        self.guid = data[offset:self.GUID_SIZE]
-        offset += self.GUID_SIZE
-        self.packet_type = PacketType(int.from_bytes(data[offset:offset + 2], "little"))
-        offset += 2
-        self.packet_size = short(int.from_bytes(data[offset:offset + 2], "little"))
+    def deserialize(self, data : bytes | bytearray | memoryview) -> None:
+        self.guid, packet_type, self.packet_size = HEADER.unpack_from(data)
+        self.packet_type = PacketType(packet_type)
 
 class Packet:
     header : PacketHeader
@@ -645,29 +619,89 @@ class Packet:
                     self.packet = ShineReplace(info=packet_data[0])
                 case PacketType.ShineColor:
                     self.packet = ShineColor(info=packet_data[0])
+                case PacketType.Ping | PacketType.Pong:
+                    self.packet = PingPacket(timestamp=packet_data[0], sequence=packet_data[1])
+                case PacketType.SlotBundle | PacketType.ShineBitmap:
+                    self.packet = packet_data[0]
 
     def serialize(self) -> bytearray:
         self.header.packet_size = self.packet.SIZE
-        data : bytearray = bytearray()
-        data += self.header.serialize()
-        data += self.packet.serialize()
+        # Header and body are packed into one buffer sized for both
+        data : bytearray = bytearray(PacketHeader.SIZE + self.packet.SIZE)
+        self.header.pack_into(data, 0)
+        self.packet.pack_into(data, PacketHeader.SIZE)
+        # The game drops anything larger than one packet, so send it as fragments it stitches back together
+        if len(data) > FragmentPacket.MAX_PACKET_SIZE:
+            return FragmentPacket.split(self.header.guid, data)
         return data
 
-    def deserialize(self, data : bytes | bytearray) -> None:
+    def deserialize(self, data : bytes | bytearray | memoryview) -> None:
         match self.header.packet_type:
             case PacketType.Connect:
-                self.packet = ConnectPacket()
+                self.packet = ConnectPacket(packet_bytes=data)
             # case PacketType.Command:
             #     self.packet = CommandP()
             case PacketType.Check:
                 self.packet = CheckPacket(packet_bytes=data)
             case PacketType.ArchipelagoChat:
-                self.packet = ChatMessagePacket()
+                self.packet = ChatMessagePacket(packet_bytes=data)
             case PacketType.SlotData:
                 self.packet = SlotDataPacket(packet_bytes=data)
             case PacketType.DeathLink:
                 self.packet = DeathLinkPacket()
             case PacketType.ShineChecks:
                 self.packet = ShineChecksPacket(packet_bytes=data)
+            case PacketType.ShineBitmap:
+                self.packet = ShineBitmapPacket(packet_bytes=data)
             case PacketType.ChangeStage:
                 self.packet = ChangeStagePacket(packet_bytes=data)
+            case PacketType.Ping | PacketType.Pong:
+                self.packet = PingPacket(packet_bytes=data)
+            case PacketType.Fragment:
+                self.packet = FragmentPacket(packet_bytes=data)
+
+class PacketReader:
+    # Frames the byte stream from the game. Whatever has arrived is read into one buffer and every whole packet in it
+    # is parsed through a memoryview of that buffer, so a read that stops partway through a packet simply waits for
+    # the rest instead of desynchronizing the stream, and a burst of packets costs one read instead of two per packet.
+    READ_SIZE : int = 0x10000
+    reader : asyncio.StreamReader
+    buffer : bytearray
+
+    def __init__(self, reader : asyncio.StreamReader):
+        self.reader = reader
+        self.buffer = bytearray()
+
+    async def read_batch(self) -> list[Packet]:
+        """
+        Waits until at least one whole packet has arrived
+        :return: every whole packet received so far, in the order they were sent
+        """
+        while True:
+            packets : list[Packet] = self.parse()
+            if packets:
+                return packets
+            data : bytes = await self.reader.read(self.READ_SIZE)
+            if not data:
+                raise asyncio.IncompleteReadError(bytes(self.buffer), None)
+            self.buffer += data
+
+    def parse(self) -> list[Packet]:
+        packets : list[Packet] = []
+        offset : int = 0
+        # Bodies copy whatever they keep, so the view is released before the parsed bytes are dropped from the buffer
+        with memoryview(self.buffer) as view:
+            while len(view) - offset >= PacketHeader.SIZE:
+                # The guid comes from the header
+                packet : Packet = Packet(guid=None, header_bytes=view[offset:offset + PacketHeader.SIZE])
+                size : int = packet.header.packet_size
+                if size < 0 or size > FragmentPacket.MAX_MESSAGE_SIZE:
+                    raise ValueError(f"Packet of type {packet.header.packet_type} claims a size of {size}.")
+                end : int = offset + PacketHeader.SIZE + size
+                if end > len(view):
+                    break
+                packet.deserialize(view[offset + PacketHeader.SIZE:end])
+                packets.append(packet)
+                offset = end
+        del self.buffer[:offset]
+        return packets
@@ -0,0 +1,242 @@
+import typing
+import zlib
+
+from .Packets import FragmentPacket, PacketHeader, SlotBundlePacket, ShineBitmapPacket
+
+SLOT_BUNDLE_VERSION : int = 2
+# Name tables are capped by the arrays the game stores them in
+MAX_NAMES : int = 144
+MAX_NAME_LENGTH : int = 40
+
+# Table ids, matching SlotTable in the game's SlotBundle.h
+TABLE_OPTIONS : int = 0
+TABLE_SHINE_COLORS : int = 1
+TABLE_SHOP : int = 2
+TABLE_GAME_NAMES : int = 3
+TABLE_SLOT_NAMES : int = 4
+TABLE_ITEM_NAMES : int = 5
+TABLE_SHINE_TEXT : int = 6
+TABLE_COUNT : int = 7
+# Table id, hash and size in front of every table
+TABLE_HEADER_SIZE : int = 7
+
+# Index into the game's worldPayCounts for every kingdom with a moon requirement
+PAY_COUNT_WORLDS : dict[str, int] = {
+    "cascade": 1, "sand": 2, "wooded": 3, "lake": 4, "lost": 6, "metro": 7, "seaside": 8, "snow": 9,
+    "luncheon": 10, "ruined": 11, "bowser": 12, "dark": 15, "darker": 16,
+}
+WORLD_COUNT : int = 17
+SHINE_COUNT : int = 1168
+SHINE_TEXT_COUNT : int = 100
+EMPTY_SHOP_ITEM : list[int] = [254, 254, 254, 254]
+EMPTY_SHINE_TEXT : list[int] = [127, 255]
+
+
+def rle_encode(data : bytes | bytearray) -> bytes:
+    """
+    Run length encodes data the way the game's BundleReader expects it.
+    Every run starts with a control byte c: below 0x80, c + 1 literal bytes follow,
+    otherwise the next byte is repeated c - 0x7D times (3 to 130).
+    """
+    out : bytearray = bytearray()
+    literals : bytearray = bytearray()
+    i : int = 0
+
+    def flush_literals():
+        for start in range(0, len(literals), 128):
+            chunk = literals[start:start + 128]
+            out.append(len(chunk) - 1)
+            out.extend(chunk)
+        literals.clear()
+
+    while i < len(data):
+        run : int = 1
+        while i + run < len(data) and run < 130 and data[i + run] == data[i]:
+            run += 1
+        if run >= 3:
+            flush_literals()
+            out.append(run + 0x7D)
+            out.append(data[i])
+            i += run
+        else:
+            literals.append(data[i])
+            i += 1
+    flush_literals()
+    return bytes(out)
+
+
+def rle_decode(data : bytes | bytearray) -> bytes:
+    """
+    Reverses rle_encode, stopping at the last whole run if data is cut short.
+    """
+    out : bytearray = bytearray()
+    i : int = 0
+    while i < len(data):
+        control : int = data[i]
+        if control < 0x80:
+            out += data[i + 1:i + 2 + control]
+            i += control + 2
+        else:
+            if i + 1 >= len(data):
+                break
+            out += bytes([data[i + 1]]) * (control - 0x7D)
+            i += 2
+    return bytes(out)
+
+
+def table_hash(table : bytes | bytearray) -> int:
+    # 0 is what the game reports for tables it never got
+    return zlib.crc32(table) or 1
+
+
+def _shop_table(entries : dict, uids : list[int], pad : bool = True) -> list[list[int]]:
+    table : list[list[int]] = []
+    for uid in uids:
+        if str(uid) in entries:
+            table.append(entries[str(uid)])
+        elif pad:
+            table.append(EMPTY_SHOP_ITEM)
+    return table
+
+
+def _encode_name(name : str, utf16_limit : bool = True) -> bytes:
+    if utf16_limit:
+        encoded : bytes = name[:MAX_NAME_LENGTH].encode("utf-8")
+    else:
+        # Stored as UTF-8 by the game, so the limit is in bytes
+        encoded : bytes = name.encode("utf-8")[:MAX_NAME_LENGTH].decode("utf-8", "ignore").encode("utf-8")
+    return len(encoded).to_bytes(1, "little") + encoded
+
+
+def _name_table(names : list[str], utf16_limit : bool = True) -> bytes:
+    data : bytearray = bytearray()
+    names = names[:MAX_NAMES]
+    data += len(names).to_bytes(1, "little")
+    for name in names:
+        data += _encode_name(name, utf16_limit)
+    return bytes(data)
+
+
+def build_slot_tables(slot_data : dict) -> dict[int, bytes]:
+    """
+    Encodes every table the game needs on connect, the layouts are documented on Client::readSlotTable.
+    The kingdom specific shine text is left to build_shine_text_table.
+    """
+    tables : dict[int, bytes] = {}
+
+    data : bytearray = bytearray()
+    pay_counts : list[int] = [-1] * WORLD_COUNT
+    for name, world in PAY_COUNT_WORLDS.items():
+        pay_counts[world] = slot_data["counts"][name]
+    data += WORLD_COUNT.to_bytes(1, "little")
+    for count in pay_counts:
+        data += count.to_bytes(2, "little", signed=True)
+    data += (int(bool(slot_data["regionals"])) | int(bool(slot_data["capture_sanity"])) << 1).to_bytes(1, "little")
+    tables[TABLE_OPTIONS] = bytes(data)
+
+    colors : bytearray = bytearray(SHINE_COUNT)
+    for shine_uid, color in slot_data["shine_colors"].items():
+        if int(shine_uid) < SHINE_COUNT:
+            colors[int(shine_uid)] = color & 0xFF
+    tables[TABLE_SHINE_COLORS] = SHINE_COUNT.to_bytes(2, "little") + bytes(colors)
+
+    shop_data : dict = slot_data["shop_replace_data"]
+    shop_tables : list[list[list[int]]] = [
+        _shop_table(shop_data["caps"], list(range(2501, 2539)) + list(range(2577, 2582))),
+        _shop_table(shop_data["clothes"], list(range(2539, 2582))),
+        _shop_table(shop_data["stickers"], list(range(2582, 2599))),
+        _shop_table(shop_data["souvenirs"], list(range(2599, 2625))),
+        _shop_table(shop_data["moons"], list(range(0, 2499)), pad=False),
+    ]
+    data = bytearray()
+    data += len(shop_tables).to_bytes(1, "little")
+    for table in shop_tables:
+        data += len(table).to_bytes(1, "little")
+        for entry in table:
+            data += bytes(entry)
+    tables[TABLE_SHOP] = bytes(data)
+
+    tables[TABLE_GAME_NAMES] = _name_table(slot_data["shop_games"])
+    tables[TABLE_SLOT_NAMES] = _name_table(slot_data["shop_players"])
+    tables[TABLE_ITEM_NAMES] = _name_table(slot_data["shop_ap_items"])
+    return tables
+
+
+def build_shine_text_table(slot_data : dict, world_id : int) -> bytes:
+    """
+    Encodes the moon text replacements of one kingdom, replacing the ShineReplace packet and its ApInfo names.
+    """
+    replacements : dict = slot_data["shine_replace_data"][str(world_id)]
+    data : bytearray = bytearray()
+    data += world_id.to_bytes(1, "little")
+    data += SHINE_TEXT_COUNT.to_bytes(1, "little")
+    for i in range(SHINE_TEXT_COUNT):
+        item_type, name_index = replacements.get(str(i), EMPTY_SHINE_TEXT)
+        data += item_type.to_bytes(1, "little", signed=True)
+        data += name_index.to_bytes(1, "little")
+    data += _name_table(slot_data["shine_items"][str(world_id)], utf16_limit=False)
+    return bytes(data)
+
+
+def _encode_bundle(tables : dict[int, bytes]) -> SlotBundlePacket:
+    data : bytearray = bytearray()
+    data += len(tables).to_bytes(1, "little")
+    for table, body in tables.items():
+        data += table.to_bytes(1, "little")
+        data += table_hash(body).to_bytes(4, "little")
+        data += len(body).to_bytes(2, "little")
+        data += body
+
+    compressed : bytes = rle_encode(data)
+    if len(compressed) < len(data):
+        return SlotBundlePacket(version=SLOT_BUNDLE_VERSION, encoding=SlotBundlePacket.ENCODING_RLE,
+                                raw_size=len(data), data=compressed)
+    return SlotBundlePacket(version=SLOT_BUNDLE_VERSION, encoding=SlotBundlePacket.ENCODING_RAW,
+                            raw_size=len(data), data=bytes(data))
+
+
+def _fits_in_message(bundle : SlotBundlePacket) -> bool:
+    return PacketHeader.SIZE + bundle.SIZE <= FragmentPacket.MAX_MESSAGE_SIZE
+
+
+def build_slot_bundles(tables : dict[int, bytes]) -> list[SlotBundlePacket]:
+    """
+    Packs tables into as few bundles as fit in a single message each
+    """
+    bundles : list[SlotBundlePacket] = []
+    group : dict[int, bytes] = {}
+    for table, body in tables.items():
+        candidate : dict[int, bytes] = dict(group)
+        candidate[table] = body
+        if group and not _fits_in_message(_encode_bundle(candidate)):
+            bundles.append(_encode_bundle(group))
+            candidate = {table: body}
+        group = candidate
+    if group:
+        bundles.append(_encode_bundle(group))
+    return bundles
+
+
+def build_shine_bitmap(locations : typing.Iterable[int]) -> ShineBitmapPacket:
+    bits : int = 0
+    for location in locations:
+        if 0 <= location < SHINE_COUNT:
+            bits |= 1 << location
+    raw : bytes = bits.to_bytes(ShineBitmapPacket.RAW_SIZE, "little")
+    encoded : bytes = rle_encode(raw)
+    if len(encoded) < len(raw):
+        return ShineBitmapPacket(encoding=SlotBundlePacket.ENCODING_RLE, data=encoded)
+    return ShineBitmapPacket(encoding=SlotBundlePacket.ENCODING_RAW, data=raw)
+
+
+def read_shine_bitmap(packet : ShineBitmapPacket) -> set[int]:
+    raw : bytes = packet.data
+    if packet.encoding == SlotBundlePacket.ENCODING_RLE:
+        raw = rle_decode(raw)
+    bits : int = int.from_bytes(raw[:packet.word_count * 4], "little")
+    locations : set[int] = set()
+    while bits:
+        low_bit : int = bits & -bits
+        locations.add(low_bit.bit_length() - 1)
+        bits ^= low_bit
+    return locations
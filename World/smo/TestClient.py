@@ -14,7 +14,7 @@ async def run_client():
         while True:
             data: bytearray = bytearray(await reader.read(PacketHeader.SIZE))
             packet = Packet(header_bytes=data)
-            packet_size: int = packet.header.packet_size.value
+            packet_size: int = packet.header.packet_size
             data = bytearray(await reader.read(packet_size))
             packet.deserialize(data)
             match packet.header.packet_type: